@@ -0,0 +1,100 @@
+#include "TraceSensor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+const char *COLUMN_NAMES[QUANTITY_COUNT] = {"temperature", "humidity", "pressure", "illuminance"};
+} // namespace
+
+bool SensorTrace::load(const char *path)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    std::vector<int> columns; // 每列对应的物理量，-1 为未知列
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::vector<std::string> cells;
+        std::stringstream stream(line);
+        std::string cell;
+        while (std::getline(stream, cell, ','))
+            cells.push_back(cell);
+        if (line.back() == ',')
+            cells.push_back("");
+
+        if (columns.empty())
+        {
+            // 表头
+            for (size_t i = 1; i < cells.size(); i++)
+            {
+                auto it = std::find_if(std::begin(COLUMN_NAMES), std::end(COLUMN_NAMES),
+                                       [&](const char *name) { return cells[i] == name; });
+                const int quantity = it == std::end(COLUMN_NAMES) ? -1 : static_cast<int>(it - std::begin(COLUMN_NAMES));
+                columns.push_back(quantity);
+                if (quantity >= 0)
+                    _hasColumn[quantity] = true;
+            }
+            continue;
+        }
+
+        _times.push_back(static_cast<uint32_t>(std::stoul(cells[0])));
+        for (uint8_t q = 0; q < QUANTITY_COUNT; q++)
+            _values[q].push_back(NAN);
+        for (size_t i = 1; i < cells.size() && i - 1 < columns.size(); i++)
+        {
+            if (columns[i - 1] >= 0 && !cells[i].empty())
+                _values[columns[i - 1]].back() = std::stof(cells[i]);
+        }
+    }
+    return !_times.empty();
+}
+
+bool SensorTrace::value(Quantity quantity, uint32_t timeMs, float &value) const
+{
+    const uint8_t q = static_cast<uint8_t>(quantity);
+    if (_times.empty() || !_hasColumn[q] || timeMs < _times.front())
+        return false;
+    const size_t row = std::upper_bound(_times.begin(), _times.end(), timeMs) - _times.begin() - 1;
+    value = _values[q][row];
+    return !std::isnan(value);
+}
+
+TraceSensor::TraceSensor(const char *name, const SensorTrace &trace, std::initializer_list<Quantity> quantities,
+                         uint32_t intervalMs)
+    : _name(name), _trace(trace), _intervalMs(intervalMs)
+{
+    for (Quantity quantity : quantities)
+    {
+        if (_quantityCount < MAX_READINGS)
+            _quantities[_quantityCount++] = quantity;
+    }
+}
+
+bool TraceSensor::begin()
+{
+    _startMs = millis();
+    return _trace.rows() > 0;
+}
+
+uint8_t TraceSensor::read(SensorReading (&out)[MAX_READINGS])
+{
+    // 任何一个量缺失都按整次读取失败处理，与真实器件一次事务读出全部结果一致
+    const uint32_t now = millis() - _startMs;
+    for (uint8_t i = 0; i < _quantityCount; i++)
+    {
+        out[i].quantity = _quantities[i];
+        if (!_trace.value(_quantities[i], now, out[i].value))
+            return 0;
+    }
+    return _quantityCount;
+}
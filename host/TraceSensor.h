@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <initializer_list>
+#include <vector>
+
+#include "sensors/SensorDriver.h"
+
+// 传感器轨迹：CSV 文件，首列为毫秒时刻，其余列按表头名对应物理量（temperature/humidity/pressure/illuminance），
+// # 开头的行为注释；空单元格表示该时刻读取失败
+class SensorTrace
+{
+public:
+    bool load(const char *path);
+
+    size_t rows() const { return _times.size(); }
+    uint32_t durationMs() const { return _times.empty() ? 0 : _times.back(); }
+    // 取不晚于 timeMs 的最后一行（轨迹之后保持末行）；该列为空时返回 false
+    bool value(Quantity quantity, uint32_t timeMs, float &value) const;
+
+private:
+    std::vector<uint32_t> _times;
+    std::vector<float> _values[QUANTITY_COUNT]; // 读取失败记为 NaN
+    bool _hasColumn[QUANTITY_COUNT] = {};
+};
+
+// 回放轨迹的模拟传感器：以 begin() 时刻为轨迹起点，按 millis() 读取对应时刻的值；主机端 delay() 推进虚拟时间，
+// 整条采集流水线按轨迹时间运行，与真实耗时无关
+class TraceSensor : public SensorDriver
+{
+public:
+    TraceSensor(const char *name, const SensorTrace &trace, std::initializer_list<Quantity> quantities, uint32_t intervalMs);
+
+    const char *name() const override { return _name; }
+    bool begin() override;
+    uint32_t intervalMs() const override { return _intervalMs; }
+    uint8_t read(SensorReading (&out)[MAX_READINGS]) override;
+
+private:
+    const char *_name;
+    const SensorTrace &_trace;
+    Quantity _quantities[MAX_READINGS];
+    uint8_t _quantityCount = 0;
+    uint32_t _intervalMs;
+    uint32_t _startMs = 0;
+};
@@ -0,0 +1,156 @@
+#include "VirtualPanel.h"
+
+VirtualPanel::VirtualPanel(uint8_t csPin, uint8_t dcPin, int16_t width, int16_t height)
+    : _cs(csPin), _dc(dcPin), _width(width), _height(height), _image(static_cast<size_t>(width) * height, 0)
+{
+}
+
+VirtualPanel::~VirtualPanel()
+{
+    detach();
+}
+
+void VirtualPanel::attach()
+{
+    hostSetGpioListener(this);
+    hostSetSpiListener(this);
+}
+
+void VirtualPanel::detach()
+{
+    hostSetGpioListener(nullptr);
+    hostSetSpiListener(nullptr);
+}
+
+void VirtualPanel::onPinWrite(uint8_t pin, uint8_t level)
+{
+    if (pin == _cs)
+    {
+        bool selected = (level == LOW);
+        if (selected && !_selected)
+            _stats.transactions++;
+        _selected = selected;
+    }
+    else if (pin == _dc)
+    {
+        _dataMode = (level == HIGH);
+    }
+}
+
+void VirtualPanel::onSpiBytes(const uint8_t *data, size_t length)
+{
+    if (!_selected)
+        return;
+
+    _stats.bytes += length;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (_dataMode)
+            onData(data[i]);
+        else
+            onCommand(data[i]);
+    }
+}
+
+void VirtualPanel::onCommand(uint8_t cmd)
+{
+    _stats.commands++;
+    _command = cmd;
+    _paramCount = 0;
+    if (cmd == 0x2C)
+    {
+        _cursorX = _colStart;
+        _cursorY = _rowStart;
+        _pixelHighByte = true;
+    }
+}
+
+void VirtualPanel::onData(uint8_t value)
+{
+    switch (_command)
+    {
+    case 0x2A:
+    case 0x2B:
+        if (_paramCount < 4)
+            _params[_paramCount++] = value;
+        if (_paramCount == 4)
+        {
+            uint16_t start = (_params[0] << 8) | _params[1];
+            uint16_t end = (_params[2] << 8) | _params[3];
+            if (_command == 0x2A)
+            {
+                _colStart = start;
+                _colEnd = end;
+            }
+            else
+            {
+                _rowStart = start;
+                _rowEnd = end;
+            }
+        }
+        break;
+    case 0x2C:
+        if (_pixelHighByte)
+        {
+            _pixelHigh = value;
+        }
+        else
+        {
+            writePixel((_pixelHigh << 8) | value);
+        }
+        _pixelHighByte = !_pixelHighByte;
+        break;
+    default:
+        break;
+    }
+}
+
+void VirtualPanel::writePixel(uint16_t color)
+{
+    _stats.pixels++;
+    if (_cursorX < _width && _cursorY < _height)
+        _image[static_cast<size_t>(_cursorY) * _width + _cursorX] = color;
+
+    if (_cursorX >= _colEnd)
+    {
+        _cursorX = _colStart;
+        _cursorY = (_cursorY >= _rowEnd) ? _rowStart : _cursorY + 1;
+    }
+    else
+    {
+        _cursorX++;
+    }
+}
+
+uint32_t VirtualPanel::checksum() const
+{
+    uint32_t hash = 2166136261u;
+    for (uint16_t color : _image)
+    {
+        hash = (hash ^ (color & 0xFF)) * 16777619u;
+        hash = (hash ^ (color >> 8)) * 16777619u;
+    }
+    return hash;
+}
+
+bool VirtualPanel::writePpm(const char *path) const
+{
+    FILE *fp = fopen(path, "wb");
+    if (!fp)
+        return false;
+
+    fprintf(fp, "P6\n%d %d\n255\n", _width, _height);
+    for (uint16_t color : _image)
+    {
+        uint8_t r5 = (color >> 11) & 0x1F;
+        uint8_t g6 = (color >> 5) & 0x3F;
+        uint8_t b5 = color & 0x1F;
+        const uint8_t rgb[3] = {
+            static_cast<uint8_t>((r5 << 3) | (r5 >> 2)),
+            static_cast<uint8_t>((g6 << 2) | (g6 >> 4)),
+            static_cast<uint8_t>((b5 << 3) | (b5 >> 2))};
+        fwrite(rgb, 1, sizeof(rgb), fp);
+    }
+    fclose(fp);
+    return true;
+}
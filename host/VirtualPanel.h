@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#include <vector>
+
+// 虚拟 SPI 屏：监听 CS/DC 引脚与 SPI 字节流，按 0x2A/0x2B/0x2C 命令把像素解码到内存图像，
+// 同时统计字节数、事务数（CS 拉低次数）和命令数，供主机端基准与回归比对使用。
+class VirtualPanel : public HostGpioListener, public HostSpiListener
+{
+public:
+    struct Stats
+    {
+        uint64_t bytes = 0;
+        uint32_t transactions = 0;
+        uint32_t commands = 0;
+        uint64_t pixels = 0;
+    };
+
+    VirtualPanel(uint8_t csPin, uint8_t dcPin, int16_t width, int16_t height);
+    ~VirtualPanel() override;
+
+    void attach();
+    void detach();
+
+    void onPinWrite(uint8_t pin, uint8_t level) override;
+    void onSpiBytes(const uint8_t *data, size_t length) override;
+
+    const Stats &stats() const { return _stats; }
+    void resetStats() { _stats = Stats(); }
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    uint16_t pixel(int16_t x, int16_t y) const { return _image[static_cast<size_t>(y) * _width + x]; }
+    const std::vector<uint16_t> &image() const { return _image; }
+
+    // 图像内容的 FNV-1a 哈希，作为黄金图比对的指纹
+    uint32_t checksum() const;
+    bool writePpm(const char *path) const;
+
+private:
+    uint8_t _cs;
+    uint8_t _dc;
+    int16_t _width;
+    int16_t _height;
+    std::vector<uint16_t> _image;
+    Stats _stats;
+
+    bool _selected = false;
+    bool _dataMode = true;
+    uint8_t _command = 0;
+    uint8_t _params[4] = {};
+    uint8_t _paramCount = 0;
+
+    uint16_t _colStart = 0;
+    uint16_t _colEnd = 0;
+    uint16_t _rowStart = 0;
+    uint16_t _rowEnd = 0;
+    uint16_t _cursorX = 0;
+    uint16_t _cursorY = 0;
+    bool _pixelHighByte = true;
+    uint8_t _pixelHigh = 0;
+
+    void onCommand(uint8_t cmd);
+    void onData(uint8_t value);
+    void writePixel(uint16_t color);
+};
@@ -0,0 +1,34 @@
+// 主机端的分配计数钩子：可执行文件里定义的 malloc 会取代 glibc 的实现（含 libstdc++ 的 operator new），
+// 计数后转交 glibc 内部的 __libc_* 分配器，free 仍由 glibc 处理。对应设备端 AllocCounter.cpp 中的 --wrap 钩子。
+#ifdef COUNT_ALLOCATIONS
+
+#include <stddef.h>
+
+#include "core/AllocCounter.h"
+
+extern "C"
+{
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size)
+{
+    AllocCounter::note();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    AllocCounter::note();
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    AllocCounter::note();
+    return __libc_realloc(ptr, size);
+}
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include "Arduino.h"
+#include "esp_timer.h"
+
+#include <atomic>
+#include <chrono>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point g_start = Clock::now();
+// delay() 不真正休眠，只推进虚拟时间，避免 tftInit 等长延时拖慢主机端运行；渲染任务线程会并发读取
+std::atomic<uint64_t> g_delayOffsetUs{0};
+
+HostGpioListener *g_gpioListener = nullptr;
+int g_pinInput[64] = {};
+bool g_pinInputSet[64] = {};
+} // namespace
+
+int64_t esp_timer_get_time()
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - g_start).count();
+    return static_cast<int64_t>(elapsed + g_delayOffsetUs);
+}
+
+unsigned long micros()
+{
+    return static_cast<unsigned long>(esp_timer_get_time());
+}
+
+unsigned long millis()
+{
+    return micros() / 1000;
+}
+
+void delay(uint32_t ms)
+{
+    g_delayOffsetUs += static_cast<uint64_t>(ms) * 1000;
+}
+
+void yield()
+{
+}
+
+void pinMode(uint8_t, uint8_t)
+{
+}
+
+void digitalWrite(uint8_t pin, uint8_t level)
+{
+    if (g_gpioListener)
+        g_gpioListener->onPinWrite(pin, level);
+}
+
+int digitalRead(uint8_t pin)
+{
+    if (pin < 64 && g_pinInputSet[pin])
+        return g_pinInput[pin];
+    return HIGH;
+}
+
+void hostSetGpioListener(HostGpioListener *listener)
+{
+    g_gpioListener = listener;
+}
+
+void hostSetPinInput(uint8_t pin, int level)
+{
+    if (pin >= 64)
+        return;
+    g_pinInput[pin] = level;
+    g_pinInputSet[pin] = true;
+}
+
+bool psramFound()
+{
+    return true;
+}
+
+void *ps_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    // 与设备端 Arduino 核心一致：栈上只有 64 字节，更长的输出临时 malloc（分配计数因此与设备相符）
+    char small[64];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (len < 0)
+        return 0;
+    if (static_cast<size_t>(len) < sizeof(small))
+        return write(reinterpret_cast<const uint8_t *>(small), len);
+
+    char *large = static_cast<char *>(malloc(len + 1));
+    if (!large)
+        return 0;
+    va_start(args, format);
+    vsnprintf(large, len + 1, format, args);
+    va_end(args);
+    const size_t written = write(reinterpret_cast<const uint8_t *>(large), len);
+    free(large);
+    return written;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    if (!_muted)
+        fwrite(buffer, 1, size, stdout);
+    return size;
+}
+
+int HardwareSerial::available()
+{
+    return static_cast<int>(_input.size());
+}
+
+int HardwareSerial::read()
+{
+    if (_input.empty())
+        return -1;
+    int c = static_cast<uint8_t>(_input[0]);
+    _input.erase(0, 1);
+    return c;
+}
+
+int HardwareSerial::peek()
+{
+    return _input.empty() ? -1 : static_cast<uint8_t>(_input[0]);
+}
+
+void HardwareSerial::hostFeed(const char *input)
+{
+    _input += input;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    return 320 * 1024;
+}
+
+uint32_t EspClass::getMinFreeHeap()
+{
+    return 300 * 1024;
+}
+
+uint32_t EspClass::getFreePsram()
+{
+    return 8 * 1024 * 1024;
+}
+
+uint32_t EspClass::getMinFreePsram()
+{
+    return 7 * 1024 * 1024;
+}
+
+uint32_t EspClass::getCycleCount()
+{
+    // 按 240 MHz 折算，便于与板上的周期计数对比；用纳秒时钟保证短区段也有分辨率
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - g_start).count();
+    return static_cast<uint32_t>((elapsed + static_cast<int64_t>(g_delayOffsetUs) * 1000) * 240 / 1000);
+}
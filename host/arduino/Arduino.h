@@ -0,0 +1,239 @@
+#pragma once
+
+// 主机端（PlatformIO native 环境）的 Arduino 最小兼容层，只覆盖渲染栈用到的接口。
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using std::max;
+using std::min;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline uint8_t pgm_read_byte(const void *addr) { return *static_cast<const uint8_t *>(addr); }
+inline bool isDigit(int c) { return c >= '0' && c <= '9'; }
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int digitalRead(uint8_t pin);
+
+bool psramFound();
+void *ps_malloc(size_t size);
+
+class String
+{
+public:
+    String() = default;
+    String(const char *str) : _s(str ? str : "") {}
+    String(const char *str, unsigned int length) : _s(str, length) {}
+    String(const std::string &str) : _s(str) {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(unsigned char value) : _s(std::to_string(value)) {}
+    explicit String(int value) : _s(std::to_string(value)) {}
+    explicit String(unsigned int value) : _s(std::to_string(value)) {}
+    explicit String(long value) : _s(std::to_string(value)) {}
+    explicit String(unsigned long value) : _s(std::to_string(value)) {}
+
+    unsigned int length() const { return static_cast<unsigned int>(_s.size()); }
+    bool isEmpty() const { return _s.empty(); }
+    const char *c_str() const { return _s.c_str(); }
+    char operator[](unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+    char &operator[](unsigned int i) { return _s[i]; }
+    char charAt(unsigned int i) const { return (*this)[i]; }
+
+    bool reserve(unsigned int size)
+    {
+        _s.reserve(size);
+        return true;
+    }
+    bool concat(const char *str)
+    {
+        _s += str ? str : "";
+        return true;
+    }
+    bool concat(const char *str, unsigned int length)
+    {
+        _s.append(str, length);
+        return true;
+    }
+    bool concat(char c)
+    {
+        _s += c;
+        return true;
+    }
+    bool concat(const String &str)
+    {
+        _s += str._s;
+        return true;
+    }
+    String &operator+=(const String &str)
+    {
+        _s += str._s;
+        return *this;
+    }
+    String &operator+=(const char *str)
+    {
+        concat(str);
+        return *this;
+    }
+    String &operator+=(char c)
+    {
+        _s += c;
+        return *this;
+    }
+
+    int indexOf(char c, unsigned int from = 0) const { return toIndex(_s.find(c, from)); }
+    int indexOf(const String &str, unsigned int from = 0) const { return toIndex(_s.find(str._s, from)); }
+    int lastIndexOf(char c) const { return toIndex(_s.rfind(c)); }
+    String substring(unsigned int from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const
+    {
+        if (from > to)
+            std::swap(from, to);
+        return from < _s.size() ? String(_s.substr(from, to - from)) : String();
+    }
+    bool startsWith(const String &prefix) const { return _s.compare(0, prefix._s.size(), prefix._s) == 0; }
+    bool endsWith(const String &suffix) const
+    {
+        return _s.size() >= suffix._s.size() && _s.compare(_s.size() - suffix._s.size(), suffix._s.size(), suffix._s) == 0;
+    }
+    long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+    void toLowerCase()
+    {
+        for (char &c : _s)
+            c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+
+    bool operator==(const String &other) const { return _s == other._s; }
+    bool operator==(const char *other) const { return _s == (other ? other : ""); }
+    bool operator!=(const String &other) const { return _s != other._s; }
+    bool operator!=(const char *other) const { return !(*this == other); }
+    bool operator<(const String &other) const { return _s < other._s; }
+
+    friend String operator+(const String &a, const String &b) { return String(a._s + b._s); }
+    friend String operator+(const String &a, const char *b) { return String(a._s + (b ? b : "")); }
+
+private:
+    std::string _s;
+
+    static int toIndex(size_t pos) { return pos == std::string::npos ? -1 : static_cast<int>(pos); }
+};
+
+class Print
+{
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t n = 0;
+        while (size--)
+            n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char *str) { return write(reinterpret_cast<const uint8_t *>(str), strlen(str)); }
+
+    size_t print(const char *str) { return write(str); }
+    size_t print(const String &str) { return write(str.c_str()); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(int value) { return printf("%d", value); }
+    size_t print(unsigned int value) { return printf("%u", value); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(double value, int digits = 2) { return printf("%.*f", digits, value); }
+    size_t println() { return write("\n"); }
+    template <typename T>
+    size_t println(const T &value)
+    {
+        size_t n = print(value);
+        return n + println();
+    }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual size_t readBytes(char *buffer, size_t length)
+    {
+        size_t n = 0;
+        while (n < length)
+        {
+            int c = read();
+            if (c < 0)
+                break;
+            buffer[n++] = static_cast<char>(c);
+        }
+        return n;
+    }
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes(reinterpret_cast<char *>(buffer), length); }
+    void setTimeout(unsigned long) {}
+};
+
+// 串口：输出写到 stdout，输入来自 hostFeed() 注入的字符（测试/基准脚本模拟串口命令）
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+
+    void hostFeed(const char *input);
+    void hostSetMuted(bool muted) { _muted = muted; }
+
+private:
+    std::string _input;
+    bool _muted = false;
+};
+
+extern HardwareSerial Serial;
+
+class EspClass
+{
+public:
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getFreePsram();
+    uint32_t getMinFreePsram();
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getCycleCount();
+};
+
+extern EspClass ESP;
+
+// 主机端 GPIO 监听器：虚拟外设（如 VirtualPanel）通过它观察 CS/DC 等引脚的电平变化
+class HostGpioListener
+{
+public:
+    virtual ~HostGpioListener() = default;
+    virtual void onPinWrite(uint8_t pin, uint8_t level) = 0;
+};
+
+void hostSetGpioListener(HostGpioListener *listener);
+void hostSetPinInput(uint8_t pin, int level);
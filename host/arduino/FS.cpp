@@ -0,0 +1,227 @@
+#include "FS.h"
+#include "SPIFFS.h"
+
+#include <dirent.h>
+#include <set>
+#include <sys/stat.h>
+
+fs::SPIFFSFS SPIFFS;
+
+namespace fs
+{
+File::File(FS *owner, const std::string &path, std::shared_ptr<HostFileData> data, bool writable)
+    : _owner(owner), _path(path), _data(std::move(data)), _writable(writable)
+{
+}
+
+size_t File::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buffer, size_t size)
+{
+    if (!_data || !_writable)
+        return 0;
+    _data->bytes.insert(_data->bytes.end(), buffer, buffer + size);
+    _pos = _data->bytes.size();
+    return size;
+}
+
+int File::available()
+{
+    return _data ? static_cast<int>(_data->bytes.size() - _pos) : 0;
+}
+
+int File::read()
+{
+    uint8_t c;
+    return readBytes(reinterpret_cast<char *>(&c), 1) == 1 ? c : -1;
+}
+
+int File::peek()
+{
+    if (!_data || _pos >= _data->bytes.size())
+        return -1;
+    return _data->bytes[_pos];
+}
+
+size_t File::readBytes(char *buffer, size_t length)
+{
+    if (!_data || _pos >= _data->bytes.size())
+        return 0;
+    size_t n = min(length, _data->bytes.size() - _pos);
+    memcpy(buffer, _data->bytes.data() + _pos, n);
+    _pos += n;
+    if (_owner)
+        _owner->hostCountRead(n);
+    return n;
+}
+
+bool File::seek(uint32_t pos)
+{
+    if (!_data || pos > _data->bytes.size())
+        return false;
+    _pos = pos;
+    return true;
+}
+
+void File::close()
+{
+    if (_data && _writable && _owner)
+        _owner->hostTouch(*_data);
+    _data.reset();
+    _directory = false;
+    _entries.clear();
+}
+
+File File::openNextFile()
+{
+    if (!_directory || !_owner || _nextEntry >= _entries.size())
+        return File();
+    return _owner->open(_entries[_nextEntry++].c_str());
+}
+
+const char *File::name() const
+{
+    size_t slash = _path.rfind('/');
+    return _path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+bool FS::begin(bool, const char *, uint8_t, const char *)
+{
+    struct stat st;
+    return stat(_root.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+void FS::hostTouch(HostFileData &data)
+{
+    // 保证每次写入的 mtime 严格递增，便于按 mtime 判断文件变化
+    time_t now = time(nullptr);
+    _lastMtime = max(now, _lastMtime + 1);
+    data.mtime = _lastMtime;
+}
+
+std::shared_ptr<HostFileData> FS::loadFromDisk(const std::string &path)
+{
+    std::string full = _root + path;
+    FILE *fp = fopen(full.c_str(), "rb");
+    if (!fp)
+        return nullptr;
+
+    auto data = std::make_shared<HostFileData>();
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+        data->bytes.insert(data->bytes.end(), chunk, chunk + n);
+    fclose(fp);
+
+    struct stat st;
+    if (stat(full.c_str(), &st) == 0)
+        data->mtime = st.st_mtime;
+    return data;
+}
+
+File FS::open(const char *path, const char *mode, bool)
+{
+    std::string key = path ? path : "";
+    _openCount++;
+
+    if (mode[0] == 'w' || mode[0] == 'a')
+    {
+        _writeOpenCount++;
+        auto data = std::make_shared<HostFileData>();
+        if (mode[0] == 'a')
+        {
+            File existing = open(path, FILE_READ);
+            if (existing)
+                data->bytes = std::vector<uint8_t>(existing.size());
+            existing.readBytes(reinterpret_cast<char *>(data->bytes.data()), data->bytes.size());
+        }
+        hostTouch(*data);
+        _overlay[key] = data;
+        _removed.erase(key);
+        File file(this, key, data, true);
+        file.seek(data->bytes.size());
+        return file;
+    }
+
+    auto it = _overlay.find(key);
+    if (it != _overlay.end())
+        return File(this, key, std::make_shared<HostFileData>(*it->second), false);
+    if (_removed.count(key))
+        return File();
+    struct stat st;
+    if (stat((_root + key).c_str(), &st) == 0 && S_ISDIR(st.st_mode))
+        return openDirectory(key);
+
+    auto data = loadFromDisk(key);
+    if (!data)
+        return File();
+    return File(this, key, data, false);
+}
+
+File FS::openDirectory(const std::string &path)
+{
+    const std::string prefix = path.empty() || path.back() != '/' ? path + "/" : path;
+    std::set<std::string> entries;
+    std::vector<std::string> pending(1, prefix);
+    while (!pending.empty())
+    {
+        const std::string dir = pending.back();
+        pending.pop_back();
+        DIR *handle = opendir((_root + dir).c_str());
+        if (!handle)
+            continue;
+        while (dirent *entry = readdir(handle))
+        {
+            const std::string name = entry->d_name;
+            if (name == "." || name == "..")
+                continue;
+            struct stat st;
+            if (stat((_root + dir + name).c_str(), &st) != 0)
+                continue;
+            if (S_ISDIR(st.st_mode))
+                pending.push_back(dir + name + "/");
+            else
+                entries.insert(dir + name);
+        }
+        closedir(handle);
+    }
+    for (const auto &item : _overlay)
+    {
+        if (item.first.compare(0, prefix.size(), prefix) == 0)
+            entries.insert(item.first);
+    }
+    for (const auto &item : _removed)
+    {
+        if (!_overlay.count(item.first))
+            entries.erase(item.first);
+    }
+
+    File file(this, path, nullptr, false);
+    file._directory = true;
+    file._entries.assign(entries.begin(), entries.end());
+    return file;
+}
+
+bool FS::exists(const char *path)
+{
+    std::string key = path ? path : "";
+    if (_overlay.count(key))
+        return true;
+    if (_removed.count(key))
+        return false;
+    struct stat st;
+    return stat((_root + key).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char *path)
+{
+    std::string key = path ? path : "";
+    bool existed = exists(path);
+    _overlay.erase(key);
+    _removed[key] = true;
+    return existed;
+}
+} // namespace fs
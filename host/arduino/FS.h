@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Arduino.h"
+
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs
+{
+struct HostFileData
+{
+    std::vector<uint8_t> bytes;
+    time_t mtime = 0;
+};
+
+class FS;
+
+class File : public Stream
+{
+public:
+    File() = default;
+    File(FS *owner, const std::string &path, std::shared_ptr<HostFileData> data, bool writable);
+
+    explicit operator bool() const { return _data || _directory; }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char *buffer, size_t length) override;
+    using Stream::readBytes;
+
+    size_t read(uint8_t *buffer, size_t size) { return readBytes(reinterpret_cast<char *>(buffer), size); }
+    bool seek(uint32_t pos);
+    size_t position() const { return _pos; }
+    size_t size() const { return _data ? _data->bytes.size() : 0; }
+    void flush() {}
+    void close();
+    time_t getLastWrite() const { return _data ? _data->mtime : 0; }
+    const char *path() const { return _path.c_str(); }
+    const char *name() const;
+    bool isDirectory() const { return _directory; }
+    // 目录句柄：按路径顺序逐个打开其下（含子目录）的文件，与 SPIFFS 的扁平目录一致
+    File openNextFile();
+
+private:
+    friend class FS;
+
+    FS *_owner = nullptr;
+    std::string _path;
+    std::shared_ptr<HostFileData> _data;
+    size_t _pos = 0;
+    bool _writable = false;
+    bool _directory = false;
+    std::vector<std::string> _entries;
+    size_t _nextEntry = 0;
+};
+
+// 主机端文件系统：从磁盘目录（默认 data/）只读加载，写入保存在内存覆盖层中，不会改动仓库文件
+class FS
+{
+public:
+    bool begin(bool formatOnFail = false, const char *basePath = "/spiffs", uint8_t maxOpenFiles = 10, const char *partitionLabel = nullptr);
+    void end() {}
+
+    File open(const char *path, const char *mode = FILE_READ, bool create = false);
+    File open(const String &path, const char *mode = FILE_READ, bool create = false) { return open(path.c_str(), mode, create); }
+    bool exists(const char *path);
+    bool exists(const String &path) { return exists(path.c_str()); }
+    bool remove(const char *path);
+    bool remove(const String &path) { return remove(path.c_str()); }
+
+    void hostSetRoot(const std::string &root) { _root = root; }
+    const std::string &hostRoot() const { return _root; }
+    uint32_t hostOpenCount() const { return _openCount; }
+    uint64_t hostBytesRead() const { return _bytesRead; }
+    uint32_t hostWriteOpenCount() const { return _writeOpenCount; }
+    void hostCountRead(size_t bytes) { _bytesRead += bytes; }
+    void hostTouch(HostFileData &data);
+
+private:
+    std::string _root = "data";
+    std::map<std::string, std::shared_ptr<HostFileData>> _overlay;
+    std::map<std::string, bool> _removed;
+    uint32_t _openCount = 0;
+    uint32_t _writeOpenCount = 0;
+    uint64_t _bytesRead = 0;
+    time_t _lastMtime = 0;
+
+    std::shared_ptr<HostFileData> loadFromDisk(const std::string &path);
+    File openDirectory(const std::string &path);
+};
+} // namespace fs
+
+using fs::File;
+using fs::FS;
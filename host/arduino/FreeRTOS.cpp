@@ -0,0 +1,103 @@
+#include "freertos/task.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct HostTask
+{
+    std::string name;
+    BaseType_t core = 1;
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t notifications = 0;
+};
+
+namespace
+{
+HostTask g_loopTask;
+thread_local HostTask *t_current = nullptr;
+
+HostTask *current()
+{
+    return t_current ? t_current : &g_loopTask;
+}
+} // namespace
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stackDepth, void *arg, UBaseType_t priority,
+                                   TaskHandle_t *created, BaseType_t coreId)
+{
+    // 任务句柄在进程内一直有效（FreeRTOS 删除任务后句柄同样不能再用，这里不回收）
+    HostTask *task = new HostTask();
+    task->name = name ? name : "";
+    task->core = coreId == tskNO_AFFINITY ? 0 : coreId;
+    if (created)
+        *created = task;
+
+    std::thread([fn, arg, task]() {
+        t_current = task;
+        fn(arg);
+    }).detach();
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    return current();
+}
+
+TickType_t xTaskGetTickCount()
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return static_cast<TickType_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() / portTICK_PERIOD_MS);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notifications++;
+    }
+    task->cv.notify_one();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higherPriorityTaskWoken)
+{
+    xTaskNotifyGive(task);
+    if (higherPriorityTaskWoken)
+        *higherPriorityTaskWoken = pdFALSE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+    HostTask *task = current();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    auto ready = [task]() { return task->notifications > 0; };
+    if (ticksToWait == portMAX_DELAY)
+        task->cv.wait(lock, ready);
+    else
+        task->cv.wait_for(lock, std::chrono::milliseconds(ticksToWait * portTICK_PERIOD_MS), ready);
+
+    const uint32_t value = task->notifications;
+    if (value > 0)
+        task->notifications = clearCountOnExit ? 0 : value - 1;
+    return value;
+}
+
+BaseType_t xPortGetCoreID()
+{
+    return current()->core;
+}
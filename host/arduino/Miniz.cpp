@@ -0,0 +1,28 @@
+#include "rom/miniz.h"
+
+#include <zlib.h>
+
+tinfl_status tinfl_decompress(tinfl_decompressor *r, const mz_uint8 *pIn_buf_next, size_t *pIn_buf_size, mz_uint8 *pOut_buf_start,
+                              mz_uint8 *pOut_buf_next, size_t *pOut_buf_size, const mz_uint32 decomp_flags)
+{
+    if (!r || r->m_state != 0 || pOut_buf_next != pOut_buf_start || !(decomp_flags & TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF) ||
+        (decomp_flags & TINFL_FLAG_HAS_MORE_INPUT))
+        return TINFL_STATUS_BAD_PARAM;
+
+    z_stream stream = {};
+    if (inflateInit2(&stream, (decomp_flags & TINFL_FLAG_PARSE_ZLIB_HEADER) ? MAX_WBITS : -MAX_WBITS) != Z_OK)
+        return TINFL_STATUS_FAILED;
+
+    stream.next_in = const_cast<Bytef *>(pIn_buf_next);
+    stream.avail_in = static_cast<uInt>(*pIn_buf_size);
+    stream.next_out = pOut_buf_next;
+    stream.avail_out = static_cast<uInt>(*pOut_buf_size);
+    const int result = inflate(&stream, Z_FINISH);
+    *pIn_buf_size -= stream.avail_in;
+    *pOut_buf_size -= stream.avail_out;
+    inflateEnd(&stream);
+    r->m_state = 1;
+    if (result == Z_STREAM_END)
+        return TINFL_STATUS_DONE;
+    return result == Z_BUF_ERROR && stream.avail_out == 0 ? TINFL_STATUS_HAS_MORE_OUTPUT : TINFL_STATUS_FAILED;
+}
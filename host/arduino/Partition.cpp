@@ -0,0 +1,119 @@
+#include "esp_partition.h"
+
+#include <string.h>
+#include <vector>
+
+namespace
+{
+// 与 partitions.csv 一致
+const esp_partition_t PARTITIONS[] = {
+    {ESP_PARTITION_TYPE_DATA, 0x41, 0xFA0000, 0x10000, "history", false},
+    {ESP_PARTITION_TYPE_DATA, 0x40, 0xFB0000, 0x40000, "snapshot", false},
+};
+constexpr size_t PARTITION_COUNT = sizeof(PARTITIONS) / sizeof(PARTITIONS[0]);
+
+std::vector<uint8_t> g_contents[PARTITION_COUNT];
+uint64_t g_erasedBytes = 0;
+uint64_t g_writtenBytes = 0;
+
+std::vector<uint8_t> *contents(const esp_partition_t *partition)
+{
+    if (partition < PARTITIONS || partition >= PARTITIONS + PARTITION_COUNT)
+        return nullptr;
+    std::vector<uint8_t> &bytes = g_contents[partition - PARTITIONS];
+    if (bytes.empty())
+        bytes.assign(partition->size, 0xFF);
+    return &bytes;
+}
+
+bool inRange(const esp_partition_t *partition, size_t offset, size_t size)
+{
+    return offset <= partition->size && size <= partition->size - offset;
+}
+} // namespace
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char *label)
+{
+    for (const esp_partition_t &partition : PARTITIONS)
+    {
+        if (partition.type == type && (subtype == ESP_PARTITION_SUBTYPE_ANY || partition.subtype == subtype) &&
+            (!label || strcmp(partition.label, label) == 0))
+            return &partition;
+    }
+    return nullptr;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t srcOffset, void *dst, size_t size)
+{
+    std::vector<uint8_t> *bytes = contents(partition);
+    if (!bytes || !dst)
+        return ESP_ERR_INVALID_ARG;
+    if (!inRange(partition, srcOffset, size))
+        return ESP_ERR_INVALID_SIZE;
+    memcpy(dst, bytes->data() + srcOffset, size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *partition, size_t dstOffset, const void *src, size_t size)
+{
+    std::vector<uint8_t> *bytes = contents(partition);
+    if (!bytes || !src)
+        return ESP_ERR_INVALID_ARG;
+    if (!inRange(partition, dstOffset, size))
+        return ESP_ERR_INVALID_SIZE;
+    // 未擦除就写入时结果是新旧内容按位与，和真实闪存一样
+    const uint8_t *in = static_cast<const uint8_t *>(src);
+    for (size_t i = 0; i < size; i++)
+        (*bytes)[dstOffset + i] &= in[i];
+    g_writtenBytes += size;
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition, size_t offset, size_t size)
+{
+    std::vector<uint8_t> *bytes = contents(partition);
+    if (!bytes)
+        return ESP_ERR_INVALID_ARG;
+    if (offset % SPI_FLASH_SEC_SIZE || size % SPI_FLASH_SEC_SIZE)
+        return ESP_ERR_INVALID_SIZE;
+    if (!inRange(partition, offset, size))
+        return ESP_ERR_INVALID_SIZE;
+    memset(bytes->data() + offset, 0xFF, size);
+    g_erasedBytes += size;
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, size_t size, spi_flash_mmap_memory_t,
+                             const void **outPtr, spi_flash_mmap_handle_t *outHandle)
+{
+    std::vector<uint8_t> *bytes = contents(partition);
+    if (!bytes || !outPtr || !outHandle)
+        return ESP_ERR_INVALID_ARG;
+    if (!inRange(partition, offset, size))
+        return ESP_ERR_INVALID_SIZE;
+    *outPtr = bytes->data() + offset;
+    *outHandle = 1;
+    return ESP_OK;
+}
+
+void spi_flash_munmap(spi_flash_mmap_handle_t)
+{
+}
+
+uint64_t hostPartitionErasedBytes()
+{
+    return g_erasedBytes;
+}
+
+uint64_t hostPartitionWrittenBytes()
+{
+    return g_writtenBytes;
+}
+
+void hostPartitionReset()
+{
+    for (std::vector<uint8_t> &bytes : g_contents)
+        bytes.clear();
+    g_erasedBytes = 0;
+    g_writtenBytes = 0;
+}
@@ -0,0 +1,127 @@
+#include "Preferences.h"
+
+#include <cstring>
+
+namespace
+{
+// 命名空间 -> (键 -> 原始字节)，模拟 NVS 分区在重启间保持的内容
+std::map<std::string, std::map<std::string, std::vector<uint8_t>>> g_nvs;
+} // namespace
+
+uint32_t Preferences::s_writeCount = 0;
+uint32_t Preferences::s_failWrites = 0;
+
+bool Preferences::begin(const char *name, bool readOnly, const char *)
+{
+    if (!name || !name[0] || strlen(name) > 15)
+        return false;
+    _namespace = name;
+    _readOnly = readOnly;
+    _started = true;
+    return true;
+}
+
+void Preferences::end()
+{
+    _started = false;
+}
+
+void Preferences::hostReset()
+{
+    g_nvs.clear();
+    s_writeCount = 0;
+    s_failWrites = 0;
+}
+
+std::vector<uint8_t> *Preferences::find(const char *key)
+{
+    if (!_started || !key)
+        return nullptr;
+    auto &ns = g_nvs[_namespace];
+    auto it = ns.find(key);
+    return it == ns.end() ? nullptr : &it->second;
+}
+
+size_t Preferences::put(const char *key, const void *value, size_t length)
+{
+    if (!_started || _readOnly || !key || strlen(key) > 15)
+        return 0;
+    if (s_failWrites > 0)
+    {
+        s_failWrites--;
+        return 0;
+    }
+    const uint8_t *bytes = static_cast<const uint8_t *>(value);
+    g_nvs[_namespace][key].assign(bytes, bytes + length);
+    s_writeCount++;
+    return length;
+}
+
+bool Preferences::clear()
+{
+    if (!_started || _readOnly)
+        return false;
+    g_nvs[_namespace].clear();
+    s_writeCount++;
+    return true;
+}
+
+bool Preferences::remove(const char *key)
+{
+    if (!_started || _readOnly || !find(key))
+        return false;
+    g_nvs[_namespace].erase(key);
+    s_writeCount++;
+    return true;
+}
+
+bool Preferences::isKey(const char *key)
+{
+    return find(key) != nullptr;
+}
+
+size_t Preferences::putUChar(const char *key, uint8_t value)
+{
+    return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value)
+{
+    return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t length)
+{
+    return put(key, value, length);
+}
+
+uint8_t Preferences::getUChar(const char *key, uint8_t defaultValue)
+{
+    std::vector<uint8_t> *v = find(key);
+    return (v && v->size() == sizeof(uint8_t)) ? (*v)[0] : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue)
+{
+    std::vector<uint8_t> *v = find(key);
+    if (!v || v->size() != sizeof(uint32_t))
+        return defaultValue;
+    uint32_t value;
+    memcpy(&value, v->data(), sizeof(value));
+    return value;
+}
+
+size_t Preferences::getBytesLength(const char *key)
+{
+    std::vector<uint8_t> *v = find(key);
+    return v ? v->size() : 0;
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLength)
+{
+    std::vector<uint8_t> *v = find(key);
+    if (!v || v->size() > maxLength)
+        return 0;
+    memcpy(buf, v->data(), v->size());
+    return v->size();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Arduino.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+// 主机端 NVS：按命名空间保存在进程内存中，统计写入次数以便核对闪存磨损
+class Preferences
+{
+public:
+    bool begin(const char *name, bool readOnly = false, const char *partitionLabel = nullptr);
+    void end();
+
+    bool clear();
+    bool remove(const char *key);
+    bool isKey(const char *key);
+
+    size_t putUChar(const char *key, uint8_t value);
+    size_t putUInt(const char *key, uint32_t value);
+    size_t putBytes(const char *key, const void *value, size_t length);
+
+    uint8_t getUChar(const char *key, uint8_t defaultValue = 0);
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0);
+    size_t getBytesLength(const char *key);
+    size_t getBytes(const char *key, void *buf, size_t maxLength);
+
+    static uint32_t hostWriteCount() { return s_writeCount; }
+    // 让接下来的 count 次写入失败（返回 0，内容不变），模拟 NVS 已满或闪存出错
+    static void hostFailNextWrites(uint32_t count) { s_failWrites = count; }
+    static void hostReset();
+
+private:
+    std::string _namespace;
+    bool _started = false;
+    bool _readOnly = false;
+
+    static uint32_t s_writeCount;
+    static uint32_t s_failWrites;
+
+    std::vector<uint8_t> *find(const char *key);
+    size_t put(const char *key, const void *value, size_t length);
+};
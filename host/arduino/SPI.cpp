@@ -0,0 +1,41 @@
+#include "SPI.h"
+
+SPIClass SPI(FSPI);
+
+namespace
+{
+HostSpiListener *g_spiListener = nullptr;
+
+void emit(const uint8_t *data, size_t length)
+{
+    if (g_spiListener)
+        g_spiListener->onSpiBytes(data, length);
+}
+} // namespace
+
+void hostSetSpiListener(HostSpiListener *listener)
+{
+    g_spiListener = listener;
+}
+
+void SPIClass::begin(int8_t, int8_t, int8_t, int8_t)
+{
+}
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+    emit(&data, 1);
+    return 0;
+}
+
+uint16_t SPIClass::transfer16(uint16_t data)
+{
+    const uint8_t bytes[2] = {static_cast<uint8_t>(data >> 8), static_cast<uint8_t>(data & 0xFF)};
+    emit(bytes, sizeof(bytes));
+    return 0;
+}
+
+void SPIClass::writeBytes(const uint8_t *data, uint32_t size)
+{
+    emit(data, size);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Arduino.h"
+
+#define FSPI 0
+#define HSPI 1
+#define SPI_MODE0 0
+#define MSBFIRST 1
+
+class SPISettings
+{
+public:
+    SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0)
+        : clock(clock), bitOrder(bitOrder), dataMode(dataMode)
+    {
+    }
+
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+// 主机端 SPI 监听器：每个移出的字节都会回调给虚拟外设
+class HostSpiListener
+{
+public:
+    virtual ~HostSpiListener() = default;
+    virtual void onSpiBytes(const uint8_t *data, size_t length) = 0;
+};
+
+void hostSetSpiListener(HostSpiListener *listener);
+
+class SPIClass
+{
+public:
+    explicit SPIClass(uint8_t bus = HSPI) : _bus(bus) {}
+
+    void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1);
+    void end() {}
+    void setFrequency(uint32_t freq) { _settings.clock = freq; }
+    void setDataMode(uint8_t mode) { _settings.dataMode = mode; }
+    void setBitOrder(uint8_t order) { _settings.bitOrder = order; }
+    void beginTransaction(SPISettings settings) { _settings = settings; }
+    void endTransaction() {}
+
+    uint8_t transfer(uint8_t data);
+    uint16_t transfer16(uint16_t data);
+    void writeBytes(const uint8_t *data, uint32_t size);
+
+private:
+    uint8_t _bus;
+    SPISettings _settings;
+};
+
+extern SPIClass SPI;
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "FS.h"
+
+namespace fs
+{
+class SPIFFSFS : public FS
+{
+public:
+    size_t totalBytes() const { return 0x160000; }
+    size_t usedBytes() const { return 0; }
+};
+} // namespace fs
+
+extern fs::SPIFFSFS SPIFFS;
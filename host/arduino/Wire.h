@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Arduino.h"
+
+// 主机端 I2C：总线上没有器件，所有地址都不应答，真实传感器驱动在 begin() 里探测失败；
+// 主机端用回放轨迹的驱动代替（host/TraceSensor.h）
+class TwoWire
+{
+public:
+    explicit TwoWire(uint8_t bus = 0) : _bus(bus) {}
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+    void end() {}
+    void setClock(uint32_t frequency) {}
+
+    void beginTransmission(uint8_t address) {}
+    size_t write(uint8_t data) { return 1; }
+    size_t write(const uint8_t *data, size_t length) { return length; }
+    // 2 = 地址未应答
+    uint8_t endTransmission(bool sendStop = true) { return 2; }
+
+    uint8_t requestFrom(uint8_t address, uint8_t size, bool sendStop = true) { return 0; }
+    int available() { return 0; }
+    int read() { return -1; }
+
+private:
+    uint8_t _bus;
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <stdint.h>
+
+// 主机端 esp_timer：自启动以来的微秒数，与 micros() 同源（含 delay() 推进的虚拟时间），但不会 32 位回绕
+int64_t esp_timer_get_time();
@@ -0,0 +1,47 @@
+#pragma once
+
+// 主机端 FreeRTOS 最小兼容层：任务由 std::thread 承载，任务通知用互斥量 + 条件变量实现。
+// 只覆盖固件用到的接口，不模拟优先级与抢占。
+
+#include <atomic>
+#include <cstdint>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xFFFFFFFFu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define configMAX_PRIORITIES 25
+
+// 临界区：设备上是跨核自旋锁并屏蔽中断，主机端用自旋锁模拟（“中断”由其他线程扮演）
+struct portMUX_TYPE
+{
+    std::atomic<bool> locked{false};
+};
+#define portMUX_INITIALIZER_UNLOCKED {}
+
+inline void hostEnterCritical(portMUX_TYPE *mux)
+{
+    while (mux->locked.exchange(true, std::memory_order_acquire))
+    {
+    }
+}
+
+inline void hostExitCritical(portMUX_TYPE *mux)
+{
+    mux->locked.store(false, std::memory_order_release);
+}
+
+#define portENTER_CRITICAL(mux) hostEnterCritical(mux)
+#define portEXIT_CRITICAL(mux) hostExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) hostEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux) hostExitCritical(mux)
+#define portYIELD_FROM_ISR(...) ((void)0)
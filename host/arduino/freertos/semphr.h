@@ -0,0 +1,34 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+#include <mutex>
+
+// 主机端互斥信号量：静态控制块内嵌 std::mutex，只覆盖固件用到的静态创建、获取与释放
+struct StaticSemaphore_t
+{
+    std::mutex mutex;
+};
+typedef StaticSemaphore_t *SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer)
+{
+    return buffer;
+}
+
+// 只支持永久等待（portMAX_DELAY）与不等待两种超时
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait)
+{
+    if (ticksToWait == portMAX_DELAY)
+    {
+        semaphore->mutex.lock();
+        return pdTRUE;
+    }
+    return semaphore->mutex.try_lock() ? pdTRUE : pdFALSE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    semaphore->mutex.unlock();
+    return pdTRUE;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 主机端用 zlib 模拟 ESP32 ROM 中 miniz 的 tinfl 解压接口（构建时需链接 -lz）。
+// 只支持调用方一次给出完整输入与完整输出缓冲的用法（TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF）
+typedef uint8_t mz_uint8;
+typedef uint32_t mz_uint32;
+
+enum
+{
+    TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+    TINFL_FLAG_HAS_MORE_INPUT = 2,
+    TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
+    TINFL_FLAG_COMPUTE_ADLER32 = 8,
+};
+
+typedef enum
+{
+    TINFL_STATUS_BAD_PARAM = -3,
+    TINFL_STATUS_ADLER32_MISMATCH = -2,
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2,
+} tinfl_status;
+
+// 与 ROM 中的结构体大小相近（约 11 KB），主机端同样不能放在栈上
+typedef struct tinfl_decompressor_tag
+{
+    mz_uint32 m_state;
+    uint8_t m_tables[10992];
+} tinfl_decompressor;
+
+#define tinfl_init(r) \
+    do \
+    { \
+        (r)->m_state = 0; \
+    } while (0)
+
+tinfl_status tinfl_decompress(tinfl_decompressor *r, const mz_uint8 *pIn_buf_next, size_t *pIn_buf_size, mz_uint8 *pOut_buf_start,
+                              mz_uint8 *pOut_buf_next, size_t *pOut_buf_size, const mz_uint32 decomp_flags);
@@ -0,0 +1,1749 @@
+// 主机端渲染基准：用虚拟 SPI 屏依次渲染 data/themes 下的 6 套主题，
+// 统计每帧的 SPI 字节数、事务数（CS 拉低次数）、命令数与主机耗时，
+// 输出 PPM 快照，并与 host/bench/baseline.txt 比对黄金图指纹和事务数回归。
+//
+// 用法（在工程根目录）：
+//   pio run -e native && .pio/build/native/program [--update-baseline] [--verbose]
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <SPIFFS.h>
+#include <esp_partition.h>
+#include <freertos/task.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+#include "TraceSensor.h"
+#include "VirtualPanel.h"
+#include "core/AllocCounter.h"
+#include "core/AssetStore.h"
+#include "core/Profiler.h"
+#include "core/Scheduler.h"
+#include "display/Blend565.h"
+#include "display/BootSnapshot.h"
+#include "display/FrameBuffer.h"
+#include "display/GlyphCache.h"
+#include "display/IconAtlas.h"
+#include "display/TextRenderer.h"
+#include "display/TftDriver.h"
+#include "input/ButtonGestures.h"
+#include "sensors/HistoryLog.h"
+#include "sensors/SensorHistory.h"
+#include "sensors/SensorHub.h"
+#include "theme/ThemeManager.h"
+#include "ui/ClockWidget.h"
+#include "ui/DashboardRenderer.h"
+#include "ui/RenderPipeline.h"
+#include "ui/Sparkline.h"
+
+namespace
+{
+constexpr uint8_t TFT_CS = 8;
+constexpr uint8_t TFT_DC = 9;
+constexpr uint8_t TFT_RST = 10;
+constexpr uint8_t TFT_MOSI = 11;
+constexpr uint8_t TFT_SCLK = 12;
+
+const char *BASELINE_PATH = "host/bench/baseline.txt";
+const char *SNAPSHOT_DIR = "bench_out";
+const char *SENSOR_TRACE_PATH = "host/bench/sensor_trace.csv";
+// 环境历史：合成 12 天读数（超过 history 分区约 10 天的容量，验证循环覆盖）
+constexpr uint32_t HISTORY_DAYS = 12;
+// 与 main.cpp 的 CHART_MIN_RANGE 一致
+constexpr float CHART_MIN_RANGE[EnvCharts::COUNT] = {2.0f, 5.0f, 2.0f};
+
+struct FrameResult
+{
+    std::string name;
+    uint32_t checksum = 0;
+    VirtualPanel::Stats stats;
+    double hostMicros = 0;
+    double loadMicros = 0;
+    uint32_t repaintPixels = 0;
+};
+
+struct Baseline
+{
+    uint32_t checksum = 0;
+    uint64_t bytes = 0;
+    uint32_t transactions = 0;
+};
+
+template <typename Fn>
+double timeMicros(Fn &&fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Fn>
+FrameResult measureFrame(const std::string &name, VirtualPanel &panel, Fn &&render)
+{
+    panel.resetStats();
+    auto start = std::chrono::steady_clock::now();
+    render();
+    auto end = std::chrono::steady_clock::now();
+
+    FrameResult result;
+    result.name = name;
+    result.checksum = panel.checksum();
+    result.stats = panel.stats();
+    result.hostMicros = std::chrono::duration<double, std::micro>(end - start).count();
+    return result;
+}
+
+std::string readDataFile(const std::string &path)
+{
+    File file = SPIFFS.open(path.c_str(), FILE_READ);
+    std::string bytes(file.size(), '\0');
+    file.readBytes(&bytes[0], bytes.size());
+    file.close();
+    return bytes;
+}
+
+void writeDataFile(const std::string &path, const std::string &bytes)
+{
+    File file = SPIFFS.open(path.c_str(), FILE_WRITE);
+    file.write(reinterpret_cast<const uint8_t *>(bytes.data()), bytes.size());
+    file.close();
+}
+
+// 依次定位 keys 中的键（后一个键在前一个之后查找），把最后一个键的值交给 edit 改写；找不到时返回 false
+bool editJsonValue(std::string &json, std::initializer_list<const char *> keys,
+                   const std::function<std::string(const std::string &)> &edit)
+{
+    size_t pos = 0;
+    for (const char *key : keys)
+    {
+        pos = json.find(std::string("\"") + key + "\"", pos);
+        if (pos == std::string::npos)
+            return false;
+        pos += strlen(key) + 2;
+    }
+    const size_t colon = json.find(':', pos);
+    const size_t start = colon == std::string::npos ? colon : json.find_first_not_of(" \t\r\n", colon + 1);
+    const size_t end = start == std::string::npos ? start : json.find_first_of(",}\r\n", start);
+    if (end == std::string::npos)
+        return false;
+    json.replace(start, end - start, edit(json.substr(start, end - start)));
+    return true;
+}
+
+std::map<std::string, Baseline> loadBaseline(const char *path)
+{
+    std::map<std::string, Baseline> baseline;
+    FILE *fp = fopen(path, "r");
+    if (!fp)
+        return baseline;
+
+    char line[256];
+    while (fgets(line, sizeof(line), fp))
+    {
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+        char name[64];
+        unsigned checksum = 0;
+        unsigned long long bytes = 0;
+        unsigned transactions = 0;
+        if (sscanf(line, "%63s %x %llu %u", name, &checksum, &bytes, &transactions) == 4)
+            baseline[name] = {checksum, bytes, transactions};
+    }
+    fclose(fp);
+    return baseline;
+}
+
+bool saveBaseline(const char *path, const std::vector<FrameResult> &results)
+{
+    FILE *fp = fopen(path, "w");
+    if (!fp)
+        return false;
+
+    fprintf(fp, "# frame checksum spi_bytes transactions\n");
+    for (const FrameResult &r : results)
+        fprintf(fp, "%s %08x %llu %u\n", r.name.c_str(), r.checksum, static_cast<unsigned long long>(r.stats.bytes), r.stats.transactions);
+    fclose(fp);
+    return true;
+}
+// 快速混合内核与参考实现逐位比对：全部 256 级 alpha x 伪随机颜色对，外加整段接口
+uint32_t checkBlendKernels()
+{
+    uint32_t mismatches = 0;
+    uint32_t seed = 0x12345678;
+    auto next = [&]() {
+        seed = seed * 1664525 + 1013904223;
+        return static_cast<uint16_t>(seed >> 16);
+    };
+
+    const uint16_t edges[] = {0x0000, 0xFFFF, 0xF800, 0x07E0, 0x001F, 0x8410};
+    for (uint16_t fg : edges)
+        for (uint16_t bg : edges)
+            for (uint16_t a = 0; a < 256; a++)
+                mismatches += Blend565::blend(fg, bg, a) != Blend565::reference(fg, bg, a);
+
+    for (uint32_t n = 0; n < 4000; n++)
+    {
+        const uint16_t fg = next();
+        const uint16_t bg = next();
+        for (uint16_t a = 0; a < 256; a++)
+            mismatches += Blend565::blend(fg, bg, a) != Blend565::reference(fg, bg, a);
+    }
+
+    std::vector<uint16_t> dst(257), src(257), expect(257);
+    for (uint16_t a : {0, 1, 25, 128, 210, 225, 254, 255})
+    {
+        const uint16_t color = next();
+        for (size_t i = 0; i < dst.size(); i++)
+        {
+            dst[i] = (i % 7 == 0) ? dst[i > 0 ? i - 1 : 0] : next();
+            src[i] = next();
+            expect[i] = Blend565::reference(color, dst[i], a);
+        }
+        std::vector<uint16_t> work = dst;
+        Blend565::fillSpan(work.data(), color, a, work.size());
+        mismatches += work != expect;
+
+        for (size_t i = 0; i < dst.size(); i++)
+            expect[i] = Blend565::reference(src[i], dst[i], a);
+        work = dst;
+        Blend565::blendSpan(work.data(), src.data(), a, work.size());
+        mismatches += work != expect;
+    }
+
+    // 4 位蒙版：覆盖率 n 等价于 alpha = n * 17，起始像素可落在字节的高半字节
+    std::vector<uint8_t> mask(dst.size() / 2 + 1);
+    for (uint8_t &m : mask)
+        m = static_cast<uint8_t>(next());
+    for (size_t first : {0, 1})
+    {
+        const uint16_t color = next();
+        const size_t count = dst.size() - first;
+        for (size_t i = 0; i < count; i++)
+        {
+            const size_t bit = first + i;
+            const uint8_t level = (mask[bit / 2] >> (4 * (bit & 1))) & 0x0F;
+            expect[i] = Blend565::reference(color, dst[i], level * 17);
+        }
+        std::vector<uint16_t> work = dst;
+        Blend565::maskSpan(work.data(), mask.data(), first, color, count);
+        mismatches += !std::equal(work.begin(), work.begin() + count, expect.begin());
+    }
+    return mismatches;
+}
+
+// LRU 语义：容量之外最早插入的条目被淘汰，最近访问过的条目保留
+bool checkGlyphCacheLru()
+{
+    GlyphCache cache;
+    if (!cache.begin())
+        return false;
+
+    const uint16_t capacity = cache.capacity();
+    uint8_t *slot = nullptr;
+    for (uint32_t cp = 0; cp < capacity; cp++)
+        cache.insert(0, cp, slot)->advance = static_cast<uint8_t>(cp);
+    // 访问 0 号后再插入一个，被淘汰的应是 1 号
+    bool ok = cache.find(0, 0) != nullptr;
+    cache.insert(1, 0x4E2D, slot)->advance = 7;
+    ok = ok && cache.find(0, 0) && !cache.find(0, 1) && cache.find(0, capacity - 1) && cache.find(1, 0x4E2D)->advance == 7;
+    return ok && cache.evictions() == 1;
+}
+
+// .fnt 加载器：用随仓库提交的小字体包 host/bench/fonts/bench_12.fnt 渲染字形
+// （tools/build_fonts.py 的 build_pack 从 Noto Sans SC 12px 生成，只含数字、: % ? 与 ABCabc）；
+// 缺失的字体应失败并被记住，之后每帧不再访问文件系统，已加载的字体不受影响
+bool checkFontLoader(FrameBuffer &canvas, VirtualPanel &panel, uint32_t &missingReopens)
+{
+    fs::FS benchFs;
+    benchFs.hostSetRoot("host/bench");
+    AssetStore store;
+    if (!benchFs.begin(false))
+        return false;
+    store.begin(benchFs); // 没有归档，全部走散装文件
+    TextRenderer text;
+    text.begin(store);
+
+    canvas.fillScreen(0x0000);
+    canvas.flush();
+    const uint32_t blank = panel.checksum();
+    bool ok = text.drawText(canvas, 10, 10, "12:34 Abc 56%", "bench_12", 0xFFFF, 0x0000) &&
+              text.textWidth("12:34", "bench_12") > 0 && text.cache().misses() > 0;
+    canvas.flush();
+    ok = ok && panel.checksum() != blank;
+
+    ok = ok && !text.drawText(canvas, 10, 40, "12:34", "missing", 0xFFFF, 0x0000);
+    const uint32_t opensBefore = benchFs.hostOpenCount();
+    for (int i = 0; i < 10; i++)
+        ok = !text.drawText(canvas, 10, 40, "12:34", "missing", 0xFFFF, 0x0000) && text.textWidth("12:34", "missing") < 0 && ok;
+    missingReopens = benchFs.hostOpenCount() - opensBefore;
+
+    ok = ok && text.drawText(canvas, 10, 60, "0?Z", "bench_12", 0xFFFF, 0x0000);
+    canvas.fillScreen(0x0000);
+    canvas.flush();
+    store.end();
+    return ok && missingReopens == 0;
+}
+
+// 调度器用虚拟时钟驱动：时间只在空闲钩子里推进，定时器应恰好在截止时刻触发
+uint32_t g_virtualMicros = 0;
+
+uint32_t virtualClock()
+{
+    return g_virtualMicros;
+}
+
+void advanceVirtualClock(uint32_t sleepMicros, void *)
+{
+    g_virtualMicros += sleepMicros;
+}
+
+struct SchedulerProbe
+{
+    Scheduler *scheduler;
+    uint32_t start;
+    std::vector<uint32_t> fires[4];
+    Scheduler::TimerId selfCancelling;
+    std::vector<uint16_t> events;
+};
+
+template <int N>
+void recordFire(void *context)
+{
+    SchedulerProbe &probe = *static_cast<SchedulerProbe *>(context);
+    probe.fires[N].push_back((g_virtualMicros - probe.start) / 1000);
+    if (N == 3 && probe.fires[3].size() == 3)
+        probe.scheduler->cancel(probe.selfCancelling);
+}
+
+void recordEvent(const Scheduler::Event &event, void *context)
+{
+    static_cast<SchedulerProbe *>(context)->events.push_back(event.arg);
+}
+
+// 周期/单次/取消/回调内自取消的定时器在虚拟时钟下跑 5 秒（跨越 32 位微秒回绕），
+// 同时另一线程以“中断”方式投递事件
+bool checkScheduler(Scheduler::Stats &stats)
+{
+    g_virtualMicros = 0xFFFFFFFFu - 2500000;
+    Scheduler scheduler(virtualClock);
+    scheduler.begin();
+    scheduler.setIdleHook(advanceVirtualClock);
+
+    SchedulerProbe probe;
+    probe.scheduler = &scheduler;
+    probe.start = g_virtualMicros;
+    scheduler.onEvent(3, recordEvent, &probe);
+    scheduler.startPeriodic(1000, recordFire<0>, &probe);
+    scheduler.startOneShot(250, recordFire<1>, &probe);
+    scheduler.cancel(scheduler.startOneShot(400, recordFire<2>, &probe));
+    probe.selfCancelling = scheduler.startPeriodic(300, recordFire<3>, &probe);
+
+    const uint16_t eventCount = 20;
+    std::thread isr([&scheduler]() {
+        for (uint16_t i = 0; i < eventCount; i++)
+            scheduler.postFromISR(3, i);
+    });
+    while (g_virtualMicros - probe.start < 5000000)
+        scheduler.runOnce();
+    isr.join();
+    scheduler.dispatch();
+    stats = scheduler.stats();
+
+    bool eventsInOrder = probe.events.size() == eventCount;
+    for (uint16_t i = 0; eventsInOrder && i < eventCount; i++)
+        eventsInOrder = probe.events[i] == i;
+
+    return probe.fires[0] == std::vector<uint32_t>{1000, 2000, 3000, 4000, 5000} && probe.fires[1] == std::vector<uint32_t>{250} &&
+           probe.fires[2].empty() && probe.fires[3] == std::vector<uint32_t>{300, 600, 900} && eventsInOrder &&
+           stats.maxJitterMicros == 0 && stats.idlePercent == 100;
+}
+
+// 按键状态机用合成边沿序列驱动：TraceEdge 的时刻以毫秒计，相对起点偏移
+struct TraceEdge
+{
+    uint32_t atMs;
+    bool pressed;
+    bool bouncy; // 翻转后 3 ms 内再抖动 4 次，最终停在同一电平
+};
+
+struct GestureRecord
+{
+    ButtonGestures::Gesture gesture;
+    uint8_t count;
+    uint32_t pressMs;
+    uint32_t atMs;
+
+    bool operator==(const GestureRecord &other) const
+    {
+        return gesture == other.gesture && count == other.count && pressMs == other.pressMs && atMs == other.atMs;
+    }
+};
+
+struct GestureProbe
+{
+    uint32_t start;
+    std::vector<GestureRecord> records;
+};
+
+void recordGesture(const ButtonGestures::Event &event, void *context)
+{
+    GestureProbe &probe = *static_cast<GestureProbe *>(context);
+    const GestureRecord record = {event.gesture, event.count, (event.pressMicros - probe.start) / 1000,
+                                  (event.micros - probe.start) / 1000};
+    probe.records.push_back(record);
+}
+
+// 每毫秒把到时的边沿“中断”进队列再 poll 一次；[busyFromMs, busyToMs) 期间模拟刷屏占用，只进队列不处理
+std::vector<GestureRecord> runGestureTrace(ButtonGestures &buttons, const std::vector<TraceEdge> &trace, uint32_t endMs,
+                                           uint32_t busyFromMs, uint32_t busyToMs)
+{
+    static const uint32_t BOUNCE_US[] = {300, 900, 1500, 2600};
+    GestureProbe probe;
+    probe.start = 0xFFFFFFFFu - 2000000; // 长按途中跨越 32 位微秒回绕
+    buttons.setHandler(recordGesture, &probe);
+
+    std::vector<std::pair<uint32_t, bool>> edges;
+    for (const TraceEdge &edge : trace)
+    {
+        edges.push_back(std::make_pair(edge.atMs * 1000, edge.pressed));
+        for (uint8_t i = 0; edge.bouncy && i < 4; i++)
+            edges.push_back(std::make_pair(edge.atMs * 1000 + BOUNCE_US[i], (i & 1) ? edge.pressed : !edge.pressed));
+    }
+
+    size_t next = 0;
+    for (uint32_t ms = 0; ms <= endMs; ms++)
+    {
+        for (; next < edges.size() && edges[next].first <= ms * 1000; next++)
+            buttons.pushEdgeFromISR(edges[next].second, probe.start + edges[next].first);
+        if (ms < busyFromMs || ms >= busyToMs)
+            buttons.poll(probe.start + ms * 1000);
+    }
+    buttons.setHandler(nullptr);
+    return probe.records;
+}
+
+// 带抖动的短按、刷屏期间到达的双击、长按连发、锁定期内就松开的轻点，以及关闭双击后短按在松开时立即触发
+bool checkButtonGestures(ButtonGestures::Stats &stats)
+{
+    typedef ButtonGestures::Gesture G;
+    ButtonGestures buttons;
+    const std::vector<TraceEdge> trace = {
+        {100, true, true},   {200, false, true},  {1000, true, true},  {1080, false, true}, {1200, true, true},
+        {1280, false, true}, {2000, true, true},  {3300, false, true}, {5000, true, false}, {5010, false, false},
+    };
+    const std::vector<GestureRecord> expected = {
+        {G::ShortPress, 1, 100, 450}, {G::DoubleClick, 1, 1200, 1200}, {G::LongPress, 1, 2000, 2600},
+        {G::Repeat, 1, 2000, 3000},   {G::ShortPress, 1, 5000, 5270},
+    };
+    const bool gesturesOk = runGestureTrace(buttons, trace, 6000, 1150, 1250) == expected;
+    stats = buttons.stats();
+
+    ButtonGestures::Config config = ButtonGestures::defaultConfig();
+    config.doubleClickMs = 0;
+    ButtonGestures immediate(config);
+    const std::vector<GestureRecord> immediateExpected = {{G::ShortPress, 1, 100, 200}};
+    const bool immediateOk =
+        runGestureTrace(immediate, {{100, true, true}, {200, false, true}}, 1000, 0, 0) == immediateExpected;
+
+    // 8 个带抖动的边沿各滤掉 4 个，加上锁定期内的松开沿；刷屏积压的双击在 1250 ms 才被处理
+    return gesturesOk && immediateOk && stats.edges == 42 && stats.bounces == 33 && stats.edgesDropped == 0 &&
+           stats.maxLatencyMicros == 50000 && !buttons.isPressed();
+}
+
+// 把剖析器导出的 Chrome trace 写进文件
+class FilePrint : public Print
+{
+public:
+    explicit FilePrint(const std::string &path) : _file(fopen(path.c_str(), "w")) {}
+    ~FilePrint() override
+    {
+        if (_file)
+            fclose(_file);
+    }
+    bool isOpen() const { return _file != nullptr; }
+    const std::string &text() const { return _text; }
+
+    size_t write(uint8_t c) override
+    {
+        _text += static_cast<char>(c);
+        return _file ? fputc(c, _file) != EOF : 0;
+    }
+
+private:
+    FILE *_file;
+    std::string _text;
+};
+
+// 各混合路径在整屏缓冲上的吞吐（百万像素/秒）
+void benchBlendKernels()
+{
+    const size_t pixels = static_cast<size_t>(TftDriver::WIDTH) * TftDriver::HEIGHT;
+    const int rounds = 20;
+    std::vector<uint16_t> dst(pixels), src(pixels);
+    for (size_t i = 0; i < pixels; i++)
+    {
+        dst[i] = static_cast<uint16_t>(i * 2654435761u >> 16);
+        src[i] = static_cast<uint16_t>(i * 40503u);
+    }
+
+    auto report = [&](const char *name, double micros) {
+        printf("  %-22s %8.1f Mpx/s\n", name, pixels * rounds / micros);
+    };
+    report("reference (逐像素)", timeMicros([&]() {
+               for (int r = 0; r < rounds; r++)
+                   for (size_t i = 0; i < pixels; i++)
+                       dst[i] = Blend565::reference(0x2945, dst[i], 210);
+           }));
+    report("blend (逐像素)", timeMicros([&]() {
+               for (int r = 0; r < rounds; r++)
+                   for (size_t i = 0; i < pixels; i++)
+                       dst[i] = Blend565::blend(0x2945, dst[i], 210);
+           }));
+    report("fillSpan", timeMicros([&]() {
+               for (int r = 0; r < rounds; r++)
+                   Blend565::fillSpan(dst.data(), 0x2945 + r, 210, pixels);
+           }));
+    report("blendSpan", timeMicros([&]() {
+               for (int r = 0; r < rounds; r++)
+                   Blend565::blendSpan(dst.data(), src.data(), 128, pixels);
+           }));
+}
+
+struct PanelVariantResult
+{
+    uint32_t initTransactions = 0;
+    uint32_t initCommands = 0;
+    uint32_t checksum = 0;
+    uint64_t bytes = 0;
+};
+
+// 用指定面板特化的驱动在虚拟屏上初始化并画一组固定图元（含裁剪、斜线、文本与像素块）
+template <typename Traits>
+PanelVariantResult drawPanelVariant(VirtualPanel &panel)
+{
+    PanelDriver<Traits> driver(TFT_CS, TFT_DC, TFT_RST, TFT_MOSI, TFT_SCLK);
+    PanelVariantResult result;
+    panel.resetStats();
+    driver.beginAsleep();
+    result.initTransactions = panel.stats().transactions;
+    result.initCommands = panel.stats().commands;
+    driver.wake();
+
+    std::vector<uint16_t> sprite(32 * 32);
+    for (size_t i = 0; i < sprite.size(); i++)
+        sprite[i] = static_cast<uint16_t>(i * 2654435761u >> 16);
+    panel.resetStats();
+    driver.fillScreen(0x18E3);
+    driver.fillRect(-10, PanelDriver<Traits>::HEIGHT - 20, 80, 40, 0xF800);
+    driver.drawLine(0, 0, PanelDriver<Traits>::WIDTH - 1, PanelDriver<Traits>::HEIGHT - 1, 0xFFFF);
+    driver.drawText(20, 40, "PANEL 42", 0x07E0, 2);
+    driver.pushImage(100, 100, 32, 32, sprite.data(), 32);
+    result.checksum = panel.checksum();
+    result.bytes = panel.stats().bytes;
+    return result;
+}
+
+struct ArchiveResult
+{
+    uint32_t files = 0;
+    uint32_t mismatches = 0;
+    uint32_t compressed = 0;
+    double looseMicros = 0;   // 每个文件 打开 + 读完
+    double archiveMicros = 0; // 每个文件 查找 + 读完（压缩条目含解压）
+    double avgProbes = 0;
+    uint32_t looseOpens = 0;  // 归档读取期间回退到散装文件的次数
+};
+
+// 与 tools/pack_assets.py 的收录规则一致：运行时读取的文件，不含构建时转换用的源图
+std::vector<std::string> listRuntimeFiles(const std::string &root)
+{
+    std::vector<std::string> paths;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(root))
+    {
+        const std::string ext = entry.path().extension().string();
+        if (!entry.is_regular_file() || entry.path().filename().string()[0] == '.' || ext == ".svg" || ext == ".webp" ||
+            ext == ".png" || ext == ".jpg" || ext == ".jpeg")
+            continue;
+        paths.push_back("/" + std::filesystem::relative(entry.path(), root).generic_string());
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+// 逐个文件比对散装读取与归档读取的内容，并各自计时
+ArchiveResult checkAssetArchive(AssetStore &packed)
+{
+    ArchiveResult result;
+    const std::vector<std::string> paths = listRuntimeFiles(SPIFFS.hostRoot());
+    const int rounds = 20;
+    std::vector<std::string> loose(paths.size());
+    result.looseMicros = timeMicros([&]() {
+        for (int r = 0; r < rounds; r++)
+            for (size_t i = 0; i < paths.size(); i++)
+                loose[i] = readDataFile(paths[i]);
+    });
+
+    const AssetStore::Stats before = packed.stats();
+    std::vector<std::string> archived(paths.size());
+    result.archiveMicros = timeMicros([&]() {
+        for (int r = 0; r < rounds; r++)
+            for (size_t i = 0; i < paths.size(); i++)
+            {
+                FileStamp stamp;
+                size_t size = 0;
+                std::string &bytes = archived[i];
+                bytes.clear();
+                if (packed.stat(paths[i].c_str(), stamp))
+                {
+                    bytes.resize(stamp.size);
+                    if (!packed.load(paths[i].c_str(), &bytes[0], bytes.size(), size))
+                        bytes.clear();
+                }
+            }
+    });
+    const AssetStore::Stats after = packed.stats();
+
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (archived[i] != loose[i])
+        {
+            printf("[归档] %s 内容与散装文件不一致 (%u / %u 字节)\n", paths[i].c_str(), static_cast<unsigned>(archived[i].size()),
+                   static_cast<unsigned>(loose[i].size()));
+            result.mismatches++;
+        }
+        // 压缩条目不能流式打开
+        if (!packed.open(paths[i].c_str()))
+            result.compressed++;
+    }
+    result.files = paths.size();
+    result.looseMicros /= rounds * std::max<size_t>(paths.size(), 1);
+    result.archiveMicros /= rounds * std::max<size_t>(paths.size(), 1);
+    const uint32_t lookups = after.lookups - before.lookups;
+    result.avgProbes = lookups ? static_cast<double>(after.probes - before.probes) / lookups : 0;
+    result.looseOpens = after.looseOpens - before.looseOpens;
+    return result;
+}
+
+struct SensorReplay
+{
+    bool loaded = false;
+    SensorHub::Stats hub = {};
+    uint32_t samples = 0;
+    uint32_t rawChanges = 0;   // 每个原始读数四舍五入后直接上屏时，显示值变化的次数
+    uint32_t redraws = 0;      // 滤波与回差之后真正改动文本、触发重画的次数
+    uint64_t redrawBytes = 0;
+    uint32_t redrawPixels = 0;
+    uint32_t maxRedrawPixels = 0;
+    uint32_t quietRenders = 0; // 读数到达但显示值没变的轮次
+    uint64_t quietBytes = 0;   // 这些轮次里推送的 SPI 字节，应为 0
+    float rawTemp[2] = {1e9f, -1e9f};
+    float filteredTemp[2] = {1e9f, -1e9f};
+    int32_t finalRounded[3] = {};
+    std::string texts[3];
+    bool keptAfterSwitch = false;
+};
+
+// 传感器采集：三个回放轨迹的模拟传感器按各自周期采样，滤波后经 SPSC 队列送到“界面”一侧，
+// 每轮取完队列都渲染一次：显示值没变的轮次不应产生任何 SPI 流量
+SensorReplay replaySensorTrace(FrameBuffer &canvas, VirtualPanel &panel)
+{
+    SensorReplay result;
+    SensorTrace trace;
+    if (!trace.load(SENSOR_TRACE_PATH))
+        return result;
+    result.loaded = true;
+
+    // 第 1 套主题的三段环境文本都带数字占位
+    ThemeManager themes;
+    themes.begin();
+    for (uint8_t i = 0; i < 6 && themes.currentThemeNumber() != 1; i++)
+        themes.switchToNextTheme();
+    DashboardRenderer renderer(canvas);
+    renderer.render(themes.theme(), themes.currentThemeNumber());
+
+    TraceSensor aht20("AHT20 (trace)", trace, {Quantity::Temperature, Quantity::Humidity}, 2000);
+    TraceSensor bmp280("BMP280 (trace)", trace, {Quantity::Pressure}, 2000);
+    TraceSensor bh1750("BH1750 (trace)", trace, {Quantity::Illuminance}, 1000);
+    SensorHub hub;
+    hub.add(aht20);
+    hub.add(bmp280);
+    hub.add(bh1750);
+
+    int32_t rawShown[3] = {};
+    bool rawValid[3] = {};
+    float lastFiltered[3] = {};
+    const uint32_t start = millis();
+    while (millis() - start <= trace.durationMs())
+    {
+        const uint32_t wait = hub.poll(millis());
+        SensorSample sample;
+        bool changed = false;
+        bool received = false;
+        while (hub.pop(sample))
+        {
+            result.samples++;
+            const uint8_t q = static_cast<uint8_t>(sample.quantity);
+            if (q < 3)
+            {
+                received = true;
+                const int32_t raw = static_cast<int32_t>(lroundf(sample.raw));
+                if (rawValid[q] && raw != rawShown[q])
+                    result.rawChanges++;
+                rawShown[q] = raw;
+                rawValid[q] = true;
+                lastFiltered[q] = sample.value;
+            }
+            if (sample.quantity == Quantity::Temperature)
+            {
+                result.rawTemp[0] = std::min(result.rawTemp[0], sample.raw);
+                result.rawTemp[1] = std::max(result.rawTemp[1], sample.raw);
+                result.filteredTemp[0] = std::min(result.filteredTemp[0], sample.value);
+                result.filteredTemp[1] = std::max(result.filteredTemp[1], sample.value);
+            }
+            changed = themes.setSensorValue(sample.quantity, sample.value) || changed;
+        }
+
+        const uint64_t bytesBefore = panel.stats().bytes;
+        renderer.render(themes.theme(), themes.currentThemeNumber());
+        const uint64_t bytes = panel.stats().bytes - bytesBefore;
+        if (changed)
+        {
+            result.redraws++;
+            result.redrawBytes += bytes;
+            result.redrawPixels += renderer.lastRepaintPixels();
+            result.maxRedrawPixels = std::max(result.maxRedrawPixels, renderer.lastRepaintPixels());
+        }
+        else if (received)
+        {
+            result.quietRenders++;
+            result.quietBytes += bytes;
+        }
+        delay(wait);
+    }
+
+    result.hub = hub.stats();
+    const ThemeConfig &theme = themes.theme();
+    result.texts[0] = theme.tempText.value.c_str();
+    result.texts[1] = theme.humidText.value.c_str();
+    result.texts[2] = theme.pressureText.value.c_str();
+    for (uint8_t q = 0; q < 3; q++)
+        result.finalRounded[q] = static_cast<int32_t>(lroundf(lastFiltered[q]));
+
+    // 切到下一套主题后继续显示实时读数，而不是主题文件里的占位值
+    themes.switchToNextTheme();
+    result.keptAfterSwitch = result.texts[0] == themes.theme().tempText.value.c_str() &&
+                             result.texts[1] == themes.theme().humidText.value.c_str() &&
+                             result.texts[2] == themes.theme().pressureText.value.c_str();
+    return result;
+}
+
+struct HistoryCheck
+{
+    size_t memoryBytes = 0;
+    uint32_t minuteBytesPerDay = 0; // 分钟层每个量每天占用
+    float maxError[SensorHistory::SERIES] = {};
+    uint32_t outageGaps = 0; // 传感器中断的一小时在分钟层留下的缺测点（应为 60）
+    uint32_t segments = 0;
+    uint32_t erasedBytes = 0;
+    uint32_t restoredSegments = 0;
+    uint32_t restoreMicros = 0;
+    bool restoredMatches = false;
+    bool rebased = false;
+    uint32_t simulateMicros = 0;
+    uint32_t plotMicros = 0;     // 三条 24 小时迷你图：解码 + LTTB + 光栅化
+    uint32_t weekPlotMicros = 0; // 三条 7 天迷你图
+    uint8_t widths[EnvCharts::COUNT] = {};
+    bool peakKept = false;
+    bool decimationMissed = false;
+    uint32_t renderMicros = 0;
+    uint32_t chartPixels = 0;
+    uint64_t chartBytes = 0;
+    uint64_t unchangedBytes = 0;
+    uint32_t tickPixels = 0; // 一分钟后迷你图左移一格的重画
+    uint64_t tickBytes = 0;
+};
+
+// 合成读数：日变化 + 小噪声，气压三天一个周期；温度在 spikeS 起有 3 分钟 +5 °C 的尖峰
+float syntheticReading(uint8_t series, uint32_t t, uint32_t spikeS, uint32_t &seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    const float noise = static_cast<float>((seed >> 8) % 1000) / 1000.0f - 0.5f;
+    const float day = 2.0f * static_cast<float>(M_PI) * (t % 86400) / 86400.0f;
+    switch (series)
+    {
+    case 0:
+        return 24.0f + 3.0f * sinf(day) + 0.1f * noise + (t >= spikeS && t < spikeS + 180 ? 5.0f : 0.0f);
+    case 1:
+        return 45.0f + 8.0f * sinf(day + 1.0f) + 0.4f * noise;
+    default:
+        return 1012.0f + 4.0f * sinf(2.0f * static_cast<float>(M_PI) * (t % 259200) / 259200.0f) + 0.2f * noise;
+    }
+}
+
+// 三条迷你图按主题排布并降采样，与 main.cpp 的 refreshCharts 相同
+void plotCharts(const ThemeManager &themes, const SensorHistory &history, SensorHistory::Tier tier, SparklinePlotter &plotter,
+                EnvCharts &charts)
+{
+    const uint16_t count = SensorHistory::pointsOf(tier);
+    for (uint8_t i = 0; i < EnvCharts::COUNT; i++)
+    {
+        Sparkline &line = charts.lines[i];
+        SparklinePlotter::layout(themes.theme(), i, line);
+        if (!themes.showsSensor(static_cast<Quantity>(i)))
+            line.width = 0;
+        if (!line.width)
+            continue;
+        history.read(tier, i, count, plotter.points());
+        plotter.plot(count, CHART_MIN_RANGE[i], line);
+    }
+}
+
+// 数字颜色与面板实色相同（白色面板上的白字）时，逐格更新仍应按字形画出墨迹，而不是把同色像素当作透明露出底图
+bool checkClockInk(TftDriver &display)
+{
+    FrameBuffer canvas(display);
+    if (!canvas.begin())
+        return false;
+    canvas.fillScreen(0x0000);
+
+    TextStyle style;
+    style.x = 20;
+    style.y = 20;
+    style.size = 2;
+    style.color = 0xFFFF;
+    style.value = "12:34";
+    ClockWidget clock;
+    uint32_t pixels = 0;
+    if (!clock.prepare(style, style.color) || !clock.draw(canvas, style.value.view()))
+        return false;
+    style.value = "12:35";
+    if (!clock.update(canvas, style, pixels) || pixels != clock.cellPixels())
+        return false;
+
+    const int16_t w = clock.cellWidth();
+    const int16_t h = clock.cellHeight();
+    std::vector<uint16_t> cell(clock.cellPixels());
+    canvas.readImage(style.x + 4 * Font5x7::ADVANCE * style.size, style.y, w, h, cell.data(), w);
+    for (int16_t row = 0; row < h; row++)
+    {
+        uint32_t mask = Font5x7::rowMask('5', style.size, row);
+        for (int16_t col = 0; col < w; col++, mask >>= 1)
+        {
+            if (cell[row * w + col] != ((mask & 0x1) ? style.color : 0x0000))
+                return false;
+        }
+    }
+    return true;
+}
+
+// 环境历史：12 天 2 秒一次的读数经三层汇总、每 15 分钟落盘一段，核对分钟层误差与缺测、
+// 模拟重启后从 history 分区恢复的分钟层与 15 分钟层和原来逐点一致，再量迷你图降采样与渲染的耗时和重画范围
+HistoryCheck checkSensorHistory(FrameBuffer &canvas, VirtualPanel &panel)
+{
+    HistoryCheck result;
+    SensorHistory history;
+    HistoryLog log;
+    if (!history.begin() || !log.begin(history, 0))
+        return result;
+    result.memoryBytes = history.memoryBytes();
+    // 分钟层一天正好 1440 点：一个量的分钟层环形缓冲就是每天的占用
+    DeltaRing minute;
+    minute.begin(SensorHistory::pointsOf(SensorHistory::Tier::Minute));
+    result.minuteBytesPerDay = static_cast<uint32_t>(minute.memoryBytes());
+
+    const uint32_t endS = HISTORY_DAYS * 86400;
+    const uint32_t spikeS = endS - 9 * 3600 - 17 * 60;
+    const uint32_t outageS = endS - 20 * 3600;
+    const uint32_t firstMinute = endS / 60 - SensorHistory::pointsOf(SensorHistory::Tier::Minute);
+    std::vector<double> sums[SensorHistory::SERIES];
+    std::vector<uint32_t> counts(SensorHistory::pointsOf(SensorHistory::Tier::Minute), 0);
+    for (std::vector<double> &sum : sums)
+        sum.assign(counts.size(), 0.0);
+
+    uint32_t seed = 20261017;
+    const Quantity quantities[SensorHistory::SERIES] = {Quantity::Temperature, Quantity::Humidity, Quantity::Pressure};
+    const uint32_t simulateStart = micros();
+    for (uint32_t t = 0; t < endS; t += 2)
+    {
+        if (t < outageS || t >= outageS + 3600)
+        {
+            for (uint8_t s = 0; s < SensorHistory::SERIES; s++)
+            {
+                const float value = syntheticReading(s, t, spikeS, seed);
+                history.record(quantities[s], value, t);
+                if (t / 60 >= firstMinute)
+                    sums[s][t / 60 - firstMinute] += value;
+            }
+            if (t / 60 >= firstMinute)
+                counts[t / 60 - firstMinute]++;
+        }
+        if (history.advance(t) & (1 << static_cast<uint8_t>(SensorHistory::Tier::Quarter)))
+            result.segments += log.save(history);
+    }
+    if (history.advance(endS) & (1 << static_cast<uint8_t>(SensorHistory::Tier::Quarter)))
+        result.segments += log.save(history);
+    result.simulateMicros = micros() - simulateStart;
+    result.erasedBytes = log.stats().erasedBytes;
+
+    // 分钟层与精确的分钟平均比较：误差不超过一个量化单位（原始层与分钟层各舍入一次）
+    std::vector<float> points(SensorHistory::pointsOf(SensorHistory::Tier::Minute));
+    for (uint8_t s = 0; s < SensorHistory::SERIES; s++)
+    {
+        history.read(SensorHistory::Tier::Minute, s, points.size(), points.data());
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            if (!counts[i])
+            {
+                if (s == 0 && std::isnan(points[i]))
+                    result.outageGaps++;
+                continue;
+            }
+            const float error = std::isnan(points[i]) ? 1e9f : fabsf(points[i] - static_cast<float>(sums[s][i] / counts[i]));
+            result.maxError[s] = std::max(result.maxError[s], error);
+        }
+    }
+
+    // 重启：开机时长从 30 秒起算，从分区恢复的历史接在后面
+    SensorHistory restored;
+    HistoryLog restoredLog;
+    restored.begin();
+    restoredLog.begin(restored, 30);
+    result.restoredSegments = restoredLog.stats().restored;
+    result.restoreMicros = restoredLog.stats().restoreMicros;
+    // endS 正好落在 15 分钟槽边界上，原历史的分钟层没有未落盘的尾巴，两层可以逐点比较
+    result.restoredMatches = true;
+    for (uint8_t tier = 1; tier < SensorHistory::TIER_COUNT; tier++)
+    {
+        const SensorHistory::Tier t = static_cast<SensorHistory::Tier>(tier);
+        std::vector<float> a(SensorHistory::pointsOf(t));
+        std::vector<float> b(a.size());
+        for (uint8_t s = 0; s < SensorHistory::SERIES; s++)
+        {
+            history.read(t, s, a.size(), a.data());
+            restored.read(t, s, b.size(), b.data());
+            for (size_t i = 0; i < a.size(); i++)
+                result.restoredMatches = result.restoredMatches && (a[i] == b[i] || (std::isnan(a[i]) && std::isnan(b[i])));
+        }
+    }
+    uint32_t lastQuarter = 0;
+    uint32_t rebasedQuarter = 0;
+    result.rebased = history.lastClosedQuarter(lastQuarter) && restored.advance(30 + 900) &&
+                     restored.lastClosedQuarter(rebasedQuarter) && rebasedQuarter == lastQuarter + 1;
+
+    // 迷你图：第 1 套主题的环境面板
+    ThemeManager themes;
+    themes.begin();
+    for (uint8_t i = 0; i < 6 && themes.currentThemeNumber() != 1; i++)
+        themes.switchToNextTheme();
+    SparklinePlotter plotter;
+    plotter.begin();
+    EnvCharts charts;
+    constexpr int PLOT_ROUNDS = 50;
+    uint32_t start = micros();
+    for (int i = 0; i < PLOT_ROUNDS; i++)
+        plotCharts(themes, history, SensorHistory::Tier::Quarter, plotter, charts);
+    result.weekPlotMicros = (micros() - start) / PLOT_ROUNDS;
+    start = micros();
+    for (int i = 0; i < PLOT_ROUNDS; i++)
+        plotCharts(themes, history, SensorHistory::Tier::Minute, plotter, charts);
+    result.plotMicros = (micros() - start) / PLOT_ROUNDS;
+    for (uint8_t i = 0; i < EnvCharts::COUNT; i++)
+        result.widths[i] = charts.lines[i].width;
+
+    // 尖峰是 24 小时内的最高点：LTTB 选中它，温度图顶行有墨迹；等间隔抽样（每列取一点）则落不到这 3 分钟里
+    const Sparkline &temp = charts.lines[0];
+    const uint32_t spikeMinute = spikeS / 60 - firstMinute;
+    for (uint8_t c = 0; c < temp.width; c++)
+        result.peakKept = result.peakKept || (temp.columns[c] != Sparkline::EMPTY_COLUMN && Sparkline::top(temp.columns[c]) == 0);
+    result.decimationMissed = temp.width > 0;
+    for (uint8_t c = 0; c < temp.width; c++)
+    {
+        const uint32_t index = static_cast<uint32_t>(c) * points.size() / temp.width;
+        result.decimationMissed = result.decimationMissed && (index < spikeMinute || index >= spikeMinute + 3);
+    }
+
+    DashboardRenderer renderer(canvas);
+    renderer.render(themes.theme(), themes.currentThemeNumber());
+    uint64_t bytesBefore = panel.stats().bytes;
+    renderer.setCharts(charts);
+    start = micros();
+    renderer.render(themes.theme(), themes.currentThemeNumber());
+    result.renderMicros = micros() - start;
+    result.chartPixels = renderer.lastRepaintPixels();
+    result.chartBytes = panel.stats().bytes - bytesBefore;
+
+    bytesBefore = panel.stats().bytes;
+    renderer.render(themes.theme(), themes.currentThemeNumber());
+    result.unchangedBytes = panel.stats().bytes - bytesBefore;
+
+    // 过一分钟（没有新读数）：分钟层多一个缺测点，曲线左移
+    history.advance(endS + 60);
+    plotCharts(themes, history, SensorHistory::Tier::Minute, plotter, charts);
+    renderer.setCharts(charts);
+    bytesBefore = panel.stats().bytes;
+    renderer.render(themes.theme(), themes.currentThemeNumber());
+    result.tickPixels = renderer.lastRepaintPixels();
+    result.tickBytes = panel.stats().bytes - bytesBefore;
+    return result;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bool updateBaseline = false;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--update-baseline")
+            updateBaseline = true;
+        else if (arg == "--verbose")
+            verbose = true;
+        else if (arg == "--data" && i + 1 < argc)
+            SPIFFS.hostSetRoot(argv[++i]);
+    }
+    Serial.hostSetMuted(!verbose);
+
+    TftDriver display(TFT_CS, TFT_DC, TFT_RST, TFT_MOSI, TFT_SCLK);
+    FrameBuffer canvas(display);
+    ThemeManager themeManager;
+    DashboardRenderer renderer(canvas);
+    VirtualPanel panel(TFT_CS, TFT_DC, TftDriver::WIDTH, TftDriver::HEIGHT);
+    panel.attach();
+
+    display.begin();
+    canvas.begin();
+    if (!SPIFFS.begin(false))
+    {
+        fprintf(stderr, "找不到数据目录: %s\n", SPIFFS.hostRoot().c_str());
+        return 2;
+    }
+    Assets.begin(SPIFFS);
+    double loadMicros = timeMicros([&]() { themeManager.begin(); });
+
+    mkdir(SNAPSHOT_DIR, 0755);
+
+    std::vector<FrameResult> results;
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        if (i > 0)
+            loadMicros = timeMicros([&]() { themeManager.switchToNextTheme(); });
+        const std::string prefix = "theme" + std::to_string(themeManager.currentThemeNumber());
+
+        results.push_back(measureFrame(prefix + ".full", panel, [&]() {
+            renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+        }));
+        results.back().loadMicros = loadMicros;
+        results.back().repaintPixels = renderer.lastRepaintPixels();
+        panel.writePpm((std::string(SNAPSHOT_DIR) + "/" + prefix + ".ppm").c_str());
+
+        results.push_back(measureFrame(prefix + ".tick", panel, [&]() {
+            themeManager.tickMockClock();
+            renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+        }));
+        results.back().repaintPixels = renderer.lastRepaintPixels();
+        themeManager.service();
+    }
+
+    // 分钟跳变与冒号闪烁都只应贴回一个字符格
+    themeManager.tickMockClock();
+    renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const uint32_t clockTickPixels = renderer.lastRepaintPixels();
+    const uint32_t clockTickAllocations = renderer.lastAllocations();
+    themeManager.setClockColonVisible(false);
+    renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const uint32_t colonBlinkPixels = renderer.lastRepaintPixels();
+    themeManager.setClockColonVisible(true);
+    renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const uint32_t clockCellPixels = renderer.clock().cellPixels();
+    const bool clockInkOk = checkClockInk(display);
+    const bool clockOk = renderer.clock().isActive() && clockTickPixels == clockCellPixels && colonBlinkPixels == clockCellPixels &&
+                         clockInkOk;
+
+    // 预热后再轮换一整圈：主题与背景图应全部来自缓存，不再从 SPIFFS 读取，切换与渲染都不再分配堆内存
+    const uint64_t bytesReadBefore = SPIFFS.hostBytesRead();
+    const uint32_t decodesBefore = renderer.backgrounds().decodes();
+    double warmCycleMicros = 0;
+    double warmRenderMicros = 0;
+    uint32_t warmSwitchAllocations = 0;
+    uint32_t warmRenderAllocations = 0;
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        warmCycleMicros += timeMicros([&]() { themeManager.switchToNextTheme(); });
+        warmRenderMicros += timeMicros([&]() { renderer.render(themeManager.theme(), themeManager.currentThemeNumber()); });
+        warmSwitchAllocations += themeManager.lastSwitchAllocations();
+        warmRenderAllocations += renderer.lastAllocations();
+        themeManager.service();
+    }
+    const uint64_t warmBytesRead = SPIFFS.hostBytesRead() - bytesReadBefore;
+    const uint32_t warmDecodes = renderer.backgrounds().decodes() - decodesBefore;
+
+    // 连按 20 次：防抖期内不写闪存，静默后只合并成一次 NVS 写入
+    themeManager.service();
+    delay(ThemePersistence::DEBOUNCE_MS);
+    themeManager.service();
+    const uint32_t nvsWritesBefore = Preferences::hostWriteCount();
+    const uint32_t spiffsWritesBefore = SPIFFS.hostWriteOpenCount();
+    double burstMicros = 0;
+    for (uint8_t i = 0; i < 20; i++)
+    {
+        burstMicros += timeMicros([&]() { themeManager.switchToNextTheme(); });
+        themeManager.service();
+    }
+    const uint32_t burstWrites = Preferences::hostWriteCount() - nvsWritesBefore;
+    // 静默后的第一次 NVS 写入失败：待写标记保留，下一个防抖周期重试写入
+    Preferences::hostFailNextWrites(1);
+    delay(ThemePersistence::DEBOUNCE_MS);
+    themeManager.service();
+    const bool failedStillPending = themeManager.persistence().pending();
+    delay(ThemePersistence::DEBOUNCE_MS);
+    themeManager.service();
+    const bool writeRetried = failedStillPending && !themeManager.persistence().pending();
+    const uint32_t settledWrites = Preferences::hostWriteCount() - nvsWritesBefore;
+    const uint32_t spiffsWrites = SPIFFS.hostWriteOpenCount() - spiffsWritesBefore;
+
+    // 模拟重启：新的 ThemeManager 应从 NVS 恢复到连按后的主题
+    ThemeManager rebooted;
+    rebooted.begin();
+    const bool restored = rebooted.currentThemeNumber() == themeManager.currentThemeNumber();
+
+    // 热重载：改当前主题的一个面板颜色与一段文本位置（并删掉 .thm，回退到 JSON），文件监视应察觉变化，
+    // 增量重画只覆盖差异区域，且画面与整屏重画一致；随后恢复原文件。
+    // 先走一次时钟，使显示的时间来自时钟而不是主题文件里的占位值（重载后保留时钟，不算差异）
+    themeManager.tickMockClock();
+    renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const std::string jsonPath = themeManager.activeThemePath().c_str();
+    const std::string thmPath = jsonPath.substr(0, jsonPath.size() - 5) + ".thm";
+    const std::string originalJson = readDataFile(jsonPath);
+    const bool hasThm = SPIFFS.exists(thmPath.c_str());
+    const std::string originalThm = hasThm ? readDataFile(thmPath) : std::string();
+    const bool watchQuietBefore = !themeManager.filesChanged();
+    std::string editedJson = originalJson;
+    const bool edited =
+        editJsonValue(editedJson, {"modules", "alarm", "color"},
+                      [](const std::string &old) { return std::string(old == "\"#7A2E2E\"" ? "\"#2E7A2E\"" : "\"#7A2E2E\""); }) &&
+        editJsonValue(editedJson, {"text", "date", "y"}, [](const std::string &old) { return std::to_string(std::stoi(old) + 6); });
+    writeDataFile(jsonPath, editedJson);
+    if (hasThm)
+        SPIFFS.remove(thmPath.c_str());
+    const bool watchFired = themeManager.filesChanged();
+    const bool reloaded = themeManager.reloadActiveTheme();
+    const ThemeDiff reloadDiff = themeManager.lastReloadDiff();
+    renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const uint32_t reloadPixels = renderer.lastRepaintPixels();
+    const uint32_t reloadRenderChanges = renderer.lastDiff().changes();
+    const uint32_t incrementalChecksum = panel.checksum();
+    const bool watchQuietAfter = !themeManager.filesChanged();
+    renderer.invalidate();
+    renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const bool reloadMatchesFull = panel.checksum() == incrementalChecksum;
+    // .thm 最后写回，修改时间不早于 JSON，恢复后仍按二进制主题加载
+    writeDataFile(jsonPath, originalJson);
+    if (hasThm)
+        writeDataFile(thmPath, originalThm);
+    const bool restoreFired = themeManager.filesChanged();
+    themeManager.reloadActiveTheme();
+    const uint8_t restoreChanges = themeManager.lastReloadDiff().changes();
+    renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const bool hotReloadOk = edited && watchQuietBefore && watchFired && reloaded && watchQuietAfter && restoreFired &&
+                             reloadDiff.changes() == 2 && reloadDiff.restyledModules == 1 << ThemeDiff::ALARM_MODULE &&
+                             reloadDiff.movedTexts == 1 << ThemeDiff::DATE_TEXT && reloadRenderChanges == 2 && restoreChanges == 2;
+
+    // 渲染流水线：主线程只投递快照，渲染在独立线程（设备上为另一个核）完成。
+    // 连续投递远快于渲染，中间帧被合并；最终画面应与同步整屏渲染一致
+    RenderPipeline pipeline(renderer);
+    const bool pipelineStarted = pipeline.begin();
+    const uint32_t pipelineFrames = 120;
+    double maxSubmitMicros = 0;
+    for (uint32_t i = 0; i < pipelineFrames; i++)
+    {
+        if (i % 20 == 0)
+            themeManager.switchToNextTheme();
+        else
+            themeManager.tickMockClock();
+        maxSubmitMicros = std::max(maxSubmitMicros, timeMicros([&]() {
+                                       pipeline.submit(themeManager.theme(), themeManager.currentThemeNumber(), micros(), i == 0);
+                                   }));
+        themeManager.service();
+    }
+    while (!pipeline.idle())
+    {
+        pipeline.service();
+        vTaskDelay(1);
+    }
+    pipeline.end();
+    const RenderPipeline::Stats pipelineStats = pipeline.stats();
+    const uint32_t pipelinedChecksum = panel.checksum();
+    renderer.invalidate();
+    renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const bool pipelineOk = pipelineStarted && panel.checksum() == pipelinedChecksum &&
+                            pipelineStats.rendered + pipelineStats.merged + pipelineStats.dropped == pipelineStats.submitted;
+
+    // 过渡动画：三种效果各播一次，结束后屏幕应与整屏重推的新画面完全一致
+    const ThemeTransition::Effect effects[] = {ThemeTransition::Effect::Crossfade, ThemeTransition::Effect::Slide,
+                                               ThemeTransition::Effect::Wipe};
+    std::vector<ThemeTransition::Stats> transitionStats;
+    bool transitionsOk = true;
+    for (ThemeTransition::Effect effect : effects)
+    {
+        themeManager.switchToNextTheme();
+        renderer.renderTransition(themeManager.theme(), themeManager.currentThemeNumber(), effect);
+        const uint32_t transitionChecksum = panel.checksum();
+        transitionStats.push_back(renderer.transition().lastStats());
+        canvas.invalidateAll();
+        renderer.invalidate();
+        renderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+        transitionsOk = transitionsOk && transitionStats.back().pacing.frames > 1 && panel.checksum() == transitionChecksum;
+    }
+
+    // 性能剖析：导出环形缓冲中最近的记录，并测量单个区段的记录开销（环形缓冲随后清空，不影响导出）
+    const std::string tracePath = std::string(SNAPSHOT_DIR) + "/trace.json";
+    FilePrint trace(tracePath);
+    Profiler::dumpChromeTrace(trace);
+    const bool traceOk = !Profiler::enabled() ||
+                         (trace.isOpen() && trace.text().find("\"name\":\"render\"") != std::string::npos &&
+                          trace.text().find("\"name\":\"spi_bytes\"") != std::string::npos &&
+                          trace.text().find("\"name\":\"loadTheme\"") != std::string::npos &&
+                          trace.text().compare(trace.text().size() - 3, 3, "}}\n") == 0);
+    const uint32_t zoneRounds = 100000;
+    const double zoneMicros = timeMicros([&]() {
+        for (uint32_t i = 0; i < zoneRounds; i++)
+        {
+            PROFILE_ZONE("bench");
+        }
+    });
+    Profiler::clear();
+
+    // 相隔超过 2^31 个周期（240 MHz 下约 9 秒）的两条记录：导出的时间戳仍应按实际间隔递增
+    uint64_t traceGapMicros = 0;
+    if (Profiler::enabled())
+    {
+        PROFILE_COUNTER("gap_start", 0);
+        delay(10000);
+        {
+            PROFILE_ZONE("gap_end");
+        }
+        FilePrint gapTrace(std::string(SNAPSHOT_DIR) + "/trace_gap.json");
+        Profiler::dumpChromeTrace(gapTrace);
+        Profiler::clear();
+        const size_t at = gapTrace.text().find("\"name\":\"gap_end\"");
+        const size_t ts = at == std::string::npos ? at : gapTrace.text().find("\"ts\":", at);
+        if (ts != std::string::npos)
+            traceGapMicros = strtoull(gapTrace.text().c_str() + ts + 5, nullptr, 10);
+    }
+    const bool traceGapOk = !Profiler::enabled() || (traceGapMicros >= 10000000 && traceGapMicros < 11000000);
+
+    // 图标图集：按代码查找与 alpha 混合绘制的单次耗时（在所有帧测量之后进行，不影响快照）
+    const IconAtlas &icons = renderer.icons();
+    const uint16_t iconCodes[] = {100, 101, 104, 305, 400, 501, 999, 2075};
+    const uint32_t lookupRounds = 100000;
+    uintptr_t lookupSink = 0;
+    double lookupMicros = timeMicros([&]() {
+        for (uint32_t i = 0; i < lookupRounds; i++)
+            lookupSink += reinterpret_cast<uintptr_t>(icons.find(iconCodes[i & 7], i & 8));
+    });
+    const uint32_t blitRounds = 10000;
+    const uint8_t *sunIcon = icons.find(100);
+    double blitMicros = timeMicros([&]() {
+        for (uint32_t i = 0; i < blitRounds && sunIcon; i++)
+            canvas.drawAlphaMask(i % 200, (i / 200) % 280, icons.cellSize(), icons.cellSize(), sunIcon, 0xFFFF, 0x2104);
+    });
+    const bool iconsOk = icons.isLoaded() && sunIcon && lookupSink && !icons.find(1) && !icons.find(65535);
+
+    // 抗锯齿字体：只有 tools/build_fonts.py 生成了字体包时才测（源字体不随仓库分发）
+    const bool glyphCacheOk = checkGlyphCacheLru();
+    uint32_t missingFontReopens = 0;
+    const bool fontLoaderOk = checkFontLoader(canvas, panel, missingFontReopens);
+    const char *FONT_NAME = "sans_16";
+    const bool hasFontPack = SPIFFS.exists(String("/fonts/") + FONT_NAME + ".fnt");
+    TextRenderer text;
+    text.begin(Assets);
+    const char *sample = "14:30 \xE6\x99\xB4 26\xE2\x84\x83 \xE6\xB9\xBF\xE5\xBA\xA6 45% Alarm";
+    const uint32_t textRounds = 2000;
+    double textMicros = 0;
+    uint32_t textGlyphs = 0;
+    bool fontOk = true;
+    if (hasFontPack)
+    {
+        fontOk = text.drawText(canvas, 10, 10, sample, FONT_NAME, 0xFFFF, 0x0000) && text.textWidth(sample, FONT_NAME) > 0;
+        const uint32_t glyphsBefore = text.glyphsDrawn();
+        textMicros = timeMicros([&]() {
+            for (uint32_t i = 0; i < textRounds; i++)
+                text.drawText(canvas, i % 40, (i / 40) % 280, sample, FONT_NAME, 0xFFFF, 0x0000);
+        });
+        textGlyphs = text.glyphsDrawn() - glyphsBefore;
+    }
+
+    // 资源归档：tools/pack_assets.py 生成的 fsimage/assets.pak 与散装文件逐字节一致，且只靠归档就能渲染出相同的 6 套主题
+    fs::FS packedFs;
+    packedFs.hostSetRoot("fsimage");
+    AssetStore packedStore;
+    const bool hasArchive = packedFs.begin(false) && packedStore.begin(packedFs);
+    ArchiveResult archive;
+    uint32_t archiveFrames = 0;
+    uint32_t archiveFrameMismatches = 0;
+    uint32_t archiveLooseOpens = 0;
+    bool archiveReloadOk = true;
+    if (hasArchive)
+    {
+        archive = checkAssetArchive(packedStore);
+
+        // 临时把全局资源入口切到只含归档的文件系统；归档句柄随渲染器一起在块内释放
+        Assets.begin(packedFs);
+        const uint32_t looseOpensBefore = Assets.stats().looseOpens;
+        {
+            ThemeManager packedThemes;
+            DashboardRenderer packedRenderer(canvas);
+            packedThemes.begin();
+            for (uint8_t i = 0; i < 6; i++, archiveFrames++)
+            {
+                if (i > 0)
+                    packedThemes.switchToNextTheme();
+                packedRenderer.render(packedThemes.theme(), packedThemes.currentThemeNumber());
+                const std::string name = "theme" + std::to_string(packedThemes.currentThemeNumber()) + ".full";
+                auto it = std::find_if(results.begin(), results.end(), [&](const FrameResult &r) { return r.name == name; });
+                if (it == results.end() || it->checksum != panel.checksum())
+                    archiveFrameMismatches++;
+            }
+            archiveLooseOpens = Assets.stats().looseOpens - looseOpensBefore;
+
+            // 归档挂载时热重载：上传一个比归档新的 JSON，它应覆盖归档里的 JSON 与 .thm 并被文件监视察觉；删掉后回到归档版本
+            const std::string packedJson = packedThemes.activeThemePath().c_str();
+            std::string editedPacked = readDataFile(packedJson);
+            const bool packedEdited = editJsonValue(editedPacked, {"modules", "alarm", "color"}, [](const std::string &old) {
+                return std::string(old == "\"#7A2E2E\"" ? "\"#2E7A2E\"" : "\"#7A2E2E\"");
+            }) && editJsonValue(editedPacked, {"text", "date", "y"}, [](const std::string &old) { return std::to_string(std::stoi(old) + 6); });
+            const bool packedQuietBefore = !packedThemes.filesChanged();
+            File upload = packedFs.open(packedJson.c_str(), FILE_WRITE);
+            upload.write(reinterpret_cast<const uint8_t *>(editedPacked.data()), editedPacked.size());
+            upload.close();
+            const bool packedFired = packedThemes.filesChanged();
+            const bool packedReloaded = packedThemes.reloadActiveTheme();
+            const uint8_t packedChanges = packedThemes.lastReloadDiff().changes();
+            const bool packedOverridden = Assets.overrideCount() == 1;
+            const bool packedQuietAfter = !packedThemes.filesChanged();
+            packedFs.remove(packedJson.c_str());
+            const bool packedRestoreFired = packedThemes.filesChanged();
+            packedThemes.reloadActiveTheme();
+            archiveReloadOk = packedEdited && packedQuietBefore && packedFired && packedReloaded && packedChanges == 2 &&
+                              packedOverridden && packedQuietAfter && packedRestoreFired &&
+                              packedThemes.lastReloadDiff().changes() == 2 && Assets.overrideCount() == 0;
+        }
+        Assets.begin(SPIFFS);
+    }
+
+    // 开机快照：保存当前画面，模拟重启（新画布、新快照对象，屏幕先被清掉），快照应在唤醒前写进显存，
+    // 随后第一帧实时渲染只推送与快照不同的区域，结果与整屏重画一致
+    hostPartitionReset();
+    BootSnapshot emptySnapshot;
+    const bool emptyRejected = !emptySnapshot.begin() && !emptySnapshot.show(canvas);
+    FrameBuffer liveCanvas(display);
+    liveCanvas.begin();
+    DashboardRenderer liveRenderer(liveCanvas);
+    liveRenderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const uint32_t savedChecksum = panel.checksum();
+    BootSnapshot snapshot;
+    snapshot.begin();
+    const bool snapshotSaved = snapshot.save(liveCanvas, themeManager.currentThemeNumber());
+    const uint64_t erasedAfterSave = hostPartitionErasedBytes();
+    const bool unchangedSkipped = snapshot.save(liveCanvas, themeManager.currentThemeNumber()) &&
+                                  snapshot.stats().unchanged == 1 && hostPartitionErasedBytes() == erasedAfterSave;
+
+    display.fillScreen(0x0000);
+    FrameBuffer bootCanvas(display);
+    bootCanvas.begin();
+    BootSnapshot bootSnapshot;
+    panel.resetStats();
+    const uint32_t bootStart = micros();
+    display.beginAsleep();
+    const bool snapshotShown = bootSnapshot.begin() && bootSnapshot.show(bootCanvas);
+    display.wake();
+    // 主机 delay() 只推进虚拟时间，SPI 传输不耗时：按 40 MHz 补上推送快照的传输时间
+    const uint64_t bootSpiBytes = panel.stats().bytes;
+    const double firstPixelMs = (micros() - bootStart) / 1000.0 + bootSpiBytes * 8 / 40000.0;
+    const bool snapshotMatches = panel.checksum() == savedChecksum;
+
+    themeManager.tickMockClock();
+    DashboardRenderer bootRenderer(bootCanvas);
+    panel.resetStats();
+    bootRenderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const uint64_t reconcileBytes = panel.stats().bytes;
+    const uint32_t reconciledChecksum = panel.checksum();
+    liveCanvas.invalidateAll();
+    panel.resetStats();
+    liveRenderer.render(themeManager.theme(), themeManager.currentThemeNumber());
+    const uint64_t fullFrameBytes = panel.stats().bytes;
+    const bool reconcileMatches = reconciledChecksum == panel.checksum();
+
+    // 载荷被位翻转时整份快照作废，不会把花屏推上去
+    uint8_t corruptByte = 0;
+    uint32_t corruptAt = 64;
+    const esp_partition_t *snapshotPartition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, BootSnapshot::PARTITION_SUBTYPE, "snapshot");
+    while (esp_partition_read(snapshotPartition, corruptAt, &corruptByte, 1) == ESP_OK && corruptByte == 0)
+        corruptAt++;
+    corruptByte &= corruptByte - 1;
+    esp_partition_write(snapshotPartition, corruptAt, &corruptByte, 1);
+    BootSnapshot corruptSnapshot;
+    const bool corruptRejected = !corruptSnapshot.begin();
+    // 面板特化：两种驱动各自按初始化表一条命令一次片选，画同一组图元得到相同的图像
+    const PanelVariantResult st7789 = drawPanelVariant<St7789Panel>(panel);
+    const PanelVariantResult ili9341 = drawPanelVariant<Ili9341Panel>(panel);
+    const bool panelsOk = st7789.initTransactions == PanelDriver<St7789Panel>::INIT_COMMANDS + 1 &&
+                          ili9341.initTransactions == PanelDriver<Ili9341Panel>::INIT_COMMANDS + 1 &&
+                          st7789.initCommands == st7789.initTransactions && ili9341.initCommands == ili9341.initTransactions &&
+                          st7789.checksum == ili9341.checksum && st7789.bytes == ili9341.bytes;
+
+    // 传感器采集：噪声与尖峰只在原始读数里，界面只在四舍五入后的显示值变化时重画
+    const SensorReplay sensors = replaySensorTrace(canvas, panel);
+    const std::string expectedTexts[3] = {"TEMP " + std::to_string(sensors.finalRounded[0]) + "C",
+                                          "HUM " + std::to_string(sensors.finalRounded[1]) + "%",
+                                          "PRES " + std::to_string(sensors.finalRounded[2])};
+    const bool sensorsOk = !sensors.loaded ||
+                           (sensors.hub.failures == 2 && sensors.hub.dropped == 0 && sensors.quietBytes == 0 &&
+                            sensors.redraws > 0 && sensors.redraws * 4 <= sensors.rawChanges && sensors.filteredTemp[0] > 24.8f &&
+                            sensors.filteredTemp[1] < 27.2f && sensors.maxRedrawPixels * 20 < TftDriver::WIDTH * TftDriver::HEIGHT &&
+                            sensors.texts[0] == expectedTexts[0] && sensors.texts[1] == expectedTexts[1] &&
+                            sensors.texts[2] == expectedTexts[2] && sensors.keptAfterSwitch);
+
+    // 环境历史：分钟层误差、缺测、落盘恢复与迷你图
+    const HistoryCheck history = checkSensorHistory(canvas, panel);
+    const uint32_t expectedSegments = HISTORY_DAYS * 96 - 4;
+    const bool historyOk = history.maxError[0] <= 0.051f && history.maxError[1] <= 0.101f && history.maxError[2] <= 0.101f &&
+                           history.outageGaps == 60 && history.segments == expectedSegments && history.restoredMatches &&
+                           history.rebased && history.restoredSegments < expectedSegments && history.restoredSegments >= 7 * 96 &&
+                           history.peakKept && history.unchangedBytes == 0 && history.chartBytes > 0 &&
+                           history.tickPixels * 20 < TftDriver::WIDTH * TftDriver::HEIGHT;
+
+    const bool snapshotOk = emptyRejected && snapshotSaved && unchangedSkipped && snapshotShown && snapshotMatches &&
+                            reconcileMatches && reconcileBytes < fullFrameBytes && corruptRejected;
+
+    // load_us 为该帧之前加载/切换主题的耗时（仅整帧有值），repaint_px 为场景局部重画的像素数
+    printf("%-14s %10s %10s %8s %10s %10s %10s %10s\n", "frame", "checksum", "spi_bytes", "cs_txn", "commands", "host_us", "load_us",
+           "repaint_px");
+    for (const FrameResult &r : results)
+    {
+        printf("%-14s   %08x %10llu %8u %10u %10.1f %10.1f %10u\n", r.name.c_str(), r.checksum,
+               static_cast<unsigned long long>(r.stats.bytes), r.stats.transactions, r.stats.commands, r.hostMicros, r.loadMicros,
+               r.repaintPixels);
+    }
+
+    printf("预热后轮换 6 次: 平均切换 %.1f us, 平均整帧 %.1f us, SPIFFS 读取 %llu 字节, 背景重新解码 %u 次\n", warmCycleMicros / 6,
+           warmRenderMicros / 6, static_cast<unsigned long long>(warmBytesRead), warmDecodes);
+    if (AllocCounter::enabled())
+        printf("堆分配: 预热后切换 %u 次, 整帧渲染 %u 次, 时钟跳变渲染 %u 次\n", warmSwitchAllocations, warmRenderAllocations,
+               clockTickAllocations);
+    const BackgroundCache &backgrounds = renderer.backgrounds();
+    printf("背景图: 解码 %u 次 (最近一次 %u us), 命中 %u 次, 解码峰值工作内存 %u 字节, PSRAM 缓存 %u 字节\n", backgrounds.decodes(),
+           backgrounds.lastDecodeMicros(), backgrounds.hits(), static_cast<unsigned>(backgrounds.peakWorkingBytes()),
+           static_cast<unsigned>(backgrounds.cachedBytes()));
+    printf("连按切换 20 次: 平均 %.1f us, 防抖期内写入 %u 次, 静默后写入 %u 次 (%u us), SPIFFS 写入 %u 次, 写入失败后%s, 重启恢复%s\n",
+           burstMicros / 20, burstWrites, settledWrites, themeManager.persistence().lastFlushMicros(), spiffsWrites,
+           writeRetried ? "已重试" : "未重试", restored ? "正确" : "错误");
+    printf("热重载: 文件监视%s, 差异 %u 项 (面板换色 %02X, 文本移动 %02X), 重画 %u 像素 (整屏的 %.1f%%), 与整屏重画%s, 恢复后差异 %u 项\n",
+           watchFired ? "已察觉" : "未察觉", reloadDiff.changes(), reloadDiff.restyledModules, reloadDiff.movedTexts, reloadPixels,
+           reloadPixels * 100.0 / (TftDriver::WIDTH * TftDriver::HEIGHT), reloadMatchesFull ? "一致" : "不一致", restoreChanges);
+    printf("渲染流水线: 投递 %u 帧 (单次最长 %.1f us), 渲染 %u, 合并 %u, 丢弃 %u, 队列峰值 %u/%u, 输入到上屏 平均 %u us / 最大 %u us\n",
+           pipelineStats.submitted, maxSubmitMicros, pipelineStats.rendered, pipelineStats.merged, pipelineStats.dropped,
+           pipelineStats.maxQueueDepth, static_cast<unsigned>(RenderPipeline::QUEUE_DEPTH), pipelineStats.avgLatencyMicros,
+           pipelineStats.maxLatencyMicros);
+    for (const ThemeTransition::Stats &t : transitionStats)
+    {
+        printf("过渡 %s: %u 帧, %u.%u fps (目标 %u), 掉帧 %u, 超预算 %u, 每帧 混合 %u us / SPI %u us / %u 字节, 合成 %u us\n",
+               ThemeTransition::effectName(t.effect), t.pacing.frames, t.pacing.fpsX10 / 10, t.pacing.fpsX10 % 10,
+               ThemeTransition::TARGET_FPS, t.pacing.dropped, t.pacing.overBudget, t.blendMicros, t.spiMicros,
+               t.spiBytes / std::max<uint32_t>(t.pacing.frames, 1), t.composeMicros);
+    }
+    printf("性能剖析%s: 追踪 %u 字节写入 %s, 记录一个区段 %.1f ns, 相隔 10 s 的记录导出间隔 %.3f s\n",
+           Profiler::enabled() ? "" : "(未编入)", static_cast<unsigned>(trace.text().size()), tracePath.c_str(),
+           zoneMicros * 1000 / zoneRounds, traceGapMicros / 1e6);
+    printf("图标图集: %u 个 %ux%u 图标, 常驻 %u 字节, 查找 %.1f ns/次, 绘制 %.2f us/个\n", icons.iconCount(), icons.cellSize(),
+           icons.cellSize(), static_cast<unsigned>(icons.memoryBytes()), lookupMicros * 1000 / lookupRounds, blitMicros / blitRounds);
+
+    printf("字体加载器: bench_12 %s, 缺失字体回退 %s (重复访问文件系统 %u 次)\n", fontLoaderOk ? "正常" : "异常",
+           missingFontReopens == 0 ? "已缓存" : "未缓存", missingFontReopens);
+    if (hasFontPack)
+    {
+        const GlyphCache &glyphs = text.cache();
+        const uint32_t lookups = glyphs.hits() + glyphs.misses();
+        printf("字体 %s: 索引 %u 字节, 字形缓存 %u 槽位, 命中率 %.1f%% (%u/%u), 淘汰 %u 次, 绘制 %.2f us/字形\n", FONT_NAME,
+               static_cast<unsigned>(text.indexBytes()), glyphs.capacity(), lookups ? 100.0 * glyphs.hits() / lookups : 0.0,
+               glyphs.hits(), lookups, glyphs.evictions(), textGlyphs ? textMicros / textGlyphs : 0.0);
+    }
+    else
+    {
+        printf("字体: 未找到 /fonts/%s.fnt，跳过（见 fonts/fonts.json）\n", FONT_NAME);
+    }
+
+    if (hasArchive)
+    {
+        const AssetStore::Stats packedStats = packedStore.stats();
+        printf("资源归档: %u 个条目 (压缩 %u 个), 平均探测 %.2f 槽, 单文件读取 散装 %.1f us / 归档 %.1f us, 内容不一致 %u 个, "
+               "仅用归档渲染 %u 套主题 与整帧%s, 回退散装 %u 次, 归档读取 %u 次, 上传 JSON 热重载%s\n",
+               archive.files, archive.compressed, archive.avgProbes, archive.looseMicros, archive.archiveMicros, archive.mismatches,
+               archiveFrames, archiveFrameMismatches ? "不一致" : "一致", archiveLooseOpens + archive.looseOpens,
+               packedStats.archiveReads, archiveReloadOk ? "生效" : "失败");
+    }
+    else
+    {
+        printf("资源归档: 未找到 fsimage/assets.pak，跳过（见 tools/pack_assets.py）\n");
+    }
+
+    const BootSnapshot::Stats snapshotStats = snapshot.stats();
+    printf("开机快照: %u 字节 (原始的 %.1f%%), 保存 %u us, 擦除 %u 字节, 内容未变跳过擦写%s; 重启后快照上屏%s, 首像素 %.1f ms "
+           "(复位与唤醒等待 + 解码 %u us + SPI %llu 字节), 第一帧实时画面推送 %llu 字节 (整屏 %llu), 与整屏重画%s, 损坏快照%s\n",
+           snapshotStats.lastSaveBytes, snapshotStats.lastSaveBytes * 100.0 / (TftDriver::WIDTH * TftDriver::HEIGHT * 2),
+           snapshotStats.lastSaveMicros, snapshotStats.erasedBytes, unchangedSkipped ? "" : "失败", snapshotMatches ? "一致" : "不一致",
+           firstPixelMs, bootSnapshot.stats().showMicros, static_cast<unsigned long long>(bootSpiBytes),
+           static_cast<unsigned long long>(reconcileBytes), static_cast<unsigned long long>(fullFrameBytes),
+           reconcileMatches ? "一致" : "不一致", corruptRejected ? "已拒绝" : "未拒绝");
+
+    printf("面板驱动: ST7789 初始化 %u 条命令 / %u 次片选, ILI9341 %u 条命令 / %u 次片选, 同一组图元两者图像%s (%llu / %llu 字节)\n",
+           st7789.initCommands, st7789.initTransactions, ili9341.initCommands, ili9341.initTransactions,
+           st7789.checksum == ili9341.checksum ? "一致" : "不一致", static_cast<unsigned long long>(st7789.bytes),
+           static_cast<unsigned long long>(ili9341.bytes));
+
+    if (sensors.loaded)
+    {
+        printf("传感器(回放 %s): 读取 %u 次 (失败 %u), 样本 %u, 队列峰值 %u/%u; 原始读数直接上屏会换数 %u 次, 滤波与回差后重画 %u 次 "
+               "(共 %llu 字节, 单次最多 %u 像素), 其余 %u 轮 SPI %llu 字节; 温度 原始 %.2f~%.2f / 滤波后 %.2f~%.2f, 显示 %s | %s | %s, "
+               "切换主题后%s\n",
+               SENSOR_TRACE_PATH, sensors.hub.reads, sensors.hub.failures, sensors.samples, sensors.hub.maxQueueDepth,
+               static_cast<unsigned>(SensorHub::QUEUE_DEPTH), sensors.rawChanges, sensors.redraws,
+               static_cast<unsigned long long>(sensors.redrawBytes), sensors.maxRedrawPixels, sensors.quietRenders,
+               static_cast<unsigned long long>(sensors.quietBytes), sensors.rawTemp[0], sensors.rawTemp[1], sensors.filteredTemp[0],
+               sensors.filteredTemp[1], sensors.texts[0].c_str(), sensors.texts[1].c_str(), sensors.texts[2].c_str(),
+               sensors.keptAfterSwitch ? "沿用读数" : "回到占位值");
+    }
+    else
+    {
+        printf("传感器: 未找到 %s，跳过\n", SENSOR_TRACE_PATH);
+    }
+
+    printf("环境历史: 环形缓冲 %u 字节 (三量 x 1 小时原始 / 24 小时分钟 / 7 天 15 分钟), 分钟层每量每天 %u 字节; 合成 %u 天读数耗时 %u us, "
+           "分钟层最大误差 %.3f / %.3f / %.3f, 中断 1 小时缺测 %u 点\n",
+           static_cast<unsigned>(history.memoryBytes), history.minuteBytesPerDay, HISTORY_DAYS, history.simulateMicros,
+           history.maxError[0], history.maxError[1], history.maxError[2], history.outageGaps);
+    printf("  落盘: %u 段 x %u 字节 (每天 %u 字节), 分区循环覆盖擦除 %u 字节; 重启恢复 %u 段 / %u us, 分钟层与 15 分钟层%s, 时钟%s\n",
+           history.segments, static_cast<unsigned>(HistoryLog::segmentBytes()), HistoryLog::bytesPerDay(), history.erasedBytes,
+           history.restoredSegments, history.restoreMicros, history.restoredMatches ? "逐点一致" : "不一致",
+           history.rebased ? "已平移接续" : "未接续");
+    printf("  迷你图: 宽 %u / %u / %u 列, 24 小时降采样 %u us, 7 天 %u us; LTTB %s尖峰 (等间隔抽样%s); 首次上屏 %u us 重画 %u 像素 "
+           "SPI %llu 字节, 不变时 %llu 字节, 一分钟后重画 %u 像素 / %llu 字节\n",
+           history.widths[0], history.widths[1], history.widths[2], history.plotMicros, history.weekPlotMicros,
+           history.peakKept ? "保留" : "丢失", history.decimationMissed ? "漏掉" : "也取到", history.renderMicros,
+           history.chartPixels, static_cast<unsigned long long>(history.chartBytes),
+           static_cast<unsigned long long>(history.unchangedBytes), history.tickPixels,
+           static_cast<unsigned long long>(history.tickBytes));
+
+    Scheduler::Stats schedulerStats;
+    const bool schedulerOk = checkScheduler(schedulerStats);
+    printf("调度器(虚拟时钟 5 s): 定时器触发 %u 次, 事件 %u 个 (丢弃 %u), 抖动 最大 %u us, 空闲 %u%%\n", schedulerStats.timersFired,
+           schedulerStats.eventsDispatched, schedulerStats.eventsDropped, schedulerStats.maxJitterMicros, schedulerStats.idlePercent);
+
+    printf("时钟组件: 分钟跳变重画 %u 像素, 冒号闪烁重画 %u 像素 (每格 %ux%u), 与面板同色的数字%s\n", clockTickPixels,
+           colonBlinkPixels, renderer.clock().cellWidth(), renderer.clock().cellHeight(), clockInkOk ? "照常显示" : "丢失");
+
+    ButtonGestures::Stats buttonStats;
+    const bool buttonsOk = checkButtonGestures(buttonStats);
+    printf("按键手势(合成边沿): 边沿 %u 个, 滤除抖动 %u, 识别手势 %u 次, 刷屏积压时确认到处理延迟 最大 %u us\n", buttonStats.edges,
+           buttonStats.bounces, buttonStats.gestures, buttonStats.maxLatencyMicros);
+
+    const uint32_t blendMismatches = checkBlendKernels();
+    printf("混合内核: 与参考实现不一致 %u 处, 吞吐:\n", blendMismatches);
+    benchBlendKernels();
+
+    std::map<std::string, Baseline> baseline = loadBaseline(BASELINE_PATH);
+    if (updateBaseline || baseline.empty())
+    {
+        if (!saveBaseline(BASELINE_PATH, results))
+        {
+            fprintf(stderr, "写入基线失败: %s\n", BASELINE_PATH);
+            return 2;
+        }
+        printf("基线已写入 %s\n", BASELINE_PATH);
+        return 0;
+    }
+
+    int failures = 0;
+    if (blendMismatches)
+    {
+        printf("[失败] 混合内核结果与参考实现不一致\n");
+        failures++;
+    }
+    if (!schedulerOk)
+    {
+        printf("[失败] 调度器定时器触发时刻、事件顺序或空闲统计不符合预期\n");
+        failures++;
+    }
+    if (!clockOk)
+    {
+        printf("[失败] 时钟组件未接管时间文本，或分钟跳变/冒号闪烁没有只重画一个字符格，或与面板同色的数字丢失\n");
+        failures++;
+    }
+    if (!buttonsOk)
+    {
+        printf("[失败] 按键状态机对合成边沿序列识别出的手势、时刻或抖动统计不符合预期\n");
+        failures++;
+    }
+    if (!traceOk || !traceGapOk)
+    {
+        printf("[失败] 性能追踪导出缺少渲染区段、SPI 计数器、格式不完整或长间隔时间戳错误\n");
+        failures++;
+    }
+    if (!transitionsOk)
+    {
+        printf("[失败] 过渡动画未播放，或结束后的屏幕与新主题整屏渲染不一致\n");
+        failures++;
+    }
+    if (!pipelineOk)
+    {
+        printf("[失败] 渲染流水线未启动、帧计数不守恒或最终画面与同步渲染不一致\n");
+        failures++;
+    }
+    if (!glyphCacheOk || !fontOk || !fontLoaderOk)
+    {
+        printf("[失败] 字形缓存淘汰顺序错误或字体包渲染失败\n");
+        failures++;
+    }
+    if (!iconsOk)
+    {
+        printf("[失败] 图标图集未加载或查找结果错误\n");
+        failures++;
+    }
+    if (warmBytesRead > 0)
+    {
+        printf("[失败] 预热后切换主题仍读取了 SPIFFS\n");
+        failures++;
+    }
+    if (warmDecodes > 0)
+    {
+        printf("[失败] 预热后背景图仍被重新解码\n");
+        failures++;
+    }
+    if (warmSwitchAllocations > 0 || warmRenderAllocations > 0 || clockTickAllocations > 0)
+    {
+        printf("[失败] 稳态下仍有堆分配: 切换 %u 次, 渲染 %u 次, 时钟跳变 %u 次\n", warmSwitchAllocations, warmRenderAllocations,
+               clockTickAllocations);
+        failures++;
+    }
+    if (burstWrites > 0 || settledWrites > 1 || spiffsWrites > 0)
+    {
+        printf("[失败] 连按切换未合并写入: 防抖期内 %u 次, 共 %u 次, SPIFFS %u 次\n", burstWrites, settledWrites, spiffsWrites);
+        failures++;
+    }
+    if (!writeRetried)
+    {
+        printf("[失败] 主题写入 NVS 失败后待写标记丢失，防抖周期到期未重试\n");
+        failures++;
+    }
+    if (!restored)
+    {
+        printf("[失败] 重启后未恢复当前主题\n");
+        failures++;
+    }
+    if (!hotReloadOk || !reloadMatchesFull)
+    {
+        printf("[失败] 热重载的文件监视、差异或增量重画不正确\n");
+        failures++;
+    }
+    // 只改一个面板颜色与一行文本位置，增量重画应明显小于整屏
+    if (reloadPixels * 2 > static_cast<uint32_t>(TftDriver::WIDTH) * TftDriver::HEIGHT)
+    {
+        printf("[失败] 热重载重画 %u 像素, 超过整屏的一半\n", reloadPixels);
+        failures++;
+    }
+    // 每分钟一次的时钟更新只应重画时间文本，须低于整屏的 5%
+    const uint32_t tickPixelLimit = static_cast<uint32_t>(TftDriver::WIDTH) * TftDriver::HEIGHT / 20;
+    for (const FrameResult &r : results)
+    {
+        if (r.name.size() > 5 && r.name.compare(r.name.size() - 5, 5, ".tick") == 0 && r.repaintPixels >= tickPixelLimit)
+        {
+            printf("[失败] %s 局部重画 %u 像素，未低于整屏 5%% (%u)\n", r.name.c_str(), r.repaintPixels, tickPixelLimit);
+            failures++;
+        }
+    }
+    for (const FrameResult &r : results)
+    {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end())
+        {
+            printf("[新增] %s 不在基线中\n", r.name.c_str());
+            continue;
+        }
+        const Baseline &b = it->second;
+        if (r.checksum != b.checksum)
+        {
+            printf("[失败] %s 图像与黄金图不一致: %08x != %08x\n", r.name.c_str(), r.checksum, b.checksum);
+            failures++;
+        }
+        if (r.stats.transactions > b.transactions)
+        {
+            printf("[失败] %s 事务数回归: %u > %u\n", r.name.c_str(), r.stats.transactions, b.transactions);
+            failures++;
+        }
+        if (r.stats.bytes > b.bytes)
+        {
+            printf("[失败] %s SPI 字节数回归: %llu > %llu\n", r.name.c_str(),
+                   static_cast<unsigned long long>(r.stats.bytes), static_cast<unsigned long long>(b.bytes));
+            failures++;
+        }
+    }
+
+    if (!panelsOk)
+    {
+        printf("[失败] 面板驱动: 初始化片选 %u/%u (应为 %u/%u), 图像 %08x/%08x\n", st7789.initTransactions, ili9341.initTransactions,
+               static_cast<unsigned>(PanelDriver<St7789Panel>::INIT_COMMANDS + 1),
+               static_cast<unsigned>(PanelDriver<Ili9341Panel>::INIT_COMMANDS + 1), st7789.checksum, ili9341.checksum);
+        failures++;
+    }
+    if (!snapshotOk || firstPixelMs > 300)
+    {
+        printf("[失败] 开机快照: 空分区拒绝 %d, 保存 %d, 未变跳过 %d, 上屏 %d, 与保存时一致 %d, 对账一致 %d (%llu/%llu 字节), "
+               "损坏拒绝 %d, 首像素 %.1f ms\n",
+               emptyRejected, snapshotSaved, unchangedSkipped, snapshotShown, snapshotMatches, reconcileMatches,
+               static_cast<unsigned long long>(reconcileBytes), static_cast<unsigned long long>(fullFrameBytes), corruptRejected,
+               firstPixelMs);
+        failures++;
+    }
+    if (hasArchive && (archive.mismatches || archive.looseOpens || archiveFrameMismatches || archiveLooseOpens || !archiveReloadOk))
+    {
+        printf("[失败] 资源归档: 内容不一致 %u 个, 主题帧不一致 %u 个, 回退散装 %u 次, 上传 JSON 热重载%s\n", archive.mismatches,
+               archiveFrameMismatches, archive.looseOpens + archiveLooseOpens, archiveReloadOk ? "生效" : "失败");
+        failures++;
+    }
+    if (!sensorsOk)
+    {
+        printf("[失败] 传感器采集: 读取失败 %u 次 (应为 2), 丢弃 %u, 显示值未变时 SPI %llu 字节, 重画 %u 次 / 原始换数 %u 次, "
+               "滤波后温度 %.2f~%.2f, 显示 %s | %s | %s\n",
+               sensors.hub.failures, sensors.hub.dropped, static_cast<unsigned long long>(sensors.quietBytes), sensors.redraws,
+               sensors.rawChanges, sensors.filteredTemp[0], sensors.filteredTemp[1], sensors.texts[0].c_str(),
+               sensors.texts[1].c_str(), sensors.texts[2].c_str());
+        failures++;
+    }
+    if (!historyOk)
+    {
+        printf("[失败] 环境历史: 误差 %.3f / %.3f / %.3f, 缺测 %u 点 (应为 60), 落盘 %u 段 (应为 %u), 恢复 %u 段%s, 时钟%s, "
+               "LTTB %s尖峰, 不变时 SPI %llu 字节, 一分钟后重画 %u 像素\n",
+               history.maxError[0], history.maxError[1], history.maxError[2], history.outageGaps, history.segments, expectedSegments,
+               history.restoredSegments, history.restoredMatches ? "" : " (不一致)", history.rebased ? "已接续" : "未接续",
+               history.peakKept ? "保留" : "丢失", static_cast<unsigned long long>(history.unchangedBytes), history.tickPixels);
+        failures++;
+    }
+    if (failures)
+    {
+        printf("渲染基准失败: %d 项\n", failures);
+        return 1;
+    }
+    printf("渲染基准通过\n");
+    return 0;
+}
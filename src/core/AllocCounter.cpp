@@ -0,0 +1,68 @@
+#include "AllocCounter.h"
+
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#ifdef COUNT_ALLOCATIONS
+namespace
+{
+std::atomic<uint32_t> g_counts[2];
+} // namespace
+
+bool AllocCounter::enabled()
+{
+    return true;
+}
+
+uint32_t AllocCounter::count()
+{
+    return g_counts[xPortGetCoreID() & 1].load(std::memory_order_relaxed);
+}
+
+void AllocCounter::note()
+{
+    g_counts[xPortGetCoreID() & 1].fetch_add(1, std::memory_order_relaxed);
+}
+
+#ifndef HOST_BUILD
+extern "C"
+{
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    AllocCounter::note();
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    AllocCounter::note();
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    AllocCounter::note();
+    return __real_realloc(ptr, size);
+}
+}
+#endif
+#else
+bool AllocCounter::enabled()
+{
+    return false;
+}
+
+uint32_t AllocCounter::count()
+{
+    return 0;
+}
+
+void AllocCounter::note()
+{
+}
+#endif
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 堆分配计数：按核累计 malloc/calloc/realloc 的调用次数（String、new 与 ArduinoJson 最终都走这里），
+// 渲染任务固定在核 0、loop() 在核 1，两处各自取差值即可得到一次渲染或一次主题切换中的分配次数。
+// 设备端在 build_flags 中加 -DCOUNT_ALLOCATIONS 并以 -Wl,--wrap 拦截这三个函数（见 platformio.ini）；
+// 主机端由 host/arduino/AllocHook.cpp 替换 malloc。ps_malloc 直接走 heap_caps，不计入。
+class AllocCounter
+{
+public:
+    static bool enabled();
+    // 当前核上的累计分配次数，未编入时恒为 0
+    static uint32_t count();
+    // 由分配钩子调用
+    static void note();
+};
@@ -0,0 +1,367 @@
+#include "AssetStore.h"
+#include "Log.h"
+#include "theme/ThemeBinary.h"
+
+#include <rom/miniz.h>
+
+AssetStore Assets;
+
+namespace
+{
+uint8_t *allocIndex(size_t bytes)
+{
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound())
+    {
+        uint8_t *buffer = static_cast<uint8_t *>(ps_malloc(bytes));
+        if (buffer)
+            return buffer;
+    }
+#endif
+    return static_cast<uint8_t *>(malloc(bytes));
+}
+} // namespace
+
+size_t AssetFile::read(uint8_t *buffer, size_t size)
+{
+    if (!_store)
+        return _file.read(buffer, size);
+
+    if (size > _size - _pos)
+        size = _size - _pos;
+    _store->lock();
+    const size_t count = _store->readAt(_base + _pos, buffer, size);
+    _store->unlock();
+    _pos += count;
+    return count;
+}
+
+bool AssetFile::seek(uint32_t pos)
+{
+    if (!_store)
+        return _file.seek(pos);
+    if (pos > _size)
+        return false;
+    _pos = pos;
+    return true;
+}
+
+void AssetFile::close()
+{
+    if (_file)
+        _file.close();
+    _store = nullptr;
+}
+
+AssetStore::AssetStore()
+{
+    _mutex = xSemaphoreCreateMutexStatic(&_mutexBuffer);
+}
+
+uint32_t AssetStore::hashPath(StrView path)
+{
+    // FNV-1a，与 tools/pack_assets.py 一致
+    uint32_t hash = 2166136261u;
+    for (char c : path)
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    return hash;
+}
+
+bool AssetStore::begin(fs::FS &fs, const char *archivePath)
+{
+    lock();
+    unmount();
+    _fs = &fs;
+    _archivePath = archivePath;
+    const bool mounted = mount();
+    unlock();
+    return mounted;
+}
+
+void AssetStore::end()
+{
+    lock();
+    unmount();
+    _fs = nullptr;
+    free(_inflater);
+    _inflater = nullptr;
+    unlock();
+}
+
+void AssetStore::unmount()
+{
+    if (_archive)
+        _archive.close();
+    free(_index);
+    _index = nullptr;
+    _buckets = nullptr;
+    _entries = nullptr;
+    _names = nullptr;
+    _entryCount = 0;
+    _bucketMask = 0;
+    _overrideCount = 0;
+    _archiveStamp = FileStamp();
+}
+
+bool AssetStore::mount()
+{
+    _archive = _fs->open(_archivePath.c_str(), "r");
+    if (!_archive)
+        return false;
+
+    _archiveStamp.size = _archive.size();
+    _archiveStamp.mtime = _archive.getLastWrite();
+
+    Header header;
+    if (_archive.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) != sizeof(header) || header.magic != MAGIC ||
+        header.version != VERSION || header.archiveBytes != _archive.size() || header.bucketCount < 2 ||
+        (header.bucketCount & (header.bucketCount - 1)) || header.entryCount >= header.bucketCount)
+    {
+        Log::printf("[资源] ❌ 资源归档头无效, 改用散装文件: %s\n", _archivePath.c_str());
+        unmount();
+        return false;
+    }
+
+    const size_t bucketBytes = sizeof(uint16_t) * header.bucketCount;
+    const size_t entryBytes = sizeof(Entry) * header.entryCount;
+    const size_t indexBytes = bucketBytes + entryBytes + header.namesBytes;
+    if (header.namesBytes == 0 || sizeof(header) + indexBytes > header.dataOffset || header.dataOffset > header.archiveBytes)
+    {
+        Log::printf("[资源] ❌ 资源归档索引越界, 改用散装文件: %s\n", _archivePath.c_str());
+        unmount();
+        return false;
+    }
+
+    _index = allocIndex(indexBytes);
+    if (!_index || _archive.read(_index, indexBytes) != indexBytes || ThemeBinary::crc32(_index, indexBytes) != header.indexCrc)
+    {
+        Log::printf("[资源] ❌ 资源归档索引校验失败, 改用散装文件: %s\n", _archivePath.c_str());
+        unmount();
+        return false;
+    }
+    _buckets = reinterpret_cast<const uint16_t *>(_index);
+    _entries = reinterpret_cast<const Entry *>(_index + bucketBytes);
+    _names = reinterpret_cast<const char *>(_index + bucketBytes + entryBytes);
+
+    // 槽与条目的引用在这里一次性检查，查找与读取时不再判断越界
+    bool valid = _names[header.namesBytes - 1] == '\0';
+    for (uint16_t i = 0; valid && i < header.bucketCount; i++)
+        valid = _buckets[i] == NO_ENTRY || _buckets[i] < header.entryCount;
+    for (uint16_t i = 0; valid && i < header.entryCount; i++)
+    {
+        const Entry &entry = _entries[i];
+        valid = entry.nameOffset < header.namesBytes && entry.offset >= header.dataOffset && entry.size <= header.archiveBytes &&
+                entry.offset <= header.archiveBytes - entry.size &&
+                ((entry.flags & FLAG_DEFLATE) || entry.rawSize == entry.size);
+    }
+    if (!valid)
+    {
+        Log::printf("[资源] ❌ 资源归档索引损坏, 改用散装文件: %s\n", _archivePath.c_str());
+        unmount();
+        return false;
+    }
+
+    _entryCount = header.entryCount;
+    _bucketMask = header.bucketCount - 1;
+    scanOverrides();
+    Log::printf("[资源] ✅ 资源归档 %s: %u 个条目, 索引 %u 字节, %u 个散装文件覆盖\n", _archivePath.c_str(), _entryCount,
+                static_cast<unsigned>(indexBytes), _overrideCount);
+    return true;
+}
+
+bool AssetStore::scanOverrides()
+{
+    // 镜像里的文件修改时间相同（或都为 0），只有运行中写入的文件比归档新
+    FilePath found[MAX_OVERRIDES];
+    uint8_t count = 0;
+    fs::File root = _fs->open("/");
+    for (fs::File file = root ? root.openNextFile() : fs::File(); file; file = root.openNextFile())
+    {
+        const StrView path(file.path());
+        if (!file.isDirectory() && file.getLastWrite() > _archiveStamp.mtime && path != _archivePath && count < MAX_OVERRIDES)
+            found[count++] = path;
+        file.close();
+    }
+    if (root)
+        root.close();
+
+    bool changed = count != _overrideCount;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        changed = changed || found[i] != _overrides[i];
+        _overrides[i] = found[i];
+    }
+    _overrideCount = count;
+    return changed;
+}
+
+bool AssetStore::refresh()
+{
+    lock();
+    const bool changed = _index && scanOverrides();
+    unlock();
+    if (changed)
+        Log::printf("[资源] ♻️ 散装文件覆盖更新: %u 个\n", _overrideCount);
+    return changed;
+}
+
+AssetStore::Stats AssetStore::stats() const
+{
+    lock();
+    const Stats stats = _stats;
+    unlock();
+    return stats;
+}
+
+const AssetStore::Entry *AssetStore::find(StrView path)
+{
+    if (!_index)
+        return nullptr;
+    // 被更新的散装文件覆盖的条目视为不在归档中
+    for (uint8_t i = 0; i < _overrideCount; i++)
+    {
+        if (_overrides[i] == path)
+            return nullptr;
+    }
+
+    // 线性探测：槽表至少是条目数的两倍，平均一两次命中
+    _stats.lookups++;
+    const uint32_t hash = hashPath(path);
+    for (uint32_t i = 0, bucket = hash & _bucketMask; i <= _bucketMask; i++, bucket = (bucket + 1) & _bucketMask)
+    {
+        _stats.probes++;
+        const uint16_t index = _buckets[bucket];
+        if (index == NO_ENTRY)
+            return nullptr;
+        const Entry &entry = _entries[index];
+        if (entry.hash == hash && StrView(_names + entry.nameOffset) == path)
+            return &entry;
+    }
+    return nullptr;
+}
+
+size_t AssetStore::readAt(uint32_t offset, void *dst, size_t length)
+{
+    if (!_archive.seek(offset))
+        return 0;
+    const size_t count = _archive.read(static_cast<uint8_t *>(dst), length);
+    _stats.archiveReads++;
+    _stats.bytesRead += count;
+    return count;
+}
+
+bool AssetStore::inflateEntry(const Entry &entry, void *dst)
+{
+    if (!_inflater)
+        _inflater = reinterpret_cast<tinfl_decompressor *>(allocIndex(sizeof(tinfl_decompressor)));
+    if (!_inflater)
+        return false;
+
+    // 压缩数据先读到临时缓冲，解压结果直接写进调用方缓冲（整段输出，不需要环形字典）
+    uint8_t *packed = static_cast<uint8_t *>(malloc(entry.size));
+    if (!packed)
+        return false;
+    bool ok = readAt(entry.offset, packed, entry.size) == entry.size;
+    if (ok)
+    {
+        size_t inBytes = entry.size;
+        size_t outBytes = entry.rawSize;
+        uint8_t *out = static_cast<uint8_t *>(dst);
+        tinfl_init(_inflater);
+        ok = tinfl_decompress(_inflater, packed, &inBytes, out, out, &outBytes, TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF) ==
+                 TINFL_STATUS_DONE &&
+             outBytes == entry.rawSize;
+    }
+    free(packed);
+    return ok;
+}
+
+bool AssetStore::exists(const char *path)
+{
+    lock();
+    const bool found = find(path) != nullptr;
+    unlock();
+    return found || (_fs && _fs->exists(path));
+}
+
+bool AssetStore::stat(const char *path, FileStamp &stamp)
+{
+    lock();
+    const Entry *entry = find(path);
+    if (entry)
+    {
+        stamp.size = entry->rawSize;
+        stamp.mtime = _archiveStamp.mtime;
+    }
+    else if (_fs)
+        _stats.looseOpens++;
+    unlock();
+    if (entry)
+        return true;
+
+    if (!_fs)
+        return false;
+    fs::File file = _fs->open(path, "r");
+    if (!file)
+        return false;
+    stamp.size = file.size();
+    stamp.mtime = file.getLastWrite();
+    file.close();
+    return true;
+}
+
+AssetFile AssetStore::open(const char *path)
+{
+    AssetFile file;
+    lock();
+    const Entry *entry = find(path);
+    if (entry && !(entry->flags & FLAG_DEFLATE))
+    {
+        file._store = this;
+        file._base = entry->offset;
+        file._size = entry->size;
+    }
+    else if (!entry && _fs)
+        _stats.looseOpens++;
+    unlock();
+    if (entry || !_fs)
+        return file;
+
+    file._file = _fs->open(path, "r");
+    return file;
+}
+
+bool AssetStore::load(const char *path, void *dst, size_t capacity, size_t &size, FileStamp *stamp)
+{
+    lock();
+    const Entry *entry = find(path);
+    bool ok = false;
+    if (entry && entry->rawSize <= capacity)
+    {
+        ok = (entry->flags & FLAG_DEFLATE) ? inflateEntry(*entry, dst) : readAt(entry->offset, dst, entry->size) == entry->size;
+        size = entry->rawSize;
+        if (stamp)
+        {
+            stamp->size = entry->rawSize;
+            stamp->mtime = _archiveStamp.mtime;
+        }
+    }
+    else if (!entry && _fs)
+        _stats.looseOpens++;
+    unlock();
+    if (entry || !_fs)
+        return ok;
+
+    fs::File file = _fs->open(path, "r");
+    if (!file)
+        return false;
+    size = file.size();
+    ok = size <= capacity && file.read(static_cast<uint8_t *>(dst), size) == size;
+    if (stamp)
+    {
+        stamp->size = size;
+        stamp->mtime = file.getLastWrite();
+    }
+    file.close();
+    return ok;
+}
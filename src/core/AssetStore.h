@@ -0,0 +1,165 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <time.h>
+#include "FixedString.h"
+
+// 文件的大小 + 修改时间，用于判断缓存是否仍然有效
+struct FileStamp
+{
+    uint32_t size = 0;
+    time_t mtime = 0;
+
+    bool operator==(const FileStamp &other) const { return size == other.size && mtime == other.mtime; }
+    bool operator!=(const FileStamp &other) const { return !(*this == other); }
+};
+
+class AssetStore;
+struct tinfl_decompressor_tag;
+
+// 资源文件句柄：归档中的条目（与其他句柄共用一个归档文件，每次读取加锁定位后直接读进调用方缓冲）
+// 或回退的散装文件。接口与 fs::File 中用到的部分一致。
+class AssetFile
+{
+public:
+    AssetFile() = default;
+
+    explicit operator bool() const { return _store ? true : static_cast<bool>(_file); }
+    size_t read(uint8_t *buffer, size_t size);
+    bool seek(uint32_t pos);
+    size_t position() const { return _store ? _pos : _file.position(); }
+    size_t size() const { return _store ? _size : _file.size(); }
+    void close();
+
+private:
+    friend class AssetStore;
+
+    AssetStore *_store = nullptr;
+    fs::File _file;
+    uint32_t _base = 0;
+    uint32_t _size = 0;
+    uint32_t _pos = 0;
+};
+
+// 资源访问入口：优先在打包归档（tools/pack_assets.py 生成的 /assets.pak）里按路径哈希 O(1) 定位，
+// 归档文件启动时只打开一次，索引常驻内存（优先 PSRAM）；归档缺失或未收录的路径回退到散装文件。
+// 两个核上的调用方共用归档句柄，读取与查找都在互斥锁内完成。
+// 已打开的句柄按归档内偏移读取，归档随文件系统镜像整体更新（上传后设备重启），运行中不重新挂载；
+// 单独上传的散装文件比归档新时覆盖归档中的同名条目，覆盖表在挂载与 refresh() 时扫描文件系统得到。
+class AssetStore
+{
+public:
+    static constexpr uint32_t MAGIC = 0x4B415041; // "APAK"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t NO_ENTRY = 0xFFFF;
+    // 条目数据按此对齐，二进制资源可按 16/32 位直接访问
+    static constexpr uint32_t ALIGNMENT = 16;
+    // 同时覆盖归档条目的散装文件上限，超出的按归档读取
+    static constexpr uint8_t MAX_OVERRIDES = 8;
+
+    enum EntryFlag : uint16_t
+    {
+        FLAG_DEFLATE = 1 << 0, // 原始 deflate 流，只能经 load() 整体解压
+    };
+
+    struct Stats
+    {
+        uint32_t lookups;
+        uint32_t probes;      // 查找时访问的哈希槽总数
+        uint32_t archiveReads; // 经归档句柄的读取次数
+        uint32_t looseOpens;   // 回退打开散装文件的次数
+        uint32_t bytesRead;
+    };
+
+    AssetStore();
+    AssetStore(const AssetStore &) = delete;
+    AssetStore &operator=(const AssetStore &) = delete;
+    ~AssetStore() { end(); }
+
+    // 读入归档索引；归档不存在或损坏时只用散装文件。返回是否启用了归档
+    bool begin(fs::FS &fs, const char *archivePath = "/assets.pak");
+    void end();
+
+    bool archived() const { return _index != nullptr; }
+    uint16_t entryCount() const { return _entryCount; }
+    uint8_t overrideCount() const { return _overrideCount; }
+
+    // 重新扫描比归档新的散装文件（文件监视与串口重载前调用，一次遍历文件系统目录），返回覆盖表是否变化
+    bool refresh();
+    Stats stats() const;
+
+    bool exists(const char *path);
+    // 归档条目的大小为原始（解压后）大小，修改时间取归档文件本身的
+    bool stat(const char *path, FileStamp &stamp);
+    // 以流方式打开，压缩条目无法随机访问，返回空句柄
+    AssetFile open(const char *path);
+    // 把整个文件读进 dst：原样存储的条目直接从归档读入，压缩条目解压到 dst。容量不足或读取失败返回 false
+    bool load(const char *path, void *dst, size_t capacity, size_t &size, FileStamp *stamp = nullptr);
+
+private:
+    friend class AssetFile;
+
+#pragma pack(push, 1)
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t entryCount;
+        uint16_t bucketCount; // 2 的幂
+        uint16_t reserved;
+        uint32_t namesBytes;
+        uint32_t dataOffset;
+        uint32_t archiveBytes;
+        uint32_t indexCrc; // 槽表 + 条目表 + 路径表
+        uint32_t reserved2;
+    };
+
+    struct Entry
+    {
+        uint32_t hash;
+        uint32_t offset;
+        uint32_t size;    // 归档中的字节数
+        uint32_t rawSize; // 解压后的字节数，未压缩时与 size 相同
+        uint16_t nameOffset;
+        uint16_t flags;
+    };
+#pragma pack(pop)
+
+    fs::FS *_fs = nullptr;
+    FilePath _archivePath;
+    fs::File _archive;
+    FileStamp _archiveStamp;
+
+    uint8_t *_index = nullptr;
+    const uint16_t *_buckets = nullptr;
+    const Entry *_entries = nullptr;
+    const char *_names = nullptr;
+    uint16_t _entryCount = 0;
+    uint16_t _bucketMask = 0;
+
+    FilePath _overrides[MAX_OVERRIDES];
+    uint8_t _overrideCount = 0;
+
+    // ROM miniz 的解压状态约 11 KB，放不进 loop 任务的 8 KB 栈：首次解压时在堆上（优先 PSRAM）分配，之后复用
+    tinfl_decompressor_tag *_inflater = nullptr;
+
+    StaticSemaphore_t _mutexBuffer;
+    SemaphoreHandle_t _mutex;
+    Stats _stats = {};
+
+    static uint32_t hashPath(StrView path);
+    void lock() const { xSemaphoreTake(_mutex, portMAX_DELAY); }
+    void unlock() const { xSemaphoreGive(_mutex); }
+    bool mount();
+    void unmount();
+    // 以下在持锁时调用
+    bool scanOverrides();
+    const Entry *find(StrView path);
+    size_t readAt(uint32_t offset, void *dst, size_t length);
+    bool inflateEntry(const Entry &entry, void *dst);
+};
+
+extern AssetStore Assets;
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// 只读字符串视图：不拥有内存，也不保证以 '\0' 结尾，按 size() 访问。
+// 渲染与驱动接口都以视图传入文本和路径，调用方不必为此构造 String。
+class StrView
+{
+public:
+    StrView() : _data(""), _size(0) {}
+    StrView(const char *str) : _data(str ? str : ""), _size(str ? strlen(str) : 0) {}
+    StrView(const char *data, size_t size) : _data(data), _size(size) {}
+
+    const char *data() const { return _data; }
+    size_t size() const { return _size; }
+    size_t length() const { return _size; }
+    bool empty() const { return _size == 0; }
+    char operator[](size_t i) const { return _data[i]; }
+    const char *begin() const { return _data; }
+    const char *end() const { return _data + _size; }
+
+    StrView substr(size_t from, size_t count = static_cast<size_t>(-1)) const
+    {
+        if (from > _size)
+            from = _size;
+        if (count > _size - from)
+            count = _size - from;
+        return StrView(_data + from, count);
+    }
+    // 找不到时返回 -1
+    int find(char c) const
+    {
+        const void *hit = _size ? memchr(_data, c, _size) : nullptr;
+        return hit ? static_cast<int>(static_cast<const char *>(hit) - _data) : -1;
+    }
+    int rfind(char c) const
+    {
+        for (size_t i = _size; i > 0; i--)
+        {
+            if (_data[i - 1] == c)
+                return static_cast<int>(i - 1);
+        }
+        return -1;
+    }
+    bool endsWith(StrView suffix) const
+    {
+        return suffix._size <= _size && memcmp(_data + _size - suffix._size, suffix._data, suffix._size) == 0;
+    }
+
+    bool operator==(StrView other) const { return _size == other._size && memcmp(_data, other._data, _size) == 0; }
+    bool operator!=(StrView other) const { return !(*this == other); }
+
+private:
+    const char *_data;
+    size_t _size;
+};
+
+// 定长内联字符串：容量 N 含结尾 '\0'，按值拷贝不分配内存。
+// 超长的内容在 UTF-8 字符边界处截断，assign 返回 false 由调用方决定是否告警。
+template <size_t N>
+class FixedString
+{
+    static_assert(N >= 2 && N <= 256, "FixedString capacity must fit in one byte");
+
+public:
+    static constexpr size_t CAPACITY = N - 1;
+
+    FixedString() { _data[0] = '\0'; }
+    FixedString(StrView str) { assign(str); }
+    FixedString(const char *str) { assign(StrView(str)); }
+
+    FixedString &operator=(StrView str)
+    {
+        assign(str);
+        return *this;
+    }
+    FixedString &operator=(const char *str)
+    {
+        assign(StrView(str));
+        return *this;
+    }
+
+    bool assign(StrView str)
+    {
+        _length = 0;
+        return append(str);
+    }
+    // 追加到末尾，放不下时同样截断并返回 false
+    bool append(StrView str)
+    {
+        const size_t room = CAPACITY - _length;
+        size_t count = str.size();
+        if (count > room)
+        {
+            // 不把多字节字符截成两半
+            count = room;
+            while (count > 0 && (static_cast<uint8_t>(str[count]) & 0xC0) == 0x80)
+                count--;
+        }
+        // 允许 str 指向自身
+        memmove(_data + _length, str.data(), count);
+        _length = static_cast<uint8_t>(_length + count);
+        _data[_length] = '\0';
+        return count == str.size();
+    }
+    void clear()
+    {
+        _data[0] = '\0';
+        _length = 0;
+    }
+
+    const char *c_str() const { return _data; }
+    size_t length() const { return _length; }
+    bool empty() const { return _length == 0; }
+    char operator[](size_t i) const { return _data[i]; }
+    StrView view() const { return StrView(_data, _length); }
+    operator StrView() const { return view(); }
+
+    bool operator==(StrView other) const { return view() == other; }
+    bool operator!=(StrView other) const { return view() != other; }
+
+private:
+    char _data[N];
+    uint8_t _length = 0;
+};
+
+// SPIFFS 的文件名上限为 32 字节（含结尾 '\0'），路径字段统一用这个容量
+typedef FixedString<32> FilePath;
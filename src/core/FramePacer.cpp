@@ -0,0 +1,65 @@
+#include "FramePacer.h"
+
+void FramePacer::start(uint16_t fps)
+{
+    _periodUs = 1000000UL / max<uint16_t>(fps, 1);
+    _start = micros();
+    _end = _start;
+    _frame = 0;
+    _started = false;
+    _frames = 0;
+    _dropped = 0;
+    _overBudget = 0;
+    _maxFrame = 0;
+    _busyTotal = 0;
+}
+
+uint32_t FramePacer::nextFrame()
+{
+    if (_started)
+    {
+        // 下一帧的开始时刻已过时跳到当前时刻所在的帧，否则按毫秒向上取整休眠到开始时刻
+        const uint32_t due = (micros() - _start) / _periodUs;
+        if (due > _frame + 1)
+        {
+            _dropped += due - _frame - 1;
+            _frame = due;
+        }
+        else
+        {
+            _frame++;
+            const uint32_t wait = _start + _frame * _periodUs - micros();
+            if (static_cast<int32_t>(wait) > 0)
+                delay((wait + 999) / 1000);
+        }
+    }
+    _started = true;
+    _frameStart = micros();
+    return _frame;
+}
+
+void FramePacer::endFrame()
+{
+    _end = micros();
+    const uint32_t busy = _end - _frameStart;
+    _frames++;
+    _busyTotal += busy;
+    _maxFrame = max(_maxFrame, busy);
+    if (busy > _periodUs)
+        _overBudget++;
+}
+
+FramePacer::Stats FramePacer::stats() const
+{
+    Stats s;
+    s.frames = _frames;
+    s.dropped = _dropped;
+    s.overBudget = _overBudget;
+    s.maxFrameMicros = _maxFrame;
+    s.avgFrameMicros = _frames ? static_cast<uint32_t>(_busyTotal / _frames) : 0;
+    s.elapsedMicros = _end - _start;
+    // 按首帧到末帧开始时刻之间的帧间隔计算
+    const uint32_t span = _frameStart - _start;
+    s.fpsX10 = _frames > 1 && span ? static_cast<uint16_t>(static_cast<uint64_t>(_frames - 1) * 10000000ULL / span) : 0;
+    return s;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 固定帧率节拍器：第 n 帧应在 start + n * 帧周期 开始，每帧的时间预算就是一个帧周期。
+// nextFrame() 休眠到下一帧的开始时刻并返回帧序号；上一帧超出预算、错过了若干帧的开始时刻时
+// 直接跳到当前应显示的帧，被跳过的帧计为掉帧。
+class FramePacer
+{
+public:
+    struct Stats
+    {
+        uint32_t frames;     // 实际呈现的帧
+        uint32_t dropped;    // 因超时被跳过的帧
+        uint32_t overBudget; // 耗时超过一个帧周期的帧
+        uint32_t maxFrameMicros;
+        uint32_t avgFrameMicros;
+        uint32_t elapsedMicros;
+        uint16_t fpsX10; // 实际帧率 x10
+    };
+
+    void start(uint16_t fps);
+    // 等到下一帧的开始时刻，返回该帧序号（从 0 开始）
+    uint32_t nextFrame();
+    // 本帧工作完成，记录耗时
+    void endFrame();
+
+    uint32_t periodMicros() const { return _periodUs; }
+    Stats stats() const;
+
+private:
+    uint32_t _periodUs = 0;
+    uint32_t _start = 0;
+    uint32_t _frameStart = 0;
+    uint32_t _frame = 0;
+    bool _started = false;
+
+    uint32_t _frames = 0;
+    uint32_t _dropped = 0;
+    uint32_t _overBudget = 0;
+    uint32_t _maxFrame = 0;
+    uint64_t _busyTotal = 0;
+    uint32_t _end = 0;
+};
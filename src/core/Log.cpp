@@ -0,0 +1,33 @@
+#include "Log.h"
+
+#include <stdarg.h>
+
+namespace Log
+{
+void printf(const char *format, ...)
+{
+    char line[LINE_BYTES];
+    va_list args;
+    va_start(args, format);
+    const int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length < 0)
+        return;
+    if (static_cast<size_t>(length) < sizeof(line))
+    {
+        Serial.write(reinterpret_cast<const uint8_t *>(line), length);
+        return;
+    }
+
+    // 罕见的超长行：完整输出比省一次分配更重要
+    va_start(args, format);
+    char *large = static_cast<char *>(malloc(length + 1));
+    if (large)
+    {
+        vsnprintf(large, length + 1, format, args);
+        Serial.write(reinterpret_cast<const uint8_t *>(large), length);
+        free(large);
+    }
+    va_end(args);
+}
+} // namespace Log
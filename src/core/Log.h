@@ -0,0 +1,13 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 串口日志：格式化到栈上的缓冲再一次写出。Arduino 的 Print::printf 在输出超过 63 字节时会 malloc 临时缓冲，
+// 带中文的日志行很容易超过，渲染、主题切换这类反复执行的路径上一律用这里的 printf。
+namespace Log
+{
+constexpr size_t LINE_BYTES = 192;
+
+// 超过 LINE_BYTES 的行临时分配一块缓冲完整输出
+void printf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+} // namespace Log
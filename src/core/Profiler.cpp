@@ -0,0 +1,138 @@
+#include "Profiler.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#ifdef ENABLE_PROFILER
+namespace
+{
+static_assert((Profiler::CAPACITY & (Profiler::CAPACITY - 1)) == 0, "Profiler capacity must be a power of two");
+
+// 两个核都会写入：先原子地占一个槽位再填写，互不阻塞
+Profiler::Record g_ring[Profiler::CAPACITY];
+std::atomic<uint32_t> g_head{0};
+
+void record(Profiler::Type type, const char *name, uint64_t start, uint32_t value)
+{
+    Profiler::Record &slot = g_ring[g_head.fetch_add(1, std::memory_order_relaxed) & (Profiler::CAPACITY - 1)];
+    slot.name = name;
+    slot.start = start;
+    slot.value = value;
+    slot.type = type;
+    slot.core = static_cast<uint8_t>(xPortGetCoreID());
+}
+
+// 64 位微秒拆成两段输出，不依赖 printf 对 %llu 的支持
+void printMicros(Print &out, uint64_t micros)
+{
+    if (micros >= 1000000)
+        out.printf("%lu%06lu", static_cast<unsigned long>(micros / 1000000), static_cast<unsigned long>(micros % 1000000));
+    else
+        out.printf("%lu", static_cast<unsigned long>(micros));
+}
+
+// 周期数换算为 “微秒.纳秒” 输出，Chrome trace 的时间单位是微秒
+void printCycles(Print &out, uint32_t cycles, uint32_t cyclesPerMicro)
+{
+    out.printf("%lu.%03lu", static_cast<unsigned long>(cycles / cyclesPerMicro),
+               static_cast<unsigned long>(cycles % cyclesPerMicro * 1000 / cyclesPerMicro));
+}
+} // namespace
+
+bool Profiler::enabled()
+{
+    return true;
+}
+
+void Profiler::zone(const char *name, uint64_t startMicros, uint32_t cycles)
+{
+    record(Type::Zone, name, startMicros, cycles);
+}
+
+void Profiler::counter(const char *name, uint32_t value)
+{
+    record(Type::Counter, name, esp_timer_get_time(), value);
+}
+
+void Profiler::sampleMemory()
+{
+    counter("heap_free", ESP.getFreeHeap());
+    counter("heap_min", ESP.getMinFreeHeap());
+    counter("psram_free", ESP.getFreePsram());
+    counter("psram_min", ESP.getMinFreePsram());
+}
+
+uint32_t Profiler::recorded()
+{
+    return g_head.load(std::memory_order_relaxed);
+}
+
+void Profiler::clear()
+{
+    g_head.store(0, std::memory_order_relaxed);
+}
+
+void Profiler::dumpChromeTrace(Print &out)
+{
+    const uint32_t head = g_head.load(std::memory_order_acquire);
+    const uint32_t first = head > CAPACITY ? head - CAPACITY : 0;
+    const uint32_t cyclesPerMicro = max<uint32_t>(ESP.getCpuFreqMHz(), 1);
+
+    // 区段在结束时才写入，外层区段排在内层之后：以保留记录中最早的起点为零点
+    uint64_t origin = UINT64_MAX;
+    for (uint32_t i = first; i < head; i++)
+        origin = min(origin, g_ring[i & (CAPACITY - 1)].start);
+
+    out.print("{\"traceEvents\":[");
+    for (uint32_t i = first; i < head; i++)
+    {
+        const Record &r = g_ring[i & (CAPACITY - 1)];
+        out.print(i == first ? "\n" : ",\n");
+        out.printf("{\"name\":\"%s\",\"pid\":1,\"tid\":%u,\"ts\":", r.name, static_cast<unsigned>(r.core));
+        printMicros(out, r.start - origin);
+        if (r.type == Type::Zone)
+        {
+            out.print(",\"ph\":\"X\",\"dur\":");
+            printCycles(out, r.value, cyclesPerMicro);
+            out.print("}");
+        }
+        else
+        {
+            out.printf(",\"ph\":\"C\",\"args\":{\"value\":%lu}}", static_cast<unsigned long>(r.value));
+        }
+    }
+    out.printf("\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"cpuMHz\":%lu,\"recorded\":%lu,\"overwritten\":%lu}}\n",
+               static_cast<unsigned long>(cyclesPerMicro), static_cast<unsigned long>(head), static_cast<unsigned long>(first));
+}
+#else
+bool Profiler::enabled()
+{
+    return false;
+}
+
+void Profiler::zone(const char *, uint64_t, uint32_t)
+{
+}
+
+void Profiler::counter(const char *, uint32_t)
+{
+}
+
+void Profiler::sampleMemory()
+{
+}
+
+uint32_t Profiler::recorded()
+{
+    return 0;
+}
+
+void Profiler::clear()
+{
+}
+
+void Profiler::dumpChromeTrace(Print &out)
+{
+    out.println("[性能] 未编入剖析器，请在 build_flags 中加入 -DENABLE_PROFILER");
+}
+#endif
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <esp_timer.h>
+
+// 帧性能剖析：作用域宏记录命名区段的起点（esp_timer 微秒）与持续周期数，计数器宏记录 SPI、堆与 PSRAM 等数值，
+// 全部写进定长环形缓冲（满后覆盖最旧的记录），串口命令再以 Chrome trace JSON 导出，
+// 可直接拖进 chrome://tracing 或 Perfetto 查看。
+// 在 build_flags 中加 -DENABLE_PROFILER 才会编入；关闭时宏展开为空，环形缓冲也不占内存。
+// 区段名与计数器名必须是字符串字面量（只保存指针）。
+#ifdef ENABLE_PROFILER
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_ZONE(name) Profiler::Zone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_COUNTER(name, value) Profiler::counter(name, value)
+#define PROFILE_MEMORY() Profiler::sampleMemory()
+#else
+#define PROFILE_ZONE(name) ((void)0)
+// sizeof 不求值，只让只为计数器准备的局部变量不触发未使用警告
+#define PROFILE_COUNTER(name, value) ((void)sizeof(value))
+#define PROFILE_MEMORY() ((void)0)
+#endif
+
+class Profiler
+{
+public:
+    static constexpr uint16_t CAPACITY = 512;
+
+    enum class Type : uint8_t
+    {
+        Zone,
+        Counter,
+    };
+
+    struct Record
+    {
+        // 两个核的周期计数器互不同步，起点统一用 esp_timer 的 64 位微秒时基，不会回绕
+        uint64_t start;
+        const char *name;
+        uint32_t value; // 区段为持续周期数（同一核上测得，任务都绑定了核），计数器为数值
+        Type type;
+        uint8_t core;
+    };
+
+    class Zone
+    {
+    public:
+        explicit Zone(const char *name) : _name(name), _start(esp_timer_get_time()), _cycles(ESP.getCycleCount()) {}
+        ~Zone() { Profiler::zone(_name, _start, ESP.getCycleCount() - _cycles); }
+        Zone(const Zone &) = delete;
+        Zone &operator=(const Zone &) = delete;
+
+    private:
+        const char *_name;
+        uint64_t _start;
+        uint32_t _cycles;
+    };
+
+    static bool enabled();
+    static void zone(const char *name, uint64_t startMicros, uint32_t cycles);
+    static void counter(const char *name, uint32_t value);
+    // 记录空闲堆、历史最低空闲堆与对应的 PSRAM 数值
+    static void sampleMemory();
+
+    // 自启动或上次 clear() 以来写入的记录数（含已被覆盖的）
+    static uint32_t recorded();
+    static void clear();
+    // 输出环形缓冲中仍保留的记录；导出期间的并发写入可能使个别记录不完整
+    static void dumpChromeTrace(Print &out);
+};
@@ -0,0 +1,316 @@
+#include "Scheduler.h"
+
+uint32_t IRAM_ATTR Scheduler::systemClock()
+{
+    return micros();
+}
+
+Scheduler::Scheduler(Clock clock) : _clock(clock)
+{
+    for (Timer &timer : _timers)
+        timer = {nullptr, nullptr, 0, 0, NO_TIMER, false};
+    for (int8_t &slot : _wheel)
+        slot = NO_TIMER;
+    for (Handler &handler : _handlers)
+        handler = {nullptr, nullptr};
+    _lastRaw = _clock();
+}
+
+void Scheduler::begin()
+{
+    _task = xTaskGetCurrentTaskHandle();
+    resetStats();
+}
+
+uint64_t Scheduler::now()
+{
+    // 32 位时钟按差值累加成 64 位，回绕后仍单调
+    const uint32_t raw = _clock();
+    _now += static_cast<uint32_t>(raw - _lastRaw);
+    _lastRaw = raw;
+    return _now;
+}
+
+Scheduler::TimerId Scheduler::startOneShot(uint32_t delayMs, TimerCallback callback, void *context)
+{
+    return start(delayMs * 1000, 0, callback, context);
+}
+
+Scheduler::TimerId Scheduler::startPeriodic(uint32_t periodMs, TimerCallback callback, void *context)
+{
+    if (periodMs == 0)
+        return NO_TIMER;
+    return start(periodMs * 1000, periodMs * 1000, callback, context);
+}
+
+Scheduler::TimerId Scheduler::start(uint32_t delayUs, uint32_t periodUs, TimerCallback callback, void *context)
+{
+    if (!callback)
+        return NO_TIMER;
+
+    for (TimerId id = 0; id < MAX_TIMERS; id++)
+    {
+        Timer &timer = _timers[id];
+        if (timer.active)
+            continue;
+        timer = {callback, context, now() + delayUs, periodUs, NO_TIMER, true};
+        link(id);
+        return id;
+    }
+    Serial.println("[调度] ❌ 定时器已用完");
+    return NO_TIMER;
+}
+
+bool Scheduler::restart(TimerId id, uint32_t delayMs)
+{
+    if (!isActive(id))
+        return false;
+    unlink(id);
+    _timers[id].deadline = now() + static_cast<uint64_t>(delayMs) * 1000;
+    link(id);
+    return true;
+}
+
+bool Scheduler::cancel(TimerId id)
+{
+    if (!isActive(id))
+        return false;
+    unlink(id);
+    _timers[id].active = false;
+    return true;
+}
+
+bool Scheduler::isActive(TimerId id) const
+{
+    return id >= 0 && id < MAX_TIMERS && _timers[id].active;
+}
+
+void Scheduler::link(TimerId id)
+{
+    Timer &timer = _timers[id];
+    int8_t &head = _wheel[(timer.deadline / TICK_US) % WHEEL_SLOTS];
+    timer.next = head;
+    head = id;
+}
+
+void Scheduler::unlink(TimerId id)
+{
+    int8_t *link = &_wheel[(_timers[id].deadline / TICK_US) % WHEEL_SLOTS];
+    while (*link != NO_TIMER)
+    {
+        if (*link == id)
+        {
+            *link = _timers[id].next;
+            break;
+        }
+        link = &_timers[*link].next;
+    }
+    _timers[id].next = NO_TIMER;
+}
+
+void Scheduler::fireDue()
+{
+    const uint64_t current = now();
+    const uint64_t currentTick = current / TICK_US;
+
+    // 只扫描上次处理之后经过的格子（最多一圈），先摘下全部到期定时器再按截止时刻依次触发，
+    // 回调里启动、取消定时器都不会打乱遍历
+    TimerId due[MAX_TIMERS];
+    uint8_t dueCount = 0;
+    for (uint64_t tick = _processedTick; tick <= currentTick && tick - _processedTick < WHEEL_SLOTS; tick++)
+    {
+        int8_t id = _wheel[tick % WHEEL_SLOTS];
+        while (id != NO_TIMER)
+        {
+            const int8_t next = _timers[id].next;
+            if (_timers[id].deadline <= current)
+            {
+                unlink(id);
+                uint8_t i = dueCount++;
+                for (; i > 0 && _timers[due[i - 1]].deadline > _timers[id].deadline; i--)
+                    due[i] = due[i - 1];
+                due[i] = id;
+            }
+            id = next;
+        }
+    }
+    _processedTick = currentTick;
+
+    for (uint8_t i = 0; i < dueCount; i++)
+    {
+        const TimerId id = due[i];
+        Timer &timer = _timers[id];
+        if (!timer.active)
+            continue;
+
+        const uint64_t fireAt = now();
+        const uint32_t jitter = static_cast<uint32_t>(fireAt - timer.deadline);
+        _maxJitter = max(_maxJitter, jitter);
+        _jitterTotal += jitter;
+        _timersFired++;
+
+        // 先安排下一次再回调，回调里可以取消或重启自己；错过的周期直接跳过，不补发
+        if (timer.periodUs)
+        {
+            timer.deadline += timer.periodUs;
+            if (timer.deadline <= fireAt)
+                timer.deadline += (fireAt - timer.deadline) / timer.periodUs * timer.periodUs + timer.periodUs;
+            link(id);
+        }
+        else
+        {
+            timer.active = false;
+        }
+        timer.callback(timer.context);
+    }
+}
+
+void Scheduler::onEvent(uint8_t type, EventHandler handler, void *context)
+{
+    if (type < MAX_EVENT_TYPES)
+        _handlers[type] = {handler, context};
+}
+
+bool Scheduler::enqueue(const Event &event)
+{
+    portENTER_CRITICAL(&_eventLock);
+    const bool ok = _eventCount < EVENT_QUEUE;
+    if (ok)
+        _events[(_eventHead + _eventCount++) % EVENT_QUEUE] = event;
+    else
+        _eventsDropped++;
+    portEXIT_CRITICAL(&_eventLock);
+    return ok;
+}
+
+bool Scheduler::post(uint8_t type, uint16_t arg)
+{
+    if (!enqueue({type, arg, _clock()}))
+        return false;
+    if (_task && xTaskGetCurrentTaskHandle() != _task)
+        xTaskNotifyGive(_task);
+    return true;
+}
+
+bool IRAM_ATTR Scheduler::postFromISR(uint8_t type, uint16_t arg)
+{
+    const Event event = {type, arg, _clock()};
+    portENTER_CRITICAL_ISR(&_eventLock);
+    const bool ok = _eventCount < EVENT_QUEUE;
+    if (ok)
+        _events[(_eventHead + _eventCount++) % EVENT_QUEUE] = event;
+    else
+        _eventsDropped++;
+    portEXIT_CRITICAL_ISR(&_eventLock);
+
+    if (ok && _task)
+    {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(_task, &woken);
+        if (woken)
+            portYIELD_FROM_ISR();
+    }
+    return ok;
+}
+
+bool Scheduler::takeEvent(Event &event)
+{
+    portENTER_CRITICAL(&_eventLock);
+    const bool ok = _eventCount > 0;
+    if (ok)
+    {
+        event = _events[_eventHead];
+        _eventHead = (_eventHead + 1) % EVENT_QUEUE;
+        _eventCount--;
+    }
+    portEXIT_CRITICAL(&_eventLock);
+    return ok;
+}
+
+void Scheduler::setIdleHook(IdleHook hook, void *context)
+{
+    _idleHook = hook ? hook : waitForNotification;
+    _idleContext = context;
+}
+
+void Scheduler::dispatch()
+{
+    // 只处理进入时已在队列中的事件，处理函数再投递的事件留到下一轮，避免饿死定时器
+    portENTER_CRITICAL(&_eventLock);
+    uint8_t pending = _eventCount;
+    portEXIT_CRITICAL(&_eventLock);
+
+    Event event;
+    while (pending-- > 0 && takeEvent(event))
+    {
+        _eventsDispatched++;
+        if (event.type >= MAX_EVENT_TYPES)
+            continue;
+        const Handler &handler = _handlers[event.type];
+        if (handler.handler)
+            handler.handler(event, handler.context);
+    }
+    fireDue();
+}
+
+uint32_t Scheduler::microsUntilNextDeadline()
+{
+    const uint64_t current = now();
+    uint64_t wait = MAX_IDLE_US;
+    for (const Timer &timer : _timers)
+    {
+        if (timer.active)
+            wait = min<uint64_t>(wait, timer.deadline > current ? timer.deadline - current : 0);
+    }
+    return static_cast<uint32_t>(wait);
+}
+
+void Scheduler::runOnce()
+{
+    dispatch();
+
+    portENTER_CRITICAL(&_eventLock);
+    const bool pending = _eventCount > 0;
+    portEXIT_CRITICAL(&_eventLock);
+    if (pending)
+        return;
+
+    const uint32_t sleep = microsUntilNextDeadline();
+    if (sleep == 0)
+        return;
+
+    const uint64_t before = now();
+    _idleHook(sleep, _idleContext);
+    _idleMicros += now() - before;
+}
+
+void Scheduler::waitForNotification(uint32_t sleepMicros, void *context)
+{
+    // 向上取整到系统节拍，宁可晚醒一拍也不空转
+    const uint32_t tickUs = portTICK_PERIOD_MS * 1000;
+    ulTaskNotifyTake(pdTRUE, (sleepMicros + tickUs - 1) / tickUs);
+}
+
+Scheduler::Stats Scheduler::stats()
+{
+    const uint64_t elapsed = now() - _statsStart;
+    Stats s;
+    s.timersFired = _timersFired;
+    s.eventsDispatched = _eventsDispatched;
+    s.eventsDropped = _eventsDropped;
+    s.maxJitterMicros = _maxJitter;
+    s.avgJitterMicros = _timersFired ? static_cast<uint32_t>(_jitterTotal / _timersFired) : 0;
+    s.idlePercent = elapsed ? static_cast<uint8_t>(min<uint64_t>(_idleMicros * 100 / elapsed, 100)) : 0;
+    return s;
+}
+
+void Scheduler::resetStats()
+{
+    _timersFired = 0;
+    _eventsDispatched = 0;
+    _eventsDropped = 0;
+    _maxJitter = 0;
+    _jitterTotal = 0;
+    _idleMicros = 0;
+    _statsStart = now();
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// 事件驱动调度器：定时器挂在 1 ms 一格的时间轮上，事件从任务或中断投递到环形队列，
+// runOnce() 依次分发事件、触发到期定时器，然后交给空闲钩子一直休眠到下一个截止时刻或新事件到来。
+// 时钟可替换，主机端测试用虚拟时钟驱动，结果与真实耗时无关。
+class Scheduler
+{
+public:
+    static constexpr uint8_t MAX_TIMERS = 16;
+    static constexpr uint16_t WHEEL_SLOTS = 64;
+    static constexpr uint32_t TICK_US = 1000;
+    static constexpr uint8_t EVENT_QUEUE = 32;
+    static constexpr uint8_t MAX_EVENT_TYPES = 16;
+    // 没有定时器时空闲钩子最长休眠时间，保证 32 位时钟回绕能被及时察觉
+    static constexpr uint32_t MAX_IDLE_US = 1000000;
+    static constexpr int8_t NO_TIMER = -1;
+
+    typedef int8_t TimerId;
+    typedef uint32_t (*Clock)();
+    typedef void (*TimerCallback)(void *context);
+
+    struct Event
+    {
+        uint8_t type;
+        uint16_t arg;
+        uint32_t timestamp; // 投递时刻（微秒）
+    };
+    typedef void (*EventHandler)(const Event &event, void *context);
+    // 休眠至多 sleepMicros 微秒；有事件投递时应尽早返回
+    typedef void (*IdleHook)(uint32_t sleepMicros, void *context);
+
+    struct Stats
+    {
+        uint32_t timersFired;
+        uint32_t eventsDispatched;
+        uint32_t eventsDropped;
+        uint32_t maxJitterMicros; // 定时器实际触发时刻相对截止时刻的延后
+        uint32_t avgJitterMicros;
+        uint8_t idlePercent;
+    };
+
+    explicit Scheduler(Clock clock = systemClock);
+
+    // 记录调用任务，中断投递事件后唤醒它
+    void begin();
+
+    TimerId startOneShot(uint32_t delayMs, TimerCallback callback, void *context = nullptr);
+    TimerId startPeriodic(uint32_t periodMs, TimerCallback callback, void *context = nullptr);
+    // 重新从现在开始计时（周期定时器保留周期）
+    bool restart(TimerId id, uint32_t delayMs);
+    bool cancel(TimerId id);
+    bool isActive(TimerId id) const;
+
+    void onEvent(uint8_t type, EventHandler handler, void *context = nullptr);
+    bool post(uint8_t type, uint16_t arg = 0);
+    // 只能在中断里调用；时钟函数也须能在中断里运行（默认的 micros() 可以）
+    bool IRAM_ATTR postFromISR(uint8_t type, uint16_t arg = 0);
+
+    void setIdleHook(IdleHook hook, void *context = nullptr);
+
+    // 分发事件与到期定时器，再进入空闲直到下一个截止时刻；在 loop() 中反复调用
+    void runOnce();
+    // 只分发，不进入空闲
+    void dispatch();
+    // 距下一个定时器截止的微秒数（没有定时器时为 MAX_IDLE_US）
+    uint32_t microsUntilNextDeadline();
+
+    Stats stats();
+    void resetStats();
+
+    // 默认空闲：阻塞在任务通知上，FreeRTOS 的空闲任务借此进入低功耗
+    static void waitForNotification(uint32_t sleepMicros, void *context);
+
+private:
+    struct Timer
+    {
+        TimerCallback callback;
+        void *context;
+        uint64_t deadline; // 微秒
+        uint32_t periodUs; // 0 为单次
+        int8_t next;       // 同一格中的下一个定时器
+        bool active;
+    };
+
+    struct Handler
+    {
+        EventHandler handler;
+        void *context;
+    };
+
+    Clock _clock;
+    uint32_t _lastRaw = 0;
+    uint64_t _now = 0;
+    uint64_t _processedTick = 0;
+
+    Timer _timers[MAX_TIMERS];
+    int8_t _wheel[WHEEL_SLOTS];
+
+    Event _events[EVENT_QUEUE];
+    uint8_t _eventHead = 0;
+    uint8_t _eventCount = 0;
+    portMUX_TYPE _eventLock = portMUX_INITIALIZER_UNLOCKED;
+    Handler _handlers[MAX_EVENT_TYPES];
+
+    TaskHandle_t _task = nullptr;
+    IdleHook _idleHook = waitForNotification;
+    void *_idleContext = nullptr;
+
+    uint32_t _timersFired = 0;
+    uint32_t _eventsDispatched = 0;
+    volatile uint32_t _eventsDropped = 0;
+    uint32_t _maxJitter = 0;
+    uint64_t _jitterTotal = 0;
+    uint64_t _idleMicros = 0;
+    uint64_t _statsStart = 0;
+
+    static uint32_t systemClock();
+
+    uint64_t now();
+    TimerId start(uint32_t delayUs, uint32_t periodUs, TimerCallback callback, void *context);
+    void link(TimerId id);
+    void unlink(TimerId id);
+    void fireDue();
+    bool takeEvent(Event &event);
+    bool enqueue(const Event &event);
+};
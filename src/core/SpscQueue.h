@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+// 单生产者/单消费者无锁环形队列：生产者只写 _tail，消费者只写 _head，双方都不阻塞。
+// CAPACITY 必须是 2 的幂；槽位在队列内预先构造，push 拷贝进槽位、pop 移出，不做额外分配。
+template <typename T, size_t CAPACITY>
+class SpscQueue
+{
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    // 仅生产者调用；队列满时返回 false
+    bool push(const T &item)
+    {
+        const uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == CAPACITY)
+            return false;
+        _slots[tail & (CAPACITY - 1)] = item;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 仅消费者调用；队列空时返回 false
+    bool pop(T &item)
+    {
+        const uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+            return false;
+        item = std::move(_slots[head & (CAPACITY - 1)]);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 任一方都可调用，结果只是瞬时快照
+    size_t size() const
+    {
+        // 先读 head 再读 tail，保证差值不会因另一方并发推进而下溢
+        const uint32_t head = _head.load(std::memory_order_acquire);
+        return _tail.load(std::memory_order_acquire) - head;
+    }
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return CAPACITY; }
+
+private:
+    T _slots[CAPACITY];
+    std::atomic<uint32_t> _head{0};
+    std::atomic<uint32_t> _tail{0};
+};
@@ -0,0 +1,186 @@
+#include "BackgroundCache.h"
+#include "StripImage.h"
+#include "core/AssetStore.h"
+#include "core/Log.h"
+#include "core/Profiler.h"
+
+namespace
+{
+uint16_t *allocPixels(size_t bytes)
+{
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound())
+        return static_cast<uint16_t *>(ps_malloc(bytes));
+#endif
+    // 没有 PSRAM 时不在内部 RAM 缓存整屏图像，改为每次流式解码
+    return nullptr;
+}
+} // namespace
+
+BackgroundCache::~BackgroundCache()
+{
+    clear();
+}
+
+void BackgroundCache::clear()
+{
+    for (Entry &entry : _entries)
+    {
+        free(entry.pixels);
+        entry = Entry();
+    }
+}
+
+size_t BackgroundCache::cachedBytes() const
+{
+    size_t bytes = 0;
+    for (const Entry &entry : _entries)
+    {
+        if (entry.pixels)
+            bytes += sizeof(uint16_t) * entry.width * entry.height;
+    }
+    return bytes;
+}
+
+FilePath BackgroundCache::compiledPathFor(StrView imagePath)
+{
+    int dot = imagePath.rfind('.');
+    int slash = imagePath.rfind('/');
+    FilePath path = dot <= slash ? imagePath : imagePath.substr(0, dot);
+    path.append(".rle");
+    return path;
+}
+
+BackgroundCache::Entry *BackgroundCache::find(StrView path, int16_t width, int16_t height)
+{
+    for (Entry &entry : _entries)
+    {
+        if ((entry.pixels || entry.missing) && entry.width == width && entry.height == height && entry.path == path)
+            return &entry;
+    }
+    return nullptr;
+}
+
+BackgroundCache::Entry &BackgroundCache::claim(StrView path, int16_t width, int16_t height)
+{
+    // 优先空位，否则淘汰最久未使用的一项
+    Entry *slot = &_entries[0];
+    for (Entry &entry : _entries)
+    {
+        if (!entry.pixels && !entry.missing)
+        {
+            slot = &entry;
+            break;
+        }
+        if (entry.lastUse < slot->lastUse)
+            slot = &entry;
+    }
+
+    free(slot->pixels);
+    *slot = Entry();
+    slot->path = path;
+    slot->width = width;
+    slot->height = height;
+    return *slot;
+}
+
+bool BackgroundCache::draw(StrView imagePath, FrameBuffer &canvas)
+{
+    PROFILE_ZONE("background");
+    if (imagePath.empty())
+        return false;
+
+    const int16_t width = FrameBuffer::WIDTH;
+    const int16_t height = FrameBuffer::HEIGHT;
+    Entry *entry = find(imagePath, width, height);
+    if (entry)
+    {
+        entry->lastUse = ++_useClock;
+        if (entry->missing)
+            return false;
+        _hits++;
+        canvas.drawImage(0, 0, width, height, entry->pixels, width);
+        return true;
+    }
+
+    Entry &slot = claim(imagePath, width, height);
+    slot.lastUse = ++_useClock;
+    if (!decode(imagePath, slot, canvas))
+    {
+        slot.missing = true;
+        return false;
+    }
+    return true;
+}
+
+bool BackgroundCache::decode(StrView imagePath, Entry &entry, FrameBuffer &canvas)
+{
+    const unsigned long start = micros();
+    const FilePath path = compiledPathFor(imagePath);
+
+    StripImage image;
+    if (!image.open(Assets, path.c_str()))
+    {
+        Log::printf("[背景] ⚠️ 无法打开背景图 %s, 使用纯色背景\n", path.c_str());
+        return false;
+    }
+    if (image.width() != entry.width || image.height() != entry.height)
+    {
+        Log::printf("[背景] ⚠️ 背景图尺寸 %ux%u 与屏幕不符: %s\n", image.width(), image.height(), path.c_str());
+        return false;
+    }
+
+    // 有 PSRAM 时直接解码进缓存；否则借一个条带缓冲逐条带画到画布
+    const size_t pixelCount = static_cast<size_t>(entry.width) * entry.height;
+    entry.pixels = allocPixels(sizeof(uint16_t) * pixelCount);
+    uint16_t *strip = nullptr;
+    size_t working = image.workingBytes();
+    if (!entry.pixels)
+    {
+        const size_t stripBytes = sizeof(uint16_t) * entry.width * image.stripRows();
+        strip = static_cast<uint16_t *>(malloc(stripBytes));
+        if (!strip)
+        {
+            Serial.println("[背景] ❌ 条带缓冲内存不足");
+            return false;
+        }
+        working += stripBytes;
+    }
+
+    bool ok = true;
+    int16_t y = 0;
+    for (uint16_t i = 0; i < image.stripCount() && ok; i++)
+    {
+        const uint16_t rows = image.rowsOf(i);
+        if (entry.pixels)
+        {
+            ok = image.decodeStrip(i, entry.pixels + static_cast<int32_t>(y) * entry.width);
+        }
+        else
+        {
+            ok = image.decodeStrip(i, strip);
+            if (ok)
+                canvas.drawImage(0, y, entry.width, rows, strip, entry.width);
+        }
+        y += rows;
+    }
+    free(strip);
+
+    if (!ok)
+    {
+        Log::printf("[背景] ❌ 背景图数据损坏: %s\n", path.c_str());
+        free(entry.pixels);
+        entry.pixels = nullptr;
+        return false;
+    }
+
+    if (entry.pixels)
+        canvas.drawImage(0, 0, entry.width, entry.height, entry.pixels, entry.width);
+
+    _decodes++;
+    _lastDecodeMicros = micros() - start;
+    _peakWorkingBytes = max(_peakWorkingBytes, working);
+    Log::printf("[背景] 🖼️ 解码 %s: %u us, 峰值工作内存 %u 字节, %s\n", path.c_str(), static_cast<unsigned>(_lastDecodeMicros),
+                static_cast<unsigned>(working), entry.pixels ? "已缓存到 PSRAM" : "无 PSRAM, 流式绘制");
+    return true;
+}
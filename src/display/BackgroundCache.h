@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+#include "FrameBuffer.h"
+
+// 主题背景图的解码结果缓存：按图像路径 + 尺寸索引，整屏 RGB565 放在 PSRAM 中，
+// 再次进入同一主题时直接拷贝到画布。源文件是构建期转换好的条带 RLE 图像（见 StripImage）。
+class BackgroundCache
+{
+public:
+    static constexpr uint8_t CAPACITY = 6;
+
+    BackgroundCache() = default;
+    BackgroundCache(const BackgroundCache &) = delete;
+    BackgroundCache &operator=(const BackgroundCache &) = delete;
+    ~BackgroundCache();
+
+    // 把背景图铺满画布。未命中时逐条带解码进缓存；PSRAM 不足时逐条带直接画到画布。
+    // 图像缺失或损坏时返回 false，由调用方改画纯色背景（失败结果同样被缓存，不会每帧重试）。
+    bool draw(StrView imagePath, FrameBuffer &canvas);
+    void clear();
+
+    uint32_t hits() const { return _hits; }
+    uint32_t decodes() const { return _decodes; }
+    uint32_t lastDecodeMicros() const { return _lastDecodeMicros; }
+    // 解码过程中解码器自身占用的最大堆内存（不含缓存本体）
+    size_t peakWorkingBytes() const { return _peakWorkingBytes; }
+    size_t cachedBytes() const;
+
+    // 主题里写的是原始图片路径（如 /themes/theme_1.webp），设备读取同名的 .rle
+    static FilePath compiledPathFor(StrView imagePath);
+
+private:
+    struct Entry
+    {
+        FilePath path;
+        int16_t width = 0;
+        int16_t height = 0;
+        uint16_t *pixels = nullptr;
+        bool missing = false;
+        uint32_t lastUse = 0;
+    };
+
+    Entry _entries[CAPACITY];
+    uint32_t _useClock = 0;
+    uint32_t _hits = 0;
+    uint32_t _decodes = 0;
+    uint32_t _lastDecodeMicros = 0;
+    size_t _peakWorkingBytes = 0;
+
+    Entry *find(StrView path, int16_t width, int16_t height);
+    Entry &claim(StrView path, int16_t width, int16_t height);
+    bool decode(StrView imagePath, Entry &entry, FrameBuffer &canvas);
+};
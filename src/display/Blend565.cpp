@@ -0,0 +1,86 @@
+#include "Blend565.h"
+
+namespace Blend565
+{
+uint16_t reference(uint16_t fg, uint16_t bg, uint8_t alpha)
+{
+    uint8_t fr = ((fg >> 11) & 0x1F) << 3;
+    uint8_t fgG = ((fg >> 5) & 0x3F) << 2;
+    uint8_t fb = (fg & 0x1F) << 3;
+
+    uint8_t br = ((bg >> 11) & 0x1F) << 3;
+    uint8_t bgG = ((bg >> 5) & 0x3F) << 2;
+    uint8_t bb = (bg & 0x1F) << 3;
+
+    uint8_t r = ((uint16_t)fr * alpha + (uint16_t)br * (255 - alpha)) / 255;
+    uint8_t g = ((uint16_t)fgG * alpha + (uint16_t)bgG * (255 - alpha)) / 255;
+    uint8_t b = ((uint16_t)fb * alpha + (uint16_t)bb * (255 - alpha)) / 255;
+
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+void fillSpan(uint16_t *dst, uint16_t color, uint8_t alpha, size_t count)
+{
+    if (alpha == 0)
+        return;
+    if (alpha == 255)
+    {
+        for (size_t i = 0; i < count; i++)
+            dst[i] = color;
+        return;
+    }
+
+    // 前景项对整段不变，每像素只剩背景的两次乘法
+    const uint32_t inv = 255 - alpha;
+    const uint32_t rbFg = spreadRB(color) * alpha;
+    const uint32_t gFg = greenOf(color) * alpha;
+
+    for (size_t i = 0; i < count; i++)
+        dst[i] = pack(rbFg + spreadRB(dst[i]) * inv, gFg + greenOf(dst[i]) * inv);
+}
+
+void maskSpan(uint16_t *dst, const uint8_t *mask, uint16_t first, uint16_t color, size_t count)
+{
+    // 16 级覆盖率的前景项预先乘好
+    uint32_t rbFg[16];
+    uint32_t gFg[16];
+    const uint32_t rb = spreadRB(color);
+    const uint32_t g = greenOf(color);
+    for (uint8_t level = 0; level < 16; level++)
+    {
+        rbFg[level] = rb * level * 17;
+        gFg[level] = g * level * 17;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint32_t n = first + i;
+        const uint8_t level = (mask[n >> 1] >> ((n & 1) << 2)) & 0x0F;
+        // 字形与图标的大部分像素是全透明或全覆盖，跳过乘法
+        if (level == 0)
+            continue;
+        if (level == 15)
+        {
+            dst[i] = color;
+            continue;
+        }
+        const uint32_t inv = 255 - level * 17;
+        dst[i] = pack(rbFg[level] + spreadRB(dst[i]) * inv, gFg[level] + greenOf(dst[i]) * inv);
+    }
+}
+
+void blendSpan(uint16_t *dst, const uint16_t *src, uint8_t alpha, size_t count)
+{
+    if (alpha == 0)
+        return;
+    if (alpha == 255)
+    {
+        memcpy(dst, src, count * sizeof(uint16_t));
+        return;
+    }
+
+    const uint32_t inv = 255 - alpha;
+    for (size_t i = 0; i < count; i++)
+        dst[i] = pack(spreadRB(src[i]) * alpha + spreadRB(dst[i]) * inv, greenOf(src[i]) * alpha + greenOf(dst[i]) * inv);
+}
+} // namespace Blend565
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+
+// RGB565 alpha 混合内核。结果与 reference() 逐位一致：
+// 红蓝两个通道放在同一个 32 位字里并行乘加（红在 16 位起，蓝在 0 位起，各留 13 位），绿色单独一路，
+// 除以 255 用 (x + 1 + (x >> 8)) >> 8 代替（对 x < 65535 与整除完全相同）。
+namespace Blend565
+{
+// 参考实现：展开到 8 位通道后按 /255 精确计算，用于校验
+uint16_t reference(uint16_t fg, uint16_t bg, uint8_t alpha);
+
+inline uint32_t spreadRB(uint16_t c)
+{
+    return (static_cast<uint32_t>(c & 0xF800) << 5) | (c & 0x001F);
+}
+
+inline uint32_t greenOf(uint16_t c)
+{
+    return (c >> 5) & 0x3F;
+}
+
+// 由已乘好 alpha 的红蓝/绿累加值还原出 565 像素
+inline uint16_t pack(uint32_t rb, uint32_t g)
+{
+    rb = (rb + 0x00010001 + ((rb >> 8) & 0x00FF00FF)) >> 8;
+    g = (g + 1 + (g >> 8)) >> 8;
+    return static_cast<uint16_t>(((rb >> 5) & 0xF800) | (g << 5) | (rb & 0x1F));
+}
+
+inline uint16_t blend(uint16_t fg, uint16_t bg, uint8_t alpha)
+{
+    const uint32_t inv = 255 - alpha;
+    return pack(spreadRB(fg) * alpha + spreadRB(bg) * inv, greenOf(fg) * alpha + greenOf(bg) * inv);
+}
+
+// 以同一 alpha 把纯色 color 叠到 dst 的 count 个像素上（半透明面板）
+void fillSpan(uint16_t *dst, uint16_t color, uint8_t alpha, size_t count);
+// 按 4 位 alpha 蒙版（每字节两个像素，低半字节在左）把纯色 color 叠到 dst 上，
+// 蒙版从第 first 个像素开始取 count 个（图标、抗锯齿字形）
+void maskSpan(uint16_t *dst, const uint8_t *mask, uint16_t first, uint16_t color, size_t count);
+// 以同一 alpha 把 src 叠到 dst 上（交叉淡入等整图混合）
+void blendSpan(uint16_t *dst, const uint16_t *src, uint8_t alpha, size_t count);
+} // namespace Blend565
@@ -0,0 +1,183 @@
+#include "BootSnapshot.h"
+#include "StripImage.h"
+#include "core/Log.h"
+#include "theme/ThemeBinary.h"
+
+namespace
+{
+constexpr uint32_t STRIP_PIXELS = static_cast<uint32_t>(FrameBuffer::WIDTH) * BootSnapshot::STRIP_ROWS;
+} // namespace
+
+uint16_t BootSnapshot::rowsOf(uint16_t strip)
+{
+    const int16_t y = strip * STRIP_ROWS;
+    return min<int16_t>(STRIP_ROWS, FrameBuffer::HEIGHT - y);
+}
+
+bool BootSnapshot::begin(const char *label)
+{
+    _valid = false;
+    _partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, PARTITION_SUBTYPE, label);
+    if (!_partition)
+    {
+        Log::printf("[快照] ⚠️ 没有快照分区 %s，跳过开机快照\n", label);
+        return false;
+    }
+
+    if (esp_partition_read(_partition, 0, &_header, sizeof(_header)) != ESP_OK || _header.magic != MAGIC ||
+        _header.version != VERSION || _header.width != FrameBuffer::WIDTH || _header.height != FrameBuffer::HEIGHT ||
+        _header.stripRows != STRIP_ROWS || _header.stripCount != STRIP_COUNT || _header.payloadBytes < sizeof(OffsetTable) ||
+        _header.payloadBytes > _partition->size - sizeof(_header))
+        return false;
+
+    // 头部最后写入，能读到有效头部说明载荷已完整写入；CRC 防的是闪存位翻转
+    spi_flash_mmap_handle_t handle;
+    const uint8_t *payload = mapPayload(handle);
+    if (!payload)
+        return false;
+    const uint32_t *offsets = reinterpret_cast<const uint32_t *>(payload);
+    bool valid = ThemeBinary::crc32(payload, _header.payloadBytes) == _header.payloadCrc && offsets[0] == 0 &&
+                 offsets[STRIP_COUNT] == _header.payloadBytes - sizeof(OffsetTable);
+    for (uint16_t i = 0; valid && i < STRIP_COUNT; i++)
+        valid = offsets[i] <= offsets[i + 1];
+    spi_flash_munmap(handle);
+    if (!valid)
+    {
+        Log::printf("[快照] ❌ 开机快照校验失败，忽略\n");
+        return false;
+    }
+    _valid = true;
+    return true;
+}
+
+const uint8_t *BootSnapshot::mapPayload(spi_flash_mmap_handle_t &handle) const
+{
+    const void *mapped = nullptr;
+    if (esp_partition_mmap(_partition, sizeof(Header), _header.payloadBytes, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK)
+        return nullptr;
+    return static_cast<const uint8_t *>(mapped);
+}
+
+bool BootSnapshot::show(FrameBuffer &canvas)
+{
+    if (!_valid)
+        return false;
+
+    const uint32_t start = micros();
+    uint16_t *pixels = static_cast<uint16_t *>(malloc(sizeof(uint16_t) * STRIP_PIXELS));
+    spi_flash_mmap_handle_t handle;
+    const uint8_t *payload = pixels ? mapPayload(handle) : nullptr;
+    if (!payload)
+    {
+        free(pixels);
+        return false;
+    }
+
+    // 条带数据直接从映射的闪存解码，不经过中间缓冲
+    const uint32_t *offsets = reinterpret_cast<const uint32_t *>(payload);
+    const uint8_t *strips = payload + sizeof(OffsetTable);
+    bool ok = true;
+    for (uint16_t i = 0; ok && i < STRIP_COUNT; i++)
+    {
+        const uint16_t rows = rowsOf(i);
+        ok = StripImage::expand(strips + offsets[i], offsets[i + 1] - offsets[i], pixels,
+                                static_cast<uint32_t>(FrameBuffer::WIDTH) * rows);
+        if (ok)
+            canvas.drawImage(0, i * STRIP_ROWS, FrameBuffer::WIDTH, rows, pixels, FrameBuffer::WIDTH);
+    }
+    spi_flash_munmap(handle);
+    free(pixels);
+
+    if (!ok)
+    {
+        // 画布里留下的半张快照由随后的实时渲染整屏覆盖
+        canvas.invalidateAll();
+        Log::printf("[快照] ❌ 开机快照解码失败\n");
+        return false;
+    }
+    _stats.shownBytes = canvas.flush();
+    _stats.showMicros = micros() - start;
+    return true;
+}
+
+bool BootSnapshot::writeFrame(const uint16_t *pixels, uint8_t *strip, Header &header)
+{
+    // 第一遍只求各条带的编码长度，得出偏移表与需要擦除的范围；第二遍重新编码并写入，免去整帧大小的暂存缓冲
+    OffsetTable offsets;
+    offsets[0] = 0;
+    for (uint16_t i = 0; i < STRIP_COUNT; i++)
+        offsets[i + 1] = offsets[i] + StripImage::encode(pixels + i * STRIP_PIXELS, FrameBuffer::WIDTH * rowsOf(i), strip);
+
+    header.payloadBytes = sizeof(offsets) + offsets[STRIP_COUNT];
+    const uint32_t total = sizeof(Header) + header.payloadBytes;
+    if (total > _partition->size)
+        return false;
+    const uint32_t eraseBytes = (total + SPI_FLASH_SEC_SIZE - 1) / SPI_FLASH_SEC_SIZE * SPI_FLASH_SEC_SIZE;
+    if (esp_partition_erase_range(_partition, 0, eraseBytes) != ESP_OK)
+        return false;
+    _stats.erasedBytes += eraseBytes;
+
+    uint32_t address = sizeof(Header);
+    if (esp_partition_write(_partition, address, offsets, sizeof(offsets)) != ESP_OK)
+        return false;
+    address += sizeof(offsets);
+    header.payloadCrc = ThemeBinary::crc32(reinterpret_cast<const uint8_t *>(offsets), sizeof(offsets));
+    for (uint16_t i = 0; i < STRIP_COUNT; i++)
+    {
+        const uint32_t length = StripImage::encode(pixels + i * STRIP_PIXELS, FrameBuffer::WIDTH * rowsOf(i), strip);
+        if (esp_partition_write(_partition, address, strip, length) != ESP_OK)
+            return false;
+        header.payloadCrc = ThemeBinary::crc32(strip, length, header.payloadCrc);
+        address += length;
+    }
+    return esp_partition_write(_partition, 0, &header, sizeof(header)) == ESP_OK;
+}
+
+bool BootSnapshot::save(const FrameBuffer &canvas, uint8_t themeNumber)
+{
+    const uint16_t *pixels = canvas.frontPixels();
+    if (!_partition || !pixels)
+        return false;
+
+    const uint32_t start = micros();
+    const uint32_t frameCrc = ThemeBinary::crc32(reinterpret_cast<const uint8_t *>(pixels),
+                                                 sizeof(uint16_t) * FrameBuffer::WIDTH * FrameBuffer::HEIGHT);
+    if (_valid && _header.frameCrc == frameCrc && _header.themeNumber == themeNumber)
+    {
+        _stats.unchanged++;
+        return true;
+    }
+
+    uint8_t *strip = static_cast<uint8_t *>(malloc(StripImage::maxEncodedBytes(STRIP_PIXELS)));
+    if (!strip)
+        return false;
+
+    Header header = {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.width = FrameBuffer::WIDTH;
+    header.height = FrameBuffer::HEIGHT;
+    header.stripRows = STRIP_ROWS;
+    header.stripCount = STRIP_COUNT;
+    header.themeNumber = themeNumber;
+    header.frameCrc = frameCrc;
+    // 擦除后旧快照即失效，写入中途失败时保持无效
+    _valid = false;
+    const bool ok = writeFrame(pixels, strip, header);
+    free(strip);
+    if (!ok)
+    {
+        Log::printf("[快照] ❌ 开机快照写入失败\n");
+        return false;
+    }
+
+    _header = header;
+    _valid = true;
+    _stats.saves++;
+    _stats.lastSaveBytes = header.payloadBytes;
+    _stats.lastSaveMicros = micros() - start;
+    Log::printf("[快照] 💾 已保存开机快照: 主题 %u, %u 字节 (原始的 %u%%), 耗时 %u us\n", themeNumber, header.payloadBytes,
+                static_cast<unsigned>(header.payloadBytes * 100ull / (sizeof(uint16_t) * FrameBuffer::WIDTH * FrameBuffer::HEIGHT)),
+                _stats.lastSaveMicros);
+    return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+#include "FrameBuffer.h"
+
+// 开机快照：画面稳定后把屏幕内容（画布前台缓冲）按条带游程编码（StripImage 的格式）存进专用闪存分区，
+// 下次启动在挂载文件系统、加载主题之前就推送到屏幕；画布同时记下这份内容，第一帧实时渲染只推送不同的区域。
+// 分区里先写偏移表与条带数据，最后写头部：写到一半掉电时头部仍是擦除状态，快照视为无效。
+class BootSnapshot
+{
+public:
+    static constexpr uint32_t MAGIC = 0x504E5342; // "BSNP"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t STRIP_ROWS = 16;
+    static constexpr uint16_t STRIP_COUNT = (FrameBuffer::HEIGHT + STRIP_ROWS - 1) / STRIP_ROWS;
+    // partitions.csv 中 snapshot 分区的自定义数据子类型
+    static constexpr esp_partition_subtype_t PARTITION_SUBTYPE = static_cast<esp_partition_subtype_t>(0x40);
+
+    struct Stats
+    {
+        uint32_t saves;
+        uint32_t unchanged;      // 内容与已存快照相同、没有擦写闪存的保存请求
+        uint32_t lastSaveMicros; // 编码 + 擦除 + 写入
+        uint32_t lastSaveBytes;  // 偏移表 + 条带数据
+        uint32_t erasedBytes;
+        uint32_t showMicros;     // 解码并推送到屏幕
+        uint32_t shownBytes;     // 推送的 SPI 字节数（直通画布边解码边推送，不计入）
+    };
+
+    // 查找分区并校验已存的快照，返回是否有可显示的快照
+    bool begin(const char *label = "snapshot");
+
+    bool valid() const { return _valid; }
+    uint8_t themeNumber() const { return _header.themeNumber; }
+
+    // 把快照画到画布并推送到屏幕（面板睡眠时也可调用，只写显存）
+    bool show(FrameBuffer &canvas);
+    // 保存屏幕当前内容；与已存快照相同时不擦写。读取前台缓冲，须在渲染任务空闲时调用。
+    // 擦写闪存期间两个核的缓存都被关闭，调用方应只在画面稳定后偶尔调用
+    bool save(const FrameBuffer &canvas, uint8_t themeNumber);
+
+    const Stats &stats() const { return _stats; }
+
+private:
+#pragma pack(push, 1)
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t width;
+        uint16_t height;
+        uint16_t stripRows;
+        uint16_t stripCount;
+        uint8_t themeNumber;
+        uint8_t reserved;
+        uint32_t payloadBytes; // 偏移表 + 条带数据，紧跟在头部之后
+        uint32_t payloadCrc;
+        uint32_t frameCrc; // 原始像素的 CRC，判断内容是否变化
+    };
+#pragma pack(pop)
+
+    typedef uint32_t OffsetTable[STRIP_COUNT + 1];
+
+    const esp_partition_t *_partition = nullptr;
+    Header _header = {};
+    bool _valid = false;
+    Stats _stats = {};
+
+    static uint16_t rowsOf(uint16_t strip);
+    // 映射已存的载荷（偏移表 + 条带数据），调用方负责 spi_flash_munmap
+    const uint8_t *mapPayload(spi_flash_mmap_handle_t &handle) const;
+    bool writeFrame(const uint16_t *pixels, uint8_t *strip, Header &header);
+};
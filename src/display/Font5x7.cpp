@@ -0,0 +1,73 @@
+#include "Font5x7.h"
+
+namespace Font5x7
+{
+const uint8_t GLYPHS[] PROGMEM = {
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x5F,0x00,0x00,0x00,0x07,0x00,0x07,0x00,0x14,0x7F,0x14,0x7F,0x14,0x24,0x2A,0x7F,0x2A,0x12,0x23,0x13,0x08,0x64,0x62,0x36,0x49,0x55,0x22,0x50,0x00,0x05,0x03,0x00,0x00,0x00,0x1C,0x22,0x41,0x00,0x00,0x41,0x22,0x1C,0x00,0x14,0x08,0x3E,0x08,0x14,0x08,0x08,0x3E,0x08,0x08,0x00,0x50,0x30,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x00,0x60,0x60,0x00,0x00,0x20,0x10,0x08,0x04,0x02,0x3E,0x51,0x49,0x45,0x3E,0x00,0x42,0x7F,0x40,0x00,0x42,0x61,0x51,0x49,0x46,0x21,0x41,0x45,0x4B,0x31,0x18,0x14,0x12,0x7F,0x10,0x27,0x45,0x45,0x45,0x39,0x3C,0x4A,0x49,0x49,0x30,0x01,0x71,0x09,0x05,0x03,0x36,0x49,0x49,0x49,0x36,0x06,0x49,0x49,0x29,0x1E,0x00,0x36,0x36,0x00,0x00,0x00,0x56,0x36,0x00,0x00,0x08,0x14,0x22,0x41,0x00,0x14,0x14,0x14,0x14,0x14,0x00,0x41,0x22,0x14,0x08,0x02,0x01,0x51,0x09,0x06,0x32,0x49,0x79,0x41,0x3E,0x7E,0x11,0x11,0x11,0x7E,0x7F,0x49,0x49,0x49,0x36,0x3E,0x41,0x41,0x41,0x22,0x7F,0x41,0x41,0x22,0x1C,0x7F,0x49,0x49,0x49,0x41,0x7F,0x09,0x09,0x09,0x01,0x3E,0x41,0x49,0x49,0x7A,0x7F,0x08,0x08,0x08,0x7F,0x00,0x41,0x7F,0x41,0x00,0x20,0x40,0x41,0x3F,0x01,0x7F,0x08,0x14,0x22,0x41,0x7F,0x40,0x40,0x40,0x40,0x7F,0x02,0x0C,0x02,0x7F,0x7F,0x04,0x08,0x10,0x7F,0x3E,0x41,0x41,0x41,0x3E,0x7F,0x09,0x09,0x09,0x06,0x3E,0x41,0x51,0x21,0x5E,0x7F,0x09,0x19,0x29,0x46,0x46,0x49,0x49,0x49,0x31,0x01,0x01,0x7F,0x01,0x01,0x3F,0x40,0x40,0x40,0x3F,0x1F,0x20,0x40,0x20,0x1F,0x3F,0x40,0x38,0x40,0x3F,0x63,0x14,0x08,0x14,0x63,0x07,0x08,0x70,0x08,0x07,0x61,0x51,0x49,0x45,0x43,0x00,0x7F,0x41,0x41,0x00,0x02,0x04,0x08,0x10,0x20,0x00,0x41,0x41,0x7F,0x00,0x04,0x02,0x01,0x02,0x04,0x40,0x40,0x40,0x40,0x40,0x00,0x01,0x02,0x04,0x00,0x20,0x54,0x54,0x54,0x78,0x7F,0x48,0x44,0x44,0x38,0x38,0x44,0x44,0x44,0x20,0x38,0x44,0x44,0x48,0x7F,0x38,0x54,0x54,0x54,0x18,0x08,0x7E,0x09,0x01,0x02,0x0C,0x52,0x52,0x52,0x3E,0x7F,0x08,0x04,0x04,0x78,0x00,0x44,0x7D,0x40,0x00,0x20,0x40,0x44,0x3D,0x00,0x7F,0x10,0x28,0x44,0x00,0x00,0x41,0x7F,0x40,0x00,0x7C,0x04,0x18,0x04,0x78,0x7C,0x08,0x04,0x04,0x78,0x38,0x44,0x44,0x44,0x38,0x7C,0x14,0x14,0x14,0x08,0x08,0x14,0x14,0x18,0x7C,0x7C,0x08,0x04,0x04,0x08,0x48,0x54,0x54,0x54,0x20,0x04,0x3F,0x44,0x40,0x20,0x3C,0x40,0x40,0x20,0x7C,0x1C,0x20,0x40,0x20,0x1C,0x3C,0x40,0x30,0x40,0x3C,0x44,0x28,0x10,0x28,0x44,0x0C,0x50,0x50,0x50,0x3C,0x44,0x64,0x54,0x4C,0x44,0x00,0x08,0x36,0x41,0x00,0x00,0x00,0x7F,0x00,0x00,0x00,0x41,0x36,0x08,0x00,0x10,0x08,0x08,0x10,0x08,0x00,0x00,0x00,0x00,0x00
+};
+
+namespace
+{
+const uint8_t CACHED_SIZES[] = {1, 2, 4};
+const uint8_t CACHED_SIZE_COUNT = sizeof(CACHED_SIZES);
+
+// 每个缓存字号一张表：GLYPH_COUNT 个字形 x (GLYPH_HEIGHT*size) 行掩码，首次使用时构建
+uint32_t *g_expanded[CACHED_SIZE_COUNT] = {};
+
+uint8_t glyphIndex(char c)
+{
+    if (c < FIRST_CHAR || c > LAST_CHAR)
+        c = '?';
+    return c - FIRST_CHAR;
+}
+
+uint32_t buildRowMask(uint8_t glyph, uint8_t size, uint8_t row)
+{
+    const uint8_t srcRow = row / size;
+    const uint32_t dot = (1UL << size) - 1;
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < GLYPH_WIDTH; i++)
+    {
+        if ((pgm_read_byte(GLYPHS + glyph * GLYPH_WIDTH + i) >> srcRow) & 0x1)
+            mask |= dot << (i * size);
+    }
+    return mask;
+}
+
+const uint32_t *expandedTable(uint8_t size)
+{
+    for (uint8_t slot = 0; slot < CACHED_SIZE_COUNT; slot++)
+    {
+        if (CACHED_SIZES[slot] != size)
+            continue;
+        if (!g_expanded[slot])
+        {
+            const uint16_t rows = GLYPH_HEIGHT * size;
+            uint32_t *table = static_cast<uint32_t *>(malloc(sizeof(uint32_t) * GLYPH_COUNT * rows));
+            if (!table)
+                return nullptr;
+            for (uint8_t glyph = 0; glyph < GLYPH_COUNT; glyph++)
+                for (uint16_t row = 0; row < rows; row++)
+                    table[glyph * rows + row] = buildRowMask(glyph, size, row);
+            g_expanded[slot] = table;
+        }
+        return g_expanded[slot];
+    }
+    return nullptr;
+}
+} // namespace
+
+uint8_t column(char c, uint8_t i)
+{
+    return pgm_read_byte(GLYPHS + glyphIndex(c) * GLYPH_WIDTH + i);
+}
+
+uint32_t rowMask(char c, uint8_t size, uint8_t row)
+{
+    const uint8_t glyph = glyphIndex(c);
+    const uint32_t *table = expandedTable(size);
+    if (table)
+        return table[glyph * GLYPH_HEIGHT * size + row];
+    return buildRowMask(glyph, size, row);
+}
+} // namespace Font5x7
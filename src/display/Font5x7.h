@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 5x7 点阵 ASCII 字库（按列存储，bit0 为最上方像素）
+namespace Font5x7
+{
+constexpr char FIRST_CHAR = 32;
+constexpr char LAST_CHAR = 127;
+constexpr uint8_t GLYPH_WIDTH = 5;
+constexpr uint8_t GLYPH_HEIGHT = 8;
+constexpr uint8_t ADVANCE = 6;
+constexpr uint8_t GLYPH_COUNT = LAST_CHAR - FIRST_CHAR + 1;
+// 行位掩码为 32 位，放大倍数超过该值时只能逐点绘制
+constexpr uint8_t MAX_MASK_SIZE = 5;
+
+extern const uint8_t GLYPHS[] PROGMEM;
+
+// 返回字符 c 第 i 列的位图，不可显示字符统一替换为 '?'
+uint8_t column(char c, uint8_t i);
+
+// 放大 size 倍后字形第 row 行（0 ~ GLYPH_HEIGHT*size-1）的位掩码，bit n 对应第 n 列。
+// size 为 1/2/4（主题常用字号）时从预展开缓存中取，其余字号即时计算；size 须不超过 MAX_MASK_SIZE。
+uint32_t rowMask(char c, uint8_t size, uint8_t row);
+} // namespace Font5x7
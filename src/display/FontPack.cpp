@@ -0,0 +1,110 @@
+#include "FontPack.h"
+#include "core/Log.h"
+#include "theme/ThemeBinary.h"
+
+namespace
+{
+void *allocIndex(size_t bytes)
+{
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound())
+    {
+        void *p = ps_malloc(bytes);
+        if (p)
+            return p;
+    }
+#endif
+    return malloc(bytes);
+}
+} // namespace
+
+bool FontPack::open(AssetStore &assets, const char *path)
+{
+    close();
+
+    _file = assets.open(path);
+    if (!_file)
+        return false;
+
+    Header header;
+    if (_file.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) != sizeof(header) || header.magic != MAGIC ||
+        header.version != VERSION || header.glyphCount == 0 || header.glyphCount > MAX_GLYPHS || header.lineHeight == 0)
+    {
+        Log::printf("[字体] ❌ 字体包头无效: %s\n", path);
+        close();
+        return false;
+    }
+
+    const size_t indexBytes = sizeof(GlyphRecord) * header.glyphCount;
+    if (sizeof(header) + indexBytes + header.bitmapBytes != _file.size())
+    {
+        Log::printf("[字体] ❌ 字体包大小不符: %s\n", path);
+        close();
+        return false;
+    }
+
+    GlyphRecord *glyphs = static_cast<GlyphRecord *>(allocIndex(indexBytes));
+    if (!glyphs || _file.read(reinterpret_cast<uint8_t *>(glyphs), indexBytes) != indexBytes ||
+        ThemeBinary::crc32(reinterpret_cast<const uint8_t *>(glyphs), indexBytes) != header.indexCrc)
+    {
+        Log::printf("[字体] ❌ 字体包索引校验失败: %s\n", path);
+        free(glyphs);
+        close();
+        return false;
+    }
+
+    // 索引须严格递增且位图都在文件内，之后查找和读取就不必再检查
+    for (uint16_t i = 0; i < header.glyphCount; i++)
+    {
+        const GlyphRecord &g = glyphs[i];
+        if ((i > 0 && g.codepoint <= glyphs[i - 1].codepoint) || g.offset + bitmapBytes(g) > header.bitmapBytes)
+        {
+            Log::printf("[字体] ❌ 字体包索引损坏: %s\n", path);
+            free(glyphs);
+            close();
+            return false;
+        }
+    }
+
+    _header = header;
+    _glyphs = glyphs;
+    _bitmapStart = sizeof(header) + indexBytes;
+    return true;
+}
+
+void FontPack::close()
+{
+    if (_file)
+        _file.close();
+    free(_glyphs);
+    _glyphs = nullptr;
+    _header = {};
+}
+
+const FontPack::GlyphRecord *FontPack::find(uint32_t codepoint) const
+{
+    if (!_glyphs)
+        return nullptr;
+
+    uint16_t lo = 0;
+    uint16_t hi = _header.glyphCount;
+    while (lo < hi)
+    {
+        const uint16_t mid = (lo + hi) / 2;
+        if (_glyphs[mid].codepoint < codepoint)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo < _header.glyphCount && _glyphs[lo].codepoint == codepoint ? &_glyphs[lo] : nullptr;
+}
+
+bool FontPack::readBitmap(const GlyphRecord &glyph, uint8_t *out, size_t capacity)
+{
+    const size_t bytes = bitmapBytes(glyph);
+    if (bytes > capacity)
+        return false;
+    if (bytes == 0)
+        return true;
+    return _file.seek(_bitmapStart + glyph.offset) && _file.read(out, bytes) == bytes;
+}
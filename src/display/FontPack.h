@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+#include "core/AssetStore.h"
+
+// 预渲染的 4 位抗锯齿字体包（*.fnt），由 tools/build_fonts.py 从 TTF/OTF 生成。
+// 字形索引（按码位排序）常驻内存，位图留在闪存里按需读取，由 GlyphCache 缓存。
+class FontPack
+{
+public:
+    static constexpr uint32_t MAGIC = 0x34544E46; // "FNT4"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t MAX_GLYPHS = 8192;
+
+#pragma pack(push, 1)
+    struct GlyphRecord
+    {
+        uint32_t codepoint;
+        uint32_t offset; // 相对位图区起点
+        uint8_t width;
+        uint8_t height;
+        int8_t left;  // 相对笔位置的水平偏移
+        int8_t top;   // 相对行顶的垂直偏移
+        uint8_t advance;
+        uint8_t reserved[3];
+    };
+#pragma pack(pop)
+
+    FontPack() = default;
+    FontPack(const FontPack &) = delete;
+    FontPack &operator=(const FontPack &) = delete;
+    ~FontPack() { close(); }
+
+    bool open(AssetStore &assets, const char *path);
+    void close();
+    bool isOpen() const { return _glyphs != nullptr; }
+
+    uint8_t pixelSize() const { return _header.pixelSize; }
+    uint8_t lineHeight() const { return _header.lineHeight; }
+    uint16_t glyphCount() const { return _header.glyphCount; }
+    // 常驻内存的索引字节数
+    size_t indexBytes() const { return sizeof(GlyphRecord) * _header.glyphCount; }
+
+    // 二分查找码位，未收录返回 nullptr
+    const GlyphRecord *find(uint32_t codepoint) const;
+    // 读取字形位图（每行 (width + 1) / 2 字节），capacity 不足时失败
+    bool readBitmap(const GlyphRecord &glyph, uint8_t *out, size_t capacity);
+
+    static size_t bitmapBytes(const GlyphRecord &glyph) { return static_cast<size_t>((glyph.width + 1) / 2) * glyph.height; }
+
+private:
+#pragma pack(push, 1)
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t glyphCount;
+        uint8_t pixelSize;
+        uint8_t ascent;
+        uint8_t lineHeight;
+        uint8_t reserved;
+        uint32_t bitmapBytes;
+        uint32_t indexCrc;
+    };
+#pragma pack(pop)
+
+    AssetFile _file;
+    Header _header = {};
+    GlyphRecord *_glyphs = nullptr;
+    uint32_t _bitmapStart = 0;
+};
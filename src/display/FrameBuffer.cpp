@@ -0,0 +1,474 @@
+#include "FrameBuffer.h"
+#include "Blend565.h"
+#include "Font5x7.h"
+#include "core/Log.h"
+#include "core/Profiler.h"
+
+namespace
+{
+// 合并后多出的像素不超过此值时直接合并（大致相当于一次开窗命令的开销）
+constexpr int32_t MERGE_SLACK_PIXELS = 64;
+// 变化行之间相隔不超过此行数时归入同一个矩形
+constexpr int16_t BAND_GAP_ROWS = 4;
+
+DirtyRect unite(const DirtyRect &a, const DirtyRect &b)
+{
+    return {min(a.x0, b.x0), min(a.y0, b.y0), max(a.x1, b.x1), max(a.y1, b.y1)};
+}
+
+bool touches(const DirtyRect &a, const DirtyRect &b)
+{
+    return a.x0 <= b.x1 + 1 && b.x0 <= a.x1 + 1 && a.y0 <= b.y1 + 1 && b.y0 <= a.y1 + 1;
+}
+
+uint16_t *allocCanvas(size_t bytes)
+{
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound())
+    {
+        void *p = ps_malloc(bytes);
+        if (p)
+            return static_cast<uint16_t *>(p);
+    }
+#endif
+    return static_cast<uint16_t *>(malloc(bytes));
+}
+} // namespace
+
+void DirtyRectList::removeAt(uint8_t i)
+{
+    _rects[i] = _rects[--_count];
+}
+
+void DirtyRectList::add(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    DirtyRect rect = {x0, y0, x1, y1};
+
+    // 反复吸收可合并的矩形，直到列表中不再有能与之合并的项
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (uint8_t i = 0; i < _count; i++)
+        {
+            DirtyRect u = unite(rect, _rects[i]);
+            if (touches(rect, _rects[i]) || u.area() <= rect.area() + _rects[i].area() + MERGE_SLACK_PIXELS)
+            {
+                rect = u;
+                removeAt(i);
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    if (_count < CAPACITY)
+    {
+        _rects[_count++] = rect;
+        return;
+    }
+
+    // 列表已满：并入面积增长最小的一项
+    uint8_t best = 0;
+    int32_t bestGrowth = INT32_MAX;
+    for (uint8_t i = 0; i < _count; i++)
+    {
+        int32_t growth = unite(rect, _rects[i]).area() - _rects[i].area();
+        if (growth < bestGrowth)
+        {
+            bestGrowth = growth;
+            best = i;
+        }
+    }
+    rect = unite(rect, _rects[best]);
+    removeAt(best);
+    add(rect.x0, rect.y0, rect.x1, rect.y1);
+}
+
+FrameBuffer::~FrameBuffer()
+{
+    free(_back);
+    free(_front);
+}
+
+bool FrameBuffer::begin()
+{
+    if (_back)
+        return true;
+
+    const size_t bytes = sizeof(uint16_t) * WIDTH * HEIGHT;
+    _back = allocCanvas(bytes);
+    _front = allocCanvas(bytes);
+    if (!_back || !_front)
+    {
+        free(_back);
+        free(_front);
+        _back = nullptr;
+        _front = nullptr;
+        Serial.println("[显示] ⚠️ 离屏画布内存不足，退化为直通绘制");
+        return false;
+    }
+
+    memset(_back, 0, bytes);
+    invalidateAll();
+    Log::printf("[显示] ✅ 离屏画布就绪: 2 x %u 字节\n", static_cast<unsigned>(bytes));
+    return true;
+}
+
+void FrameBuffer::invalidateAll()
+{
+    _frontValid = false;
+    _drawn.clear();
+    _drawn.add(0, 0, WIDTH - 1, HEIGHT - 1);
+}
+
+void FrameBuffer::setClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    _clip = {max<int16_t>(x0, 0), max<int16_t>(y0, 0), min<int16_t>(x1, WIDTH - 1), min<int16_t>(y1, HEIGHT - 1)};
+}
+
+void FrameBuffer::clearClip()
+{
+    _clip = {0, 0, WIDTH - 1, HEIGHT - 1};
+}
+
+void FrameBuffer::markDrawn(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    x0 = max<int16_t>(x0, _clip.x0);
+    y0 = max<int16_t>(y0, _clip.y0);
+    x1 = min<int16_t>(x1, _clip.x1);
+    y1 = min<int16_t>(y1, _clip.y1);
+    if (x0 > x1 || y0 > y1)
+        return;
+    _drawn.add(x0, y0, x1, y1);
+}
+
+void FrameBuffer::plot(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < _clip.x0 || x > _clip.x1 || y < _clip.y0 || y > _clip.y1)
+        return;
+    _back[static_cast<int32_t>(y) * WIDTH + x] = color;
+}
+
+void FrameBuffer::fillScreen(uint16_t color)
+{
+    fillRect(0, 0, WIDTH, HEIGHT, color);
+}
+
+void FrameBuffer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (!_back)
+    {
+        _display.fillRect(x, y, w, h, color);
+        return;
+    }
+
+    int16_t x0 = max<int16_t>(x, _clip.x0);
+    int16_t y0 = max<int16_t>(y, _clip.y0);
+    int16_t x1 = min<int16_t>(x + w - 1, _clip.x1);
+    int16_t y1 = min<int16_t>(y + h - 1, _clip.y1);
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    const int16_t span = x1 - x0 + 1;
+    uint16_t *first = _back + static_cast<int32_t>(y0) * WIDTH + x0;
+    for (int16_t i = 0; i < span; i++)
+        first[i] = color;
+    for (int16_t row = y0 + 1; row <= y1; row++)
+        memcpy(_back + static_cast<int32_t>(row) * WIDTH + x0, first, span * sizeof(uint16_t));
+
+    _drawn.add(x0, y0, x1, y1);
+}
+
+void FrameBuffer::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (!_back)
+    {
+        _display.drawRect(x, y, w, h, color);
+        return;
+    }
+
+    fillRect(x, y, w, 1, color);
+    fillRect(x, y + h - 1, w, 1, color);
+    fillRect(x, y, 1, h, color);
+    fillRect(x + w - 1, y, 1, h, color);
+}
+
+void FrameBuffer::blendRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t alpha)
+{
+    if (!_back)
+        return;
+
+    const int16_t x0 = max<int16_t>(x, _clip.x0);
+    const int16_t y0 = max<int16_t>(y, _clip.y0);
+    const int16_t x1 = min<int16_t>(x + w - 1, _clip.x1);
+    const int16_t y1 = min<int16_t>(y + h - 1, _clip.y1);
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    for (int16_t row = y0; row <= y1; row++)
+        Blend565::fillSpan(_back + static_cast<int32_t>(row) * WIDTH + x0, color, alpha, x1 - x0 + 1);
+    _drawn.add(x0, y0, x1, y1);
+}
+
+void FrameBuffer::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (!_back)
+    {
+        _display.drawPixel(x, y, color);
+        return;
+    }
+
+    plot(x, y, color);
+    markDrawn(x, y, x, y);
+}
+
+void FrameBuffer::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    if (!_back)
+    {
+        _display.drawLine(x0, y0, x1, y1, color);
+        return;
+    }
+
+    const int16_t left = min(x0, x1);
+    const int16_t top = min(y0, y1);
+    const int16_t right = max(x0, x1);
+    const int16_t bottom = max(y0, y1);
+
+    int16_t dx = abs(x1 - x0);
+    int16_t dy = -abs(y1 - y0);
+    int16_t sx = (x0 < x1) ? 1 : -1;
+    int16_t sy = (y0 < y1) ? 1 : -1;
+    int16_t err = dx + dy;
+
+    while (true)
+    {
+        plot(x0, y0, color);
+        if (x0 == x1 && y0 == y1)
+            break;
+        int16_t e2 = 2 * err;
+        if (e2 >= dy)
+        {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx)
+        {
+            err += dx;
+            y0 += sy;
+        }
+    }
+
+    markDrawn(left, top, right, bottom);
+}
+
+void FrameBuffer::drawText(int16_t x, int16_t y, StrView text, uint16_t color, uint8_t size)
+{
+    if (!_back)
+    {
+        _display.drawText(x, y, text, color, size);
+        return;
+    }
+    if (text.length() == 0 || size == 0)
+        return;
+
+    int16_t cursor = x;
+    const uint8_t rows = Font5x7::GLYPH_HEIGHT * size;
+    for (size_t n = 0; n < text.length(); n++)
+    {
+        if (size <= Font5x7::MAX_MASK_SIZE)
+        {
+            for (uint8_t row = 0; row < rows; row++)
+            {
+                uint32_t mask = Font5x7::rowMask(text[n], size, row);
+                for (int16_t col = 0; mask; col++, mask >>= 1)
+                {
+                    if (mask & 0x1)
+                        plot(cursor + col, y + row, color);
+                }
+            }
+        }
+        else
+        {
+            for (uint8_t i = 0; i < Font5x7::GLYPH_WIDTH; i++)
+            {
+                uint8_t line = Font5x7::column(text[n], i);
+                for (uint8_t j = 0; line; j++, line >>= 1)
+                {
+                    if (!(line & 0x1))
+                        continue;
+                    for (uint8_t dy = 0; dy < size; dy++)
+                        for (uint8_t dx = 0; dx < size; dx++)
+                            plot(cursor + i * size + dx, y + j * size + dy, color);
+                }
+            }
+        }
+        cursor += Font5x7::ADVANCE * size;
+    }
+
+    markDrawn(x, y, cursor - 1, y + Font5x7::GLYPH_HEIGHT * size - 1);
+}
+
+void FrameBuffer::drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pixels, int16_t stride)
+{
+    const int16_t x0 = max<int16_t>(x, _clip.x0);
+    const int16_t y0 = max<int16_t>(y, _clip.y0);
+    const int16_t x1 = min<int16_t>(x + w - 1, _clip.x1);
+    const int16_t y1 = min<int16_t>(y + h - 1, _clip.y1);
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    const uint16_t *src = pixels + static_cast<int32_t>(y0 - y) * stride + (x0 - x);
+    const int16_t span = x1 - x0 + 1;
+    if (!_back)
+    {
+        _display.pushImage(x0, y0, span, y1 - y0 + 1, src, stride);
+        return;
+    }
+
+    for (int16_t row = y0; row <= y1; row++, src += stride)
+        memcpy(_back + static_cast<int32_t>(row) * WIDTH + x0, src, span * sizeof(uint16_t));
+    _drawn.add(x0, y0, x1, y1);
+}
+
+bool FrameBuffer::readImage(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *pixels, int16_t stride) const
+{
+    if (!_back)
+        return false;
+
+    const int16_t x0 = max<int16_t>(x, 0);
+    const int16_t y0 = max<int16_t>(y, 0);
+    const int16_t x1 = min<int16_t>(x + w - 1, WIDTH - 1);
+    const int16_t y1 = min<int16_t>(y + h - 1, HEIGHT - 1);
+    uint16_t *dst = pixels + static_cast<int32_t>(y0 - y) * stride + (x0 - x);
+    for (int16_t row = y0; row <= y1 && x0 <= x1; row++, dst += stride)
+        memcpy(dst, _back + static_cast<int32_t>(row) * WIDTH + x0, (x1 - x0 + 1) * sizeof(uint16_t));
+    return true;
+}
+
+void FrameBuffer::drawAlphaMask(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *mask, uint16_t fg, uint16_t bg)
+{
+    const int16_t x0 = max<int16_t>(x, _clip.x0);
+    const int16_t y0 = max<int16_t>(y, _clip.y0);
+    const int16_t x1 = min<int16_t>(x + w - 1, _clip.x1);
+    const int16_t y1 = min<int16_t>(y + h - 1, _clip.y1);
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    const int16_t rowBytes = (w + 1) / 2;
+    const int16_t span = x1 - x0 + 1;
+    uint16_t line[WIDTH];
+    for (int16_t row = y0; row <= y1; row++)
+    {
+        const uint8_t *src = mask + static_cast<int32_t>(row - y) * rowBytes;
+        if (_back)
+        {
+            Blend565::maskSpan(_back + static_cast<int32_t>(row) * WIDTH + x0, src, x0 - x, fg, span);
+            continue;
+        }
+
+        for (int16_t i = 0; i < span; i++)
+            line[i] = bg;
+        Blend565::maskSpan(line, src, x0 - x, fg, span);
+        _display.pushImage(x0, row, span, 1, line, WIDTH);
+    }
+    if (_back)
+        _drawn.add(x0, y0, x1, y1);
+}
+
+void FrameBuffer::collectChanges(const DirtyRect &area)
+{
+    if (!_frontValid)
+    {
+        _changed.add(area.x0, area.y0, area.x1, area.y1);
+        return;
+    }
+
+    bool open = false;
+    DirtyRect band = {0, 0, 0, 0};
+    for (int16_t y = area.y0; y <= area.y1; y++)
+    {
+        const uint16_t *back = _back + static_cast<int32_t>(y) * WIDTH;
+        const uint16_t *front = _front + static_cast<int32_t>(y) * WIDTH;
+
+        int16_t left = area.x0;
+        while (left <= area.x1 && back[left] == front[left])
+            left++;
+        if (left > area.x1)
+            continue;
+        int16_t right = area.x1;
+        while (right > left && back[right] == front[right])
+            right--;
+
+        if (open && y - band.y1 <= BAND_GAP_ROWS)
+        {
+            band.x0 = min(band.x0, left);
+            band.x1 = max(band.x1, right);
+            band.y1 = y;
+            continue;
+        }
+        if (open)
+            _changed.add(band.x0, band.y0, band.x1, band.y1);
+        band = {left, y, right, y};
+        open = true;
+    }
+    if (open)
+        _changed.add(band.x0, band.y0, band.x1, band.y1);
+}
+
+uint32_t FrameBuffer::flush()
+{
+    PROFILE_ZONE("flush");
+    _lastFlushRects = 0;
+    _lastFlushBytes = 0;
+    if (!_back)
+        return 0;
+
+    const uint32_t before = _display.bytesSent();
+    const uint32_t transactionsBefore = _display.transactions();
+
+    _changed.clear();
+    for (uint8_t i = 0; i < _drawn.count(); i++)
+        collectChanges(_drawn[i]);
+    _drawn.clear();
+
+    _display.startWrite();
+    for (uint8_t i = 0; i < _changed.count(); i++)
+    {
+        const DirtyRect &r = _changed[i];
+        const int16_t w = r.x1 - r.x0 + 1;
+        const int16_t h = r.y1 - r.y0 + 1;
+        const int32_t offset = static_cast<int32_t>(r.y0) * WIDTH + r.x0;
+
+        _display.pushImage(r.x0, r.y0, w, h, _back + offset, WIDTH);
+        for (int16_t row = 0; row < h; row++)
+            memcpy(_front + offset + static_cast<int32_t>(row) * WIDTH, _back + offset + static_cast<int32_t>(row) * WIDTH, w * sizeof(uint16_t));
+    }
+    _display.endWrite();
+    _frontValid = true;
+
+    _lastFlushRects = _changed.count();
+    _lastFlushBytes = _display.bytesSent() - before;
+    PROFILE_COUNTER("spi_bytes", _lastFlushBytes);
+    PROFILE_COUNTER("spi_txn", _display.transactions() - transactionsBefore);
+    return _lastFlushBytes;
+}
+
+uint32_t FrameBuffer::pushDirect(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pixels, int16_t stride)
+{
+    const uint32_t before = _display.bytesSent();
+    _display.startWrite();
+    _display.pushImage(x, y, w, h, pixels, stride);
+    _display.endWrite();
+    return _display.bytesSent() - before;
+}
+
+void FrameBuffer::commitBack()
+{
+    if (!_back)
+        return;
+    memcpy(_front, _back, sizeof(uint16_t) * WIDTH * HEIGHT);
+    _frontValid = true;
+    _drawn.clear();
+}
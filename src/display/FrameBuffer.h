@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Arduino.h>
+#include "TftDriver.h"
+
+// 闭区间矩形，x1/y1 为包含在内的右下角坐标
+struct DirtyRect
+{
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+
+    int32_t area() const { return static_cast<int32_t>(x1 - x0 + 1) * (y1 - y0 + 1); }
+};
+
+// 定长脏矩形列表：相交/相邻或合并后浪费不大的矩形会被合并，满员时并入代价最小的一项
+class DirtyRectList
+{
+public:
+    static constexpr uint8_t CAPACITY = 16;
+
+    void add(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    void clear() { _count = 0; }
+
+    uint8_t count() const { return _count; }
+    const DirtyRect &operator[](uint8_t i) const { return _rects[i]; }
+
+private:
+    DirtyRect _rects[CAPACITY];
+    uint8_t _count = 0;
+
+    void removeAt(uint8_t i);
+};
+
+// 240x320 RGB565 离屏画布（优先放在 PSRAM）。
+// 所有图元先画到后台缓冲，flush() 时与前台缓冲（屏幕当前内容的镜像）逐行比对，
+// 只把真正变化的区域合并成脏矩形推送到屏幕。
+// 内存不足时退化为直通模式，图元直接转发给 TftDriver。
+class FrameBuffer
+{
+public:
+    static constexpr int16_t WIDTH = TftDriver::WIDTH;
+    static constexpr int16_t HEIGHT = TftDriver::HEIGHT;
+
+    explicit FrameBuffer(TftDriver &display) : _display(display) {}
+    ~FrameBuffer();
+
+    bool begin();
+    bool isBuffered() const { return _back != nullptr; }
+
+    void fillScreen(uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    // 以 alpha 把纯色叠加到画布现有像素上；直通模式下无法回读，调用方应改用 fillRect
+    void blendRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t alpha);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void drawPixel(int16_t x, int16_t y, uint16_t color);
+    void drawText(int16_t x, int16_t y, StrView text, uint16_t color, uint8_t size);
+    // 拷贝 w*h 的 RGB565 像素块（行跨度 stride 个像素）到 (x, y)，超出屏幕的部分被裁掉
+    void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pixels, int16_t stride);
+    // 把 (x, y) 起 w*h 的画布像素拷出到 pixels（行跨度 stride），屏幕外的部分保持不变；直通模式下无法回读，返回 false
+    bool readImage(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *pixels, int16_t stride) const;
+    // 4 位 alpha 蒙版（每字节两个像素，低半字节在左，每行 (w + 1) / 2 字节）：按覆盖率把 fg 混合到画布现有像素上；
+    // 直通模式下无法回读，改为混合到底色 bg 上
+    void drawAlphaMask(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *mask, uint16_t fg, uint16_t bg);
+
+    // 把之后的图元裁剪到闭区间矩形内，用于局部重绘；直通模式下转发给屏幕的图元不受裁剪
+    void setClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    void clearClip();
+    const DirtyRect &clip() const { return _clip; }
+
+    // 强制下一次 flush 整屏比对并重发（例如屏幕被外部改写后）
+    void invalidateAll();
+
+    // 推送变化区域，返回本次经 SPI 发出的字节数
+    uint32_t flush();
+
+    // 过渡动画用：前台缓冲（屏幕当前画面，无效时为空）与后台缓冲（已画好但未推送的新画面）
+    const uint16_t *frontPixels() const { return _frontValid ? _front : nullptr; }
+    const uint16_t *backPixels() const { return _back; }
+    // 绕过比对把像素块直接推送到屏幕，返回 SPI 字节数；之后屏幕与前台缓冲不再一致，须以 commitBack() 收尾
+    uint32_t pushDirect(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pixels, int16_t stride);
+    // 屏幕已完整显示后台缓冲：同步前台缓冲，丢弃待比对区域
+    void commitBack();
+
+    uint8_t lastFlushRects() const { return _lastFlushRects; }
+    uint32_t lastFlushBytes() const { return _lastFlushBytes; }
+
+private:
+    TftDriver &_display;
+    uint16_t *_back = nullptr;
+    uint16_t *_front = nullptr;
+    bool _frontValid = false;
+    DirtyRect _clip = {0, 0, WIDTH - 1, HEIGHT - 1};
+
+    DirtyRectList _drawn;
+    DirtyRectList _changed;
+
+    uint8_t _lastFlushRects = 0;
+    uint32_t _lastFlushBytes = 0;
+
+    void markDrawn(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    void collectChanges(const DirtyRect &area);
+    void plot(int16_t x, int16_t y, uint16_t color);
+};
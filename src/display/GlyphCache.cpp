@@ -0,0 +1,165 @@
+#include "GlyphCache.h"
+#include "core/Log.h"
+
+namespace
+{
+void *allocSlab(size_t bytes)
+{
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound())
+        return ps_malloc(bytes);
+#endif
+    return nullptr;
+}
+} // namespace
+
+GlyphCache::~GlyphCache()
+{
+    free(_entries);
+    free(_slab);
+}
+
+bool GlyphCache::begin()
+{
+    if (_slab)
+        return true;
+
+    _capacity = CAPACITY;
+    _slab = static_cast<uint8_t *>(allocSlab(static_cast<size_t>(CAPACITY) * SLOT_BYTES));
+    if (!_slab)
+    {
+        _capacity = FALLBACK_CAPACITY;
+        _slab = static_cast<uint8_t *>(malloc(static_cast<size_t>(FALLBACK_CAPACITY) * SLOT_BYTES));
+    }
+    _entries = static_cast<Entry *>(malloc(sizeof(Entry) * _capacity));
+    if (!_slab || !_entries)
+    {
+        free(_entries);
+        free(_slab);
+        _entries = nullptr;
+        _slab = nullptr;
+        _capacity = 0;
+        Serial.println("[字体] ❌ 字形缓存分配失败");
+        return false;
+    }
+
+    clear();
+    Log::printf("[字体] 字形缓存 %u 槽位, %u 字节\n", _capacity, static_cast<unsigned>(_capacity * SLOT_BYTES));
+    return true;
+}
+
+void GlyphCache::clear()
+{
+    for (uint16_t b = 0; b < BUCKETS; b++)
+        _buckets[b] = NIL;
+
+    // 所有槽位按序串成 LRU 链，空槽位于尾部最先被取用
+    _head = _capacity ? 0 : NIL;
+    _tail = _capacity ? _capacity - 1 : NIL;
+    for (uint16_t i = 0; i < _capacity; i++)
+    {
+        Entry &e = _entries[i];
+        e.key = 0;
+        e.used = false;
+        e.chain = NIL;
+        e.prev = i > 0 ? i - 1 : NIL;
+        e.next = i + 1 < _capacity ? i + 1 : NIL;
+        e.glyph = {};
+        e.glyph.bitmap = _slab + static_cast<size_t>(i) * SLOT_BYTES;
+    }
+}
+
+const GlyphCache::Glyph *GlyphCache::find(uint8_t font, uint32_t codepoint)
+{
+    if (!_entries)
+        return nullptr;
+
+    const uint32_t key = keyOf(font, codepoint);
+    for (int16_t i = _buckets[bucketOf(key)]; i != NIL; i = _entries[i].chain)
+    {
+        if (_entries[i].key == key)
+        {
+            _hits++;
+            if (i != _head)
+            {
+                unlink(i);
+                pushFront(i);
+            }
+            return &_entries[i].glyph;
+        }
+    }
+    _misses++;
+    return nullptr;
+}
+
+GlyphCache::Glyph *GlyphCache::insert(uint8_t font, uint32_t codepoint, uint8_t *&slot)
+{
+    if (!_entries)
+        return nullptr;
+
+    const int16_t i = _tail;
+    Entry &e = _entries[i];
+    if (e.used)
+    {
+        unchain(i);
+        _evictions++;
+    }
+
+    unlink(i);
+    pushFront(i);
+
+    const uint32_t key = keyOf(font, codepoint);
+    const uint16_t bucket = bucketOf(key);
+    e.key = key;
+    e.used = true;
+    e.chain = _buckets[bucket];
+    _buckets[bucket] = i;
+
+    slot = _slab + static_cast<size_t>(i) * SLOT_BYTES;
+    e.glyph = {};
+    e.glyph.bitmap = slot;
+    return &e.glyph;
+}
+
+void GlyphCache::unlink(int16_t i)
+{
+    Entry &e = _entries[i];
+    if (e.prev != NIL)
+        _entries[e.prev].next = e.next;
+    else
+        _head = e.next;
+    if (e.next != NIL)
+        _entries[e.next].prev = e.prev;
+    else
+        _tail = e.prev;
+    e.prev = NIL;
+    e.next = NIL;
+}
+
+void GlyphCache::pushFront(int16_t i)
+{
+    Entry &e = _entries[i];
+    e.prev = NIL;
+    e.next = _head;
+    if (_head != NIL)
+        _entries[_head].prev = i;
+    _head = i;
+    if (_tail == NIL)
+        _tail = i;
+}
+
+void GlyphCache::unchain(int16_t i)
+{
+    const uint16_t bucket = bucketOf(_entries[i].key);
+    int16_t *link = &_buckets[bucket];
+    while (*link != NIL)
+    {
+        if (*link == i)
+        {
+            *link = _entries[i].chain;
+            break;
+        }
+        link = &_entries[*link].chain;
+    }
+    _entries[i].chain = NIL;
+}
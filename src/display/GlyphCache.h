@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 已解码字形的 LRU 缓存：定长槽位放在 PSRAM，按 (字体, 码位) 散列查找。
+// 槽位大小按 48px 字形的 4 位位图预留，超出的字形不进缓存。
+class GlyphCache
+{
+public:
+    static constexpr uint16_t CAPACITY = 256;
+    // 没有 PSRAM 时退回内部 RAM，只保留少量槽位
+    static constexpr uint16_t FALLBACK_CAPACITY = 32;
+    static constexpr uint16_t SLOT_BYTES = 24 * 48;
+
+    struct Glyph
+    {
+        uint8_t width;
+        uint8_t height;
+        int8_t left;
+        int8_t top;
+        uint8_t advance;
+        const uint8_t *bitmap; // 每行 (width + 1) / 2 字节
+    };
+
+    GlyphCache() = default;
+    GlyphCache(const GlyphCache &) = delete;
+    GlyphCache &operator=(const GlyphCache &) = delete;
+    ~GlyphCache();
+
+    bool begin();
+    void clear();
+
+    // 命中时把条目移到最近使用端
+    const Glyph *find(uint8_t font, uint32_t codepoint);
+    // 淘汰最久未用的条目并返回新条目，调用方把位图写入 slot（至多 SLOT_BYTES 字节）后填写度量
+    Glyph *insert(uint8_t font, uint32_t codepoint, uint8_t *&slot);
+
+    uint16_t capacity() const { return _capacity; }
+    uint32_t hits() const { return _hits; }
+    uint32_t misses() const { return _misses; }
+    uint32_t evictions() const { return _evictions; }
+
+private:
+    static constexpr uint16_t BUCKETS = 128;
+    static constexpr int16_t NIL = -1;
+
+    struct Entry
+    {
+        Glyph glyph;
+        uint32_t key;
+        int16_t prev;
+        int16_t next;
+        int16_t chain;
+        bool used;
+    };
+
+    Entry *_entries = nullptr;
+    uint8_t *_slab = nullptr;
+    uint16_t _capacity = 0;
+    int16_t _buckets[BUCKETS];
+    int16_t _head = NIL; // 最近使用
+    int16_t _tail = NIL; // 最久未用
+
+    uint32_t _hits = 0;
+    uint32_t _misses = 0;
+    uint32_t _evictions = 0;
+
+    static uint32_t keyOf(uint8_t font, uint32_t codepoint) { return (static_cast<uint32_t>(font) << 24) | (codepoint & 0xFFFFFF); }
+    static uint16_t bucketOf(uint32_t key) { return (key * 2654435761u) >> 25; }
+
+    void unlink(int16_t i);
+    void pushFront(int16_t i);
+    void unchain(int16_t i);
+};
@@ -0,0 +1,106 @@
+#include "IconAtlas.h"
+#include "core/Log.h"
+#include "theme/ThemeBinary.h"
+
+namespace
+{
+uint8_t *allocAtlas(size_t bytes)
+{
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound())
+    {
+        void *p = ps_malloc(bytes);
+        if (p)
+            return static_cast<uint8_t *>(p);
+    }
+#endif
+    return static_cast<uint8_t *>(malloc(bytes));
+}
+} // namespace
+
+bool IconAtlas::begin(AssetStore &assets, const char *path)
+{
+    free(_data);
+    _data = nullptr;
+    _size = 0;
+
+    AssetFile file = assets.open(path);
+    if (!file)
+    {
+        Log::printf("[图标] ⚠️ 找不到图标图集: %s\n", path);
+        return false;
+    }
+
+    const size_t size = file.size();
+    Header header;
+    if (size < sizeof(header) || size > MAX_FILE_SIZE || file.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) != sizeof(header) ||
+        header.magic != MAGIC || header.version != VERSION || header.cellSize == 0 || (header.cellSize & 1) || header.pageShift > 8)
+    {
+        Log::printf("[图标] ❌ 图标图集头无效: %s\n", path);
+        return false;
+    }
+
+    const size_t pageBytes = sizeof(uint16_t) * header.pageCount;
+    const size_t slotBytes = sizeof(uint16_t) * 2 * (static_cast<size_t>(header.usedPages) << header.pageShift);
+    const size_t cellBytes = static_cast<size_t>(header.cellSize) * header.cellSize / 2;
+    const size_t bodyBytes = pageBytes + slotBytes + cellBytes * header.iconCount;
+    if (sizeof(header) + bodyBytes != size)
+    {
+        Log::printf("[图标] ❌ 图标图集大小不符: %s\n", path);
+        return false;
+    }
+
+    uint8_t *data = allocAtlas(bodyBytes);
+    if (!data)
+    {
+        Serial.println("[图标] ❌ 图标图集内存不足");
+        return false;
+    }
+    if (file.read(data, bodyBytes) != bodyBytes || ThemeBinary::crc32(data, bodyBytes) != header.crc32)
+    {
+        Log::printf("[图标] ❌ 图标图集校验失败: %s\n", path);
+        free(data);
+        return false;
+    }
+
+    _header = header;
+    _data = data;
+    _size = bodyBytes;
+    _pages = reinterpret_cast<const uint16_t *>(data);
+    _slots = reinterpret_cast<const uint16_t *>(data + pageBytes);
+    _cells = data + pageBytes + slotBytes;
+
+    // 槽表里的序号必须都落在图标范围内，查找时才能免去检查
+    const size_t slotCount = slotBytes / sizeof(uint16_t);
+    for (size_t i = 0; i < slotCount; i++)
+    {
+        if (_slots[i] != NONE && _slots[i] >= header.iconCount)
+        {
+            Log::printf("[图标] ❌ 图标图集索引损坏: %s\n", path);
+            free(_data);
+            _data = nullptr;
+            _size = 0;
+            return false;
+        }
+    }
+
+    Log::printf("[图标] ✅ 图标图集已加载: %u 个 %ux%u 图标, 占用 %u 字节\n", header.iconCount, header.cellSize, header.cellSize,
+                static_cast<unsigned>(_size));
+    return true;
+}
+
+const uint8_t *IconAtlas::find(uint16_t code, bool filled) const
+{
+    if (!_data)
+        return nullptr;
+
+    const uint16_t page = code >> _header.pageShift;
+    if (page >= _header.pageCount || _pages[page] == NONE)
+        return nullptr;
+
+    const uint16_t *slot = _slots + ((static_cast<uint32_t>(_pages[page]) << _header.pageShift) | (code & ((1u << _header.pageShift) - 1))) * 2;
+    uint16_t index = filled && slot[1] != NONE ? slot[1] : slot[0];
+    if (index == NONE)
+        return nullptr;
+    return _cells + static_cast<size_t>(index) * _header.cellSize * _header.cellSize / 2;
+}
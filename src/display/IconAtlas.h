@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Arduino.h>
+#include "core/AssetStore.h"
+
+// 预光栅化的天气图标图集（*.atlas），由 tools/build_icon_atlas.py 从 data/icons/*.svg 生成。
+// 每个图标是 cellSize x cellSize 的 4 位 alpha；天气代码经两级页表 O(1) 定位到图标序号。
+// 整个文件一次性读入 PSRAM，查找与取像素都不再访问文件系统。
+class IconAtlas
+{
+public:
+    static constexpr uint32_t MAGIC = 0x34414349; // "ICA4"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t NONE = 0xFFFF;
+    static constexpr size_t MAX_FILE_SIZE = 512 * 1024;
+
+    IconAtlas() = default;
+    IconAtlas(const IconAtlas &) = delete;
+    IconAtlas &operator=(const IconAtlas &) = delete;
+    ~IconAtlas() { free(_data); }
+
+    bool begin(AssetStore &assets, const char *path);
+    bool isLoaded() const { return _data != nullptr; }
+
+    uint16_t cellSize() const { return _header.cellSize; }
+    uint16_t iconCount() const { return _header.iconCount; }
+    // 图集常驻内存的字节数
+    size_t memoryBytes() const { return _size; }
+
+    // 按天气代码查找图标的 alpha 数据（每字节两个像素，低半字节在左）。
+    // filled 为 true 时优先取 -fill 变体，没有则退回线框版本；找不到返回 nullptr。
+    const uint8_t *find(uint16_t code, bool filled = true) const;
+
+private:
+#pragma pack(push, 1)
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t cellSize;
+        uint16_t iconCount;
+        uint8_t pageShift;
+        uint8_t reserved;
+        uint16_t pageCount;
+        uint16_t usedPages;
+        uint32_t crc32;
+    };
+#pragma pack(pop)
+
+    Header _header = {};
+    uint8_t *_data = nullptr;
+    size_t _size = 0;
+    const uint16_t *_pages = nullptr;
+    const uint16_t *_slots = nullptr;
+    const uint8_t *_cells = nullptr;
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 面板特性：每种屏幕控制器 + 模组一个结构体，全部是编译期常量，由 PanelDriver<Traits> 展开。
+// 初始化表的格式为连续的 { 命令, 参数个数[| DELAY], 参数..., [延时毫秒] }，每条命令在一次片选内连发；
+// MADCTL（0x36）与睡眠/显示开关由驱动按旋转方向和时序单独发送，不写进表里。
+// 新增面板：在这里加一个结构体，在 TftDriver.cpp 末尾加一行显式实例化。
+namespace Panel
+{
+constexpr uint8_t DELAY = 0x80;
+
+// MADCTL 位
+constexpr uint8_t MADCTL_MY = 0x80;
+constexpr uint8_t MADCTL_MX = 0x40;
+constexpr uint8_t MADCTL_MV = 0x20;
+constexpr uint8_t MADCTL_BGR = 0x08;
+
+// 编译期遍历初始化表：检查每条命令都完整，并统计命令条数
+constexpr bool validInit(const uint8_t *table, size_t size, size_t pos = 0)
+{
+    return pos == size ? true
+           : pos + 2 > size ? false
+           : validInit(table, size, pos + 2 + (table[pos + 1] & ~DELAY) + ((table[pos + 1] & DELAY) ? 1 : 0));
+}
+
+constexpr size_t initCommands(const uint8_t *table, size_t size, size_t pos = 0)
+{
+    return pos >= size ? 0 : 1 + initCommands(table, size, pos + 2 + (table[pos + 1] & ~DELAY) + ((table[pos + 1] & DELAY) ? 1 : 0));
+}
+
+// 按旋转方向（0 ~ 3，每档顺时针 90°）换算出逻辑尺寸、MADCTL 与窗口偏移；
+// 偏移用于显存比玻璃大的模组（显存 GRAM_WIDTH x GRAM_HEIGHT，玻璃从 COL_OFFSET/ROW_OFFSET 开始）
+template <typename Traits>
+struct Geometry
+{
+    static constexpr uint8_t ROTATION = Traits::ROTATION & 3;
+    static constexpr bool SWAPPED = ROTATION & 1;
+
+    static constexpr int16_t WIDTH = SWAPPED ? Traits::NATIVE_HEIGHT : Traits::NATIVE_WIDTH;
+    static constexpr int16_t HEIGHT = SWAPPED ? Traits::NATIVE_WIDTH : Traits::NATIVE_HEIGHT;
+
+    static constexpr uint8_t MADCTL = Traits::MADCTL ^ (ROTATION == 1   ? (MADCTL_MX | MADCTL_MV)
+                                                        : ROTATION == 2 ? (MADCTL_MX | MADCTL_MY)
+                                                        : ROTATION == 3 ? (MADCTL_MY | MADCTL_MV)
+                                                                        : 0);
+
+    static constexpr uint16_t COL_MIRRORED = Traits::GRAM_WIDTH - Traits::NATIVE_WIDTH - Traits::COL_OFFSET;
+    static constexpr uint16_t ROW_MIRRORED = Traits::GRAM_HEIGHT - Traits::NATIVE_HEIGHT - Traits::ROW_OFFSET;
+    static constexpr uint16_t COL_OFFSET = ROTATION == 0   ? Traits::COL_OFFSET
+                                           : ROTATION == 1 ? Traits::ROW_OFFSET
+                                           : ROTATION == 2 ? COL_MIRRORED
+                                                           : ROW_MIRRORED;
+    static constexpr uint16_t ROW_OFFSET = ROTATION == 0   ? Traits::ROW_OFFSET
+                                           : ROTATION == 1 ? COL_MIRRORED
+                                           : ROTATION == 2 ? ROW_MIRRORED
+                                                           : Traits::COL_OFFSET;
+};
+} // namespace Panel
+
+// ST7789V 2.0 寸 240x320 模组（当前接线），竖屏
+struct St7789Panel
+{
+    static constexpr int16_t NATIVE_WIDTH = 240;
+    static constexpr int16_t NATIVE_HEIGHT = 320;
+    static constexpr uint16_t GRAM_WIDTH = 240;
+    static constexpr uint16_t GRAM_HEIGHT = 320;
+    static constexpr uint16_t COL_OFFSET = 0;
+    static constexpr uint16_t ROW_OFFSET = 0;
+    static constexpr uint8_t ROTATION = 0;
+    static constexpr uint8_t MADCTL = 0x00;
+
+    // 时序：复位释放后 5 ms 可发命令，120 ms 后才能退出睡眠；退出睡眠后 5 ms 可发下一条命令
+    static constexpr uint32_t RESET_PULSE_MS = 10;
+    static constexpr uint32_t RESET_READY_MS = 5;
+    static constexpr uint32_t RESET_TO_SLEEP_OUT_MS = 120;
+    static constexpr uint32_t SLEEP_OUT_READY_MS = 5;
+
+    static constexpr uint8_t INIT[] = {
+        0x3A, 1, 0x05,                         // 16 位 RGB565
+        0xC5, 1, 0x1A,                         // VCOM
+        0xB2, 5, 0x05, 0x05, 0x00, 0x33, 0x33, // 门廊
+        0xB7, 1, 0x05,                         // 栅极电压
+        0xBB, 1, 0x3F,                         // VCOM
+        0xC0, 1, 0x2C,                         // LCM 控制
+        0xC2, 1, 0x01,                         // VDV/VRH 使能
+        0xC3, 1, 0x0F,                         // VRH
+        0xC4, 1, 0x20,                         // VDV
+        0xC6, 1, 0x01,                         // 帧率
+        0xD0, 2, 0xA4, 0xA1,                   // 电源
+        0x20, 0,                               // 关闭反色
+    };
+};
+
+// ILI9341 2.8 寸 240x320 模组（README 硬件清单），竖屏，BGR 排列
+struct Ili9341Panel
+{
+    static constexpr int16_t NATIVE_WIDTH = 240;
+    static constexpr int16_t NATIVE_HEIGHT = 320;
+    static constexpr uint16_t GRAM_WIDTH = 240;
+    static constexpr uint16_t GRAM_HEIGHT = 320;
+    static constexpr uint16_t COL_OFFSET = 0;
+    static constexpr uint16_t ROW_OFFSET = 0;
+    static constexpr uint8_t ROTATION = 0;
+    static constexpr uint8_t MADCTL = Panel::MADCTL_MX | Panel::MADCTL_BGR;
+
+    static constexpr uint32_t RESET_PULSE_MS = 10;
+    static constexpr uint32_t RESET_READY_MS = 5;
+    static constexpr uint32_t RESET_TO_SLEEP_OUT_MS = 120;
+    static constexpr uint32_t SLEEP_OUT_READY_MS = 5;
+
+    static constexpr uint8_t INIT[] = {
+        0xEF, 3, 0x03, 0x80, 0x02,
+        0xCF, 3, 0x00, 0xC1, 0x30,             // 电源控制 B
+        0xED, 4, 0x64, 0x03, 0x12, 0x81,       // 上电时序
+        0xE8, 3, 0x85, 0x00, 0x78,             // 驱动时序 A
+        0xCB, 5, 0x39, 0x2C, 0x00, 0x34, 0x02, // 电源控制 A
+        0xF7, 1, 0x20,                         // 泵比
+        0xEA, 2, 0x00, 0x00,                   // 驱动时序 B
+        0xC0, 1, 0x23,                         // 电源控制 1
+        0xC1, 1, 0x10,                         // 电源控制 2
+        0xC5, 2, 0x3E, 0x28,                   // VCOM 1
+        0xC7, 1, 0x86,                         // VCOM 2
+        0x37, 1, 0x00,                         // 垂直滚动起点
+        0x3A, 1, 0x55,                         // 16 位 RGB565
+        0xB1, 2, 0x00, 0x18,                   // 帧率 79 Hz
+        0xB6, 3, 0x08, 0x82, 0x27,             // 显示功能
+        0xF2, 1, 0x00,                         // 关闭 3Gamma
+        0x26, 1, 0x01,                         // Gamma 曲线
+        0xE0, 15, 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1, 0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,
+        0xE1, 15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1, 0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,
+    };
+};
+
+// 固件使用的面板：默认 ST7789，构建参数 -DPANEL_ILI9341 换成 ILI9341
+#if defined(PANEL_ILI9341)
+typedef Ili9341Panel ActivePanel;
+#else
+typedef St7789Panel ActivePanel;
+#endif
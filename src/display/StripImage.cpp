@@ -0,0 +1,152 @@
+#include "StripImage.h"
+#include "core/Log.h"
+
+bool StripImage::open(AssetStore &assets, const char *path)
+{
+    close();
+
+    _file = assets.open(path);
+    if (!_file)
+        return false;
+
+    if (_file.read(reinterpret_cast<uint8_t *>(&_header), sizeof(_header)) != sizeof(_header) || _header.magic != MAGIC ||
+        _header.version != VERSION || _header.width == 0 || _header.height == 0 || _header.width > MAX_DIMENSION ||
+        _header.height > MAX_DIMENSION || _header.stripRows == 0 ||
+        _header.stripCount != (_header.height + _header.stripRows - 1) / _header.stripRows || _header.maxStripBytes == 0 ||
+        _header.maxStripBytes > MAX_STRIP_BYTES)
+    {
+        Log::printf("[图像] ❌ 条带图像头无效: %s\n", path);
+        close();
+        return false;
+    }
+
+    const size_t tableBytes = sizeof(uint32_t) * (_header.stripCount + 1);
+    _offsets = static_cast<uint32_t *>(malloc(tableBytes));
+    _input = static_cast<uint8_t *>(malloc(_header.maxStripBytes));
+    if (!_offsets || !_input || _file.read(reinterpret_cast<uint8_t *>(_offsets), tableBytes) != tableBytes)
+    {
+        Log::printf("[图像] ❌ 条带图像读取失败: %s\n", path);
+        close();
+        return false;
+    }
+
+    _dataStart = sizeof(_header) + tableBytes;
+    for (uint16_t i = 0; i < _header.stripCount; i++)
+    {
+        if (_offsets[i] > _offsets[i + 1] || _offsets[i + 1] - _offsets[i] > _header.maxStripBytes)
+        {
+            Log::printf("[图像] ❌ 条带偏移表损坏: %s\n", path);
+            close();
+            return false;
+        }
+    }
+    if (_dataStart + _offsets[_header.stripCount] > _file.size())
+    {
+        Log::printf("[图像] ❌ 条带图像被截断: %s\n", path);
+        close();
+        return false;
+    }
+    return true;
+}
+
+void StripImage::close()
+{
+    if (_file)
+        _file.close();
+    free(_offsets);
+    free(_input);
+    _offsets = nullptr;
+    _input = nullptr;
+    _header = {};
+}
+
+uint16_t StripImage::rowsOf(uint16_t index) const
+{
+    const uint32_t y = static_cast<uint32_t>(index) * _header.stripRows;
+    if (y >= _header.height)
+        return 0;
+    return min<uint32_t>(_header.stripRows, _header.height - y);
+}
+
+size_t StripImage::workingBytes() const
+{
+    if (!_offsets)
+        return 0;
+    return sizeof(uint32_t) * (_header.stripCount + 1) + _header.maxStripBytes;
+}
+
+bool StripImage::decodeStrip(uint16_t index, uint16_t *out)
+{
+    if (!_input || index >= _header.stripCount)
+        return false;
+
+    const uint32_t length = _offsets[index + 1] - _offsets[index];
+    if (!_file.seek(_dataStart + _offsets[index]) || _file.read(_input, length) != length)
+        return false;
+    return expand(_input, length, out, static_cast<uint32_t>(_header.width) * rowsOf(index));
+}
+
+uint32_t StripImage::encode(const uint16_t *pixels, uint32_t count, uint8_t *out)
+{
+    uint8_t *start = out;
+    uint32_t i = 0;
+    while (i < count)
+    {
+        uint32_t run = 1;
+        while (i + run < count && run < MAX_TOKEN && pixels[i + run] == pixels[i])
+            run++;
+        if (run >= 2)
+        {
+            *out++ = 0x80 | (run - 1);
+            *out++ = pixels[i] & 0xFF;
+            *out++ = pixels[i] >> 8;
+            i += run;
+            continue;
+        }
+
+        // 字面段延伸到下一个至少 2 连的游程之前
+        const uint32_t first = i++;
+        while (i < count && i - first < MAX_TOKEN && !(i + 1 < count && pixels[i + 1] == pixels[i]))
+            i++;
+        *out++ = i - first - 1;
+        for (uint32_t j = first; j < i; j++)
+        {
+            *out++ = pixels[j] & 0xFF;
+            *out++ = pixels[j] >> 8;
+        }
+    }
+    return out - start;
+}
+
+bool StripImage::expand(const uint8_t *in, uint32_t length, uint16_t *out, uint32_t pixels)
+{
+    // 任何越界（输入不足或输出溢出）都视为损坏，保证不会写出条带缓冲区
+    const uint8_t *end = in + length;
+    uint32_t produced = 0;
+    while (in < end)
+    {
+        const uint8_t control = *in++;
+        const uint32_t count = (control & 0x7F) + 1;
+        if (produced + count > pixels)
+            return false;
+
+        if (control & 0x80)
+        {
+            if (end - in < 2)
+                return false;
+            const uint16_t color = in[0] | (in[1] << 8);
+            in += 2;
+            for (uint32_t i = 0; i < count; i++)
+                out[produced + i] = color;
+        }
+        else
+        {
+            if (static_cast<uint32_t>(end - in) < count * 2)
+                return false;
+            for (uint32_t i = 0; i < count; i++, in += 2)
+                out[produced + i] = in[0] | (in[1] << 8);
+        }
+        produced += count;
+    }
+    return produced == pixels;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Arduino.h>
+#include "core/AssetStore.h"
+
+// 条带 RLE 图像（*.rle），由 tools/convert_backgrounds.py 从 WebP 等背景图生成。
+// 图像按 STRIP_ROWS 行切成条带，每条带独立做 RGB565 游程编码，并有偏移表可随机访问。
+// 解码器只常驻一个条带的压缩数据（大小由文件头给出），逐条带输出到调用方的缓冲区。
+class StripImage
+{
+public:
+    static constexpr uint32_t MAGIC = 0x35363553; // "S565"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t MAX_DIMENSION = 1024;
+    static constexpr uint32_t MAX_STRIP_BYTES = 16 * 1024;
+
+    StripImage() = default;
+    StripImage(const StripImage &) = delete;
+    StripImage &operator=(const StripImage &) = delete;
+    ~StripImage() { close(); }
+
+    bool open(AssetStore &assets, const char *path);
+    void close();
+
+    uint16_t width() const { return _header.width; }
+    uint16_t height() const { return _header.height; }
+    uint16_t stripRows() const { return _header.stripRows; }
+    uint16_t stripCount() const { return _header.stripCount; }
+    // 第 index 条带的实际行数（末条带可能不足 stripRows）
+    uint16_t rowsOf(uint16_t index) const;
+
+    // 把第 index 条带解码到 out（连续 width * rowsOf(index) 个像素）
+    bool decodeStrip(uint16_t index, uint16_t *out);
+
+    // 解码器自身持有的内存：偏移表 + 条带输入缓冲
+    size_t workingBytes() const;
+
+    // 条带的 RGB565 游程编码（与 tools/convert_backgrounds.py 相同）：控制字节最高位为 1 时后跟一个重复像素，
+    // 否则后跟若干字面像素，低 7 位为像素数减 1。expand 对越界输入一律返回 false
+    static uint32_t encode(const uint16_t *pixels, uint32_t count, uint8_t *out);
+    static uint32_t maxEncodedBytes(uint32_t pixels) { return pixels * 2 + (pixels + MAX_TOKEN - 1) / MAX_TOKEN; }
+    static bool expand(const uint8_t *in, uint32_t length, uint16_t *out, uint32_t pixels);
+
+private:
+#pragma pack(push, 1)
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t width;
+        uint16_t height;
+        uint16_t stripRows;
+        uint16_t stripCount;
+        uint16_t reserved;
+        uint32_t maxStripBytes;
+    };
+#pragma pack(pop)
+
+    AssetFile _file;
+    Header _header = {};
+    uint32_t *_offsets = nullptr;
+    uint8_t *_input = nullptr;
+    uint32_t _dataStart = 0;
+
+    static constexpr uint32_t MAX_TOKEN = 128;
+};
@@ -0,0 +1,198 @@
+#include "TextRenderer.h"
+#include "core/Log.h"
+
+namespace
+{
+constexpr uint32_t REPLACEMENT = 0xFFFD;
+
+// 取出下一个码位并前移指针；非法或被 end 截断的序列按单字节跳过并返回 U+FFFD
+uint32_t nextCodepoint(const uint8_t *&p, const uint8_t *end)
+{
+    const uint8_t lead = *p++;
+    if (lead < 0x80)
+        return lead;
+
+    uint8_t extra;
+    uint32_t cp;
+    if ((lead & 0xE0) == 0xC0)
+    {
+        extra = 1;
+        cp = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        extra = 2;
+        cp = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        extra = 3;
+        cp = lead & 0x07;
+    }
+    else
+    {
+        return REPLACEMENT;
+    }
+
+    if (end - p < extra)
+        return REPLACEMENT;
+    for (uint8_t i = 0; i < extra; i++)
+    {
+        if ((p[i] & 0xC0) != 0x80)
+            return REPLACEMENT;
+        cp = (cp << 6) | (p[i] & 0x3F);
+    }
+    p += extra;
+    return cp;
+}
+} // namespace
+
+void TextRenderer::begin(AssetStore &assets)
+{
+    _assets = &assets;
+}
+
+size_t TextRenderer::indexBytes() const
+{
+    size_t bytes = 0;
+    for (uint8_t i = 0; i < _fontCount; i++)
+        bytes += _fonts[i].pack.indexBytes();
+    return bytes;
+}
+
+int8_t TextRenderer::fontFor(StrView name)
+{
+    if (name.empty() || !_assets)
+        return -1;
+
+    for (uint8_t i = 0; i < _fontCount; i++)
+    {
+        if (_fonts[i].name == name)
+            return _fonts[i].failed ? -1 : static_cast<int8_t>(i);
+    }
+    if (_fontCount == MAX_FONTS || name.size() > MAX_NAME_BYTES)
+        return -1;
+
+    // 失败的结果也记下来，避免每帧重复访问文件系统
+    Font &font = _fonts[_fontCount];
+    font.name = name;
+    FilePath path = "/fonts/";
+    path.append(name);
+    font.failed = !path.append(".fnt") || !font.pack.open(*_assets, path.c_str());
+    if (!font.failed && !_cacheReady)
+        font.failed = !(_cacheReady = _cache.begin());
+
+    const uint8_t id = _fontCount++;
+    if (font.failed)
+    {
+        font.pack.close();
+        Log::printf("[字体] ⚠️ 字体 %s 不可用，使用内置 5x7 字体\n", font.name.c_str());
+        return -1;
+    }
+    Log::printf("[字体] ✅ 加载 %s: %u 字形, %upx\n", path.c_str(), font.pack.glyphCount(), font.pack.pixelSize());
+    return static_cast<int8_t>(id);
+}
+
+const GlyphCache::Glyph *TextRenderer::glyphFor(uint8_t font, uint32_t codepoint)
+{
+    const GlyphCache::Glyph *cached = _cache.find(font, codepoint);
+    if (cached)
+        return cached;
+
+    // 字体包未收录的码位以 '?' 的字形缓存，下次直接命中
+    FontPack &pack = _fonts[font].pack;
+    const FontPack::GlyphRecord *record = pack.find(codepoint);
+    if (!record)
+        record = pack.find('?');
+    if (record && FontPack::bitmapBytes(*record) > GlyphCache::SLOT_BYTES)
+        return nullptr;
+
+    uint8_t *slot = nullptr;
+    GlyphCache::Glyph *glyph = _cache.insert(font, codepoint, slot);
+    if (!record)
+    {
+        glyph->advance = pack.pixelSize() / 2;
+        return glyph;
+    }
+
+    glyph->advance = record->advance;
+    glyph->left = record->left;
+    glyph->top = record->top;
+    // 位图读取失败时只保留步进，字形画成空白
+    if (pack.readBitmap(*record, slot, GlyphCache::SLOT_BYTES))
+    {
+        glyph->width = record->width;
+        glyph->height = record->height;
+    }
+    return glyph;
+}
+
+bool TextRenderer::drawText(FrameBuffer &canvas, int16_t x, int16_t y, StrView text, StrView font, uint16_t color, uint16_t bg)
+{
+    const int8_t id = fontFor(font);
+    if (id < 0)
+        return false;
+
+    const uint32_t start = micros();
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(text.begin());
+    const uint8_t *end = reinterpret_cast<const uint8_t *>(text.end());
+    int16_t penX = x;
+    while (p < end)
+    {
+        const GlyphCache::Glyph *glyph = glyphFor(id, nextCodepoint(p, end));
+        if (!glyph)
+            continue;
+
+        if (glyph->width && glyph->height)
+            canvas.drawAlphaMask(penX + glyph->left, y + glyph->top, glyph->width, glyph->height, glyph->bitmap, color, bg);
+        penX += glyph->advance;
+        _glyphsDrawn++;
+    }
+    _lastDrawMicros = micros() - start;
+    return true;
+}
+
+int16_t TextRenderer::textWidth(StrView text, StrView font)
+{
+    const int8_t id = fontFor(font);
+    if (id < 0)
+        return -1;
+
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(text.begin());
+    const uint8_t *end = reinterpret_cast<const uint8_t *>(text.end());
+    int16_t width = 0;
+    while (p < end)
+    {
+        const GlyphCache::Glyph *glyph = glyphFor(id, nextCodepoint(p, end));
+        if (glyph)
+            width += glyph->advance;
+    }
+    return width;
+}
+
+bool TextRenderer::measureText(StrView text, StrView font, DirtyRect &bounds)
+{
+    const int8_t id = fontFor(font);
+    if (id < 0)
+        return false;
+
+    bounds = {INT16_MAX, INT16_MAX, INT16_MIN, INT16_MIN};
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(text.begin());
+    const uint8_t *end = reinterpret_cast<const uint8_t *>(text.end());
+    int16_t penX = 0;
+    while (p < end)
+    {
+        const GlyphCache::Glyph *glyph = glyphFor(id, nextCodepoint(p, end));
+        if (!glyph)
+            continue;
+        if (glyph->width && glyph->height)
+        {
+            bounds.x0 = min<int16_t>(bounds.x0, penX + glyph->left);
+            bounds.y0 = min<int16_t>(bounds.y0, glyph->top);
+            bounds.x1 = max<int16_t>(bounds.x1, penX + glyph->left + glyph->width - 1);
+            bounds.y1 = max<int16_t>(bounds.y1, glyph->top + glyph->height - 1);
+        }
+        penX += glyph->advance;
+    }
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Arduino.h>
+#include "core/AssetStore.h"
+#include "FontPack.h"
+#include "FrameBuffer.h"
+#include "GlyphCache.h"
+
+// UTF-8 文本渲染：按名称懒加载 /fonts/<name>.fnt 字体包，字形经 GlyphCache 缓存后以 4 位蒙版混合到画布。
+// 字体包不存在时 drawText 返回 false，由调用方退回内置 5x7 字体。
+class TextRenderer
+{
+public:
+    static constexpr uint8_t MAX_FONTS = 4;
+    // 字体名上限（UTF-8 字节），更长的名字视为不可用
+    static constexpr uint8_t MAX_NAME_BYTES = 15;
+
+    void begin(AssetStore &assets);
+
+    // (x, y) 为行框左上角；passthrough 模式下字形混合到底色 bg 上
+    bool drawText(FrameBuffer &canvas, int16_t x, int16_t y, StrView text, StrView font, uint16_t color, uint16_t bg);
+    // 文本的水平宽度（像素），字体不可用时返回 -1
+    int16_t textWidth(StrView text, StrView font);
+    // 文本墨迹相对 (x, y) 的包围盒（没有可见字形时 x0 > x1），字体不可用时返回 false
+    bool measureText(StrView text, StrView font, DirtyRect &bounds);
+
+    const GlyphCache &cache() const { return _cache; }
+    uint32_t glyphsDrawn() const { return _glyphsDrawn; }
+    uint32_t lastDrawMicros() const { return _lastDrawMicros; }
+    // 已加载字体包索引常驻内存的字节数
+    size_t indexBytes() const;
+
+private:
+    struct Font
+    {
+        FixedString<MAX_NAME_BYTES + 1> name;
+        FontPack pack;
+        bool failed = false;
+    };
+
+    AssetStore *_assets = nullptr;
+    Font _fonts[MAX_FONTS];
+    uint8_t _fontCount = 0;
+    GlyphCache _cache;
+    bool _cacheReady = false;
+
+    uint32_t _glyphsDrawn = 0;
+    uint32_t _lastDrawMicros = 0;
+
+    int8_t fontFor(StrView name);
+    const GlyphCache::Glyph *glyphFor(uint8_t font, uint32_t codepoint);
+};
@@ -1,12 +1,10 @@
 #include "TftDriver.h"
+#include "Font5x7.h"
 
 namespace
 {
 const uint16_t COLOR_WHITE = 0xFFFF;
-
-const uint8_t font5x7[] PROGMEM = {
-    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x5F,0x00,0x00,0x00,0x07,0x00,0x07,0x00,0x14,0x7F,0x14,0x7F,0x14,0x24,0x2A,0x7F,0x2A,0x12,0x23,0x13,0x08,0x64,0x62,0x36,0x49,0x55,0x22,0x50,0x00,0x05,0x03,0x00,0x00,0x00,0x1C,0x22,0x41,0x00,0x00,0x41,0x22,0x1C,0x00,0x14,0x08,0x3E,0x08,0x14,0x08,0x08,0x3E,0x08,0x08,0x00,0x50,0x30,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x00,0x60,0x60,0x00,0x00,0x20,0x10,0x08,0x04,0x02,0x3E,0x51,0x49,0x45,0x3E,0x00,0x42,0x7F,0x40,0x00,0x42,0x61,0x51,0x49,0x46,0x21,0x41,0x45,0x4B,0x31,0x18,0x14,0x12,0x7F,0x10,0x27,0x45,0x45,0x45,0x39,0x3C,0x4A,0x49,0x49,0x30,0x01,0x71,0x09,0x05,0x03,0x36,0x49,0x49,0x49,0x36,0x06,0x49,0x49,0x29,0x1E,0x00,0x36,0x36,0x00,0x00,0x00,0x56,0x36,0x00,0x00,0x08,0x14,0x22,0x41,0x00,0x14,0x14,0x14,0x14,0x14,0x00,0x41,0x22,0x14,0x08,0x02,0x01,0x51,0x09,0x06,0x32,0x49,0x79,0x41,0x3E,0x7E,0x11,0x11,0x11,0x7E,0x7F,0x49,0x49,0x49,0x36,0x3E,0x41,0x41,0x41,0x22,0x7F,0x41,0x41,0x22,0x1C,0x7F,0x49,0x49,0x49,0x41,0x7F,0x09,0x09,0x09,0x01,0x3E,0x41,0x49,0x49,0x7A,0x7F,0x08,0x08,0x08,0x7F,0x00,0x41,0x7F,0x41,0x00,0x20,0x40,0x41,0x3F,0x01,0x7F,0x08,0x14,0x22,0x41,0x7F,0x40,0x40,0x40,0x40,0x7F,0x02,0x0C,0x02,0x7F,0x7F,0x04,0x08,0x10,0x7F,0x3E,0x41,0x41,0x41,0x3E,0x7F,0x09,0x09,0x09,0x06,0x3E,0x41,0x51,0x21,0x5E,0x7F,0x09,0x19,0x29,0x46,0x46,0x49,0x49,0x49,0x31,0x01,0x01,0x7F,0x01,0x01,0x3F,0x40,0x40,0x40,0x3F,0x1F,0x20,0x40,0x20,0x1F,0x3F,0x40,0x38,0x40,0x3F,0x63,0x14,0x08,0x14,0x63,0x07,0x08,0x70,0x08,0x07,0x61,0x51,0x49,0x45,0x43,0x00,0x7F,0x41,0x41,0x00,0x02,0x04,0x08,0x10,0x20,0x00,0x41,0x41,0x7F,0x00,0x04,0x02,0x01,0x02,0x04,0x40,0x40,0x40,0x40,0x40,0x00,0x01,0x02,0x04,0x00,0x20,0x54,0x54,0x54,0x78,0x7F,0x48,0x44,0x44,0x38,0x38,0x44,0x44,0x44,0x20,0x38,0x44,0x44,0x48,0x7F,0x38,0x54,0x54,0x54,0x18,0x08,0x7E,0x09,0x01,0x02,0x0C,0x52,0x52,0x52,0x3E,0x7F,0x08,0x04,0x04,0x78,0x00,0x44,0x7D,0x40,0x00,0x20,0x40,0x44,0x3D,0x00,0x7F,0x10,0x28,0x44,0x00,0x00,0x41,0x7F,0x40,0x00,0x7C,0x04,0x18,0x04,0x78,0x7C,0x08,0x04,0x04,0x78,0x38,0x44,0x44,0x44,0x38,0x7C,0x14,0x14,0x14,0x08,0x08,0x14,0x14,0x18,0x7C,0x7C,0x08,0x04,0x04,0x08,0x48,0x54,0x54,0x54,0x20,0x04,0x3F,0x44,0x40,0x20,0x3C,0x40,0x40,0x20,0x7C,0x1C,0x20,0x40,0x20,0x1C,0x3C,0x40,0x30,0x40,0x3C,0x44,0x28,0x10,0x28,0x44,0x0C,0x50,0x50,0x50,0x3C,0x44,0x64,0x54,0x4C,0x44,0x00,0x08,0x36,0x41,0x00,0x00,0x00,0x7F,0x00,0x00,0x00,0x41,0x36,0x08,0x00,0x10,0x08,0x08,0x10,0x08,0x00,0x00,0x00,0x00,0x00
-};
+const uint32_t SPI_FREQUENCY = 40000000;
 
 template <typename T>
 void swapValue(T &a, T &b)
@@ -15,14 +13,41 @@ void swapValue(T &a, T &b)
     a = b;
     b = t;
 }
+
+// 屏幕按大端接收 RGB565，行缓冲中预先交换字节序，便于整块 writeBytes
+inline uint16_t toWireOrder(uint16_t color)
+{
+    return static_cast<uint16_t>((color >> 8) | (color << 8));
+}
 } // namespace
 
-TftDriver::TftDriver(uint8_t csPin, uint8_t dcPin, uint8_t rstPin, uint8_t mosiPin, uint8_t sclkPin)
+// C++17 之前静态 constexpr 成员被取地址或引用时需要类外定义
+#if __cplusplus < 201703L
+constexpr uint8_t St7789Panel::INIT[];
+constexpr uint8_t Ili9341Panel::INIT[];
+template <typename Traits>
+constexpr int16_t PanelDriver<Traits>::WIDTH;
+template <typename Traits>
+constexpr int16_t PanelDriver<Traits>::HEIGHT;
+template <typename Traits>
+constexpr uint16_t PanelDriver<Traits>::LINE_PIXELS;
+#endif
+
+template <typename Traits>
+PanelDriver<Traits>::PanelDriver(uint8_t csPin, uint8_t dcPin, uint8_t rstPin, uint8_t mosiPin, uint8_t sclkPin)
     : _cs(csPin), _dc(dcPin), _rst(rstPin), _mosi(mosiPin), _sclk(sclkPin), _spi(HSPI)
 {
 }
 
-void TftDriver::begin()
+template <typename Traits>
+void PanelDriver<Traits>::begin()
+{
+    beginAsleep();
+    wake();
+}
+
+template <typename Traits>
+void PanelDriver<Traits>::beginAsleep()
 {
     pinMode(_cs, OUTPUT);
     pinMode(_dc, OUTPUT);
@@ -33,103 +58,186 @@ void TftDriver::begin()
     digitalWrite(_rst, HIGH);
 
     _spi.begin(_sclk, -1, _mosi, _cs);
-    _spi.setFrequency(40000000);
+    _spi.setFrequency(SPI_FREQUENCY);
     _spi.setDataMode(SPI_MODE0);
     _spi.setBitOrder(MSBFIRST);
 
     tftInit();
+}
+
+template <typename Traits>
+void PanelDriver<Traits>::wake()
+{
+    // 复位后的等待与调用方写显存的时间重叠，只补足剩余部分
+    const uint32_t elapsed = millis() - _resetMillis;
+    if (elapsed < Traits::RESET_TO_SLEEP_OUT_MS)
+        delay(Traits::RESET_TO_SLEEP_OUT_MS - elapsed);
+
+    writeCommand(0x11);
+    delay(Traits::SLEEP_OUT_READY_MS);
+    writeCommand(0x29);
     Serial.println("[显示] TFT 初始化完成");
 }
 
-void TftDriver::writeCommand(uint8_t cmd)
+template <typename Traits>
+void PanelDriver<Traits>::startWrite()
+{
+    if (_writeDepth++ == 0)
+    {
+        _transactions++;
+        _spi.beginTransaction(SPISettings(SPI_FREQUENCY, MSBFIRST, SPI_MODE0));
+        digitalWrite(_cs, LOW);
+    }
+}
+
+template <typename Traits>
+void PanelDriver<Traits>::endWrite()
+{
+    if (_writeDepth == 0)
+        return;
+    if (--_writeDepth == 0)
+    {
+        digitalWrite(_cs, HIGH);
+        _spi.endTransaction();
+    }
+}
+
+template <typename Traits>
+void PanelDriver<Traits>::sendCommand(uint8_t cmd)
 {
     digitalWrite(_dc, LOW);
-    digitalWrite(_cs, LOW);
     _spi.transfer(cmd);
-    digitalWrite(_cs, HIGH);
+    digitalWrite(_dc, HIGH);
+    _bytesSent++;
 }
 
-void TftDriver::writeData(uint8_t data)
+template <typename Traits>
+void PanelDriver<Traits>::sendBytes(const uint8_t *data, uint32_t length)
 {
-    digitalWrite(_dc, HIGH);
-    digitalWrite(_cs, LOW);
-    _spi.transfer(data);
-    digitalWrite(_cs, HIGH);
+    _spi.writeBytes(data, length);
+    _bytesSent += length;
 }
 
-void TftDriver::writeData16(uint16_t data)
+template <typename Traits>
+void PanelDriver<Traits>::writeCommand(uint8_t cmd, const uint8_t *data, uint8_t length)
 {
-    digitalWrite(_dc, HIGH);
-    digitalWrite(_cs, LOW);
-    _spi.transfer16(data);
-    digitalWrite(_cs, HIGH);
+    startWrite();
+    sendCommand(cmd);
+    if (length)
+        sendBytes(data, length);
+    endWrite();
 }
 
-void TftDriver::tftInit()
+template <typename Traits>
+void PanelDriver<Traits>::tftInit()
 {
     digitalWrite(_rst, LOW);
-    delay(100);
+    delay(Traits::RESET_PULSE_MS);
     digitalWrite(_rst, HIGH);
-    delay(120);
-
-    writeCommand(0x3A);
-    writeData(0x05);
-    writeCommand(0xC5);
-    writeData(0x1A);
-    writeCommand(0x36);
-    writeData(0x00);
-
-    writeCommand(0xB2);
-    writeData(0x05);
-    writeData(0x05);
-    writeData(0x00);
-    writeData(0x33);
-    writeData(0x33);
-
-    writeCommand(0xB7);
-    writeData(0x05);
-    writeCommand(0xBB);
-    writeData(0x3F);
-    writeCommand(0xC0);
-    writeData(0x2C);
-    writeCommand(0xC2);
-    writeData(0x01);
-    writeCommand(0xC3);
-    writeData(0x0F);
-    writeCommand(0xC4);
-    writeData(0x20);
-    writeCommand(0xC6);
-    writeData(0x01);
-    writeCommand(0xD0);
-    writeData(0xA4);
-    writeData(0xA1);
-
-    writeCommand(0x20);
-    writeCommand(0x11);
-    delay(120);
-    writeCommand(0x29);
+    _resetMillis = millis();
+    delay(Traits::RESET_READY_MS);
+
+    const uint8_t *entry = Traits::INIT;
+    const uint8_t *end = Traits::INIT + sizeof(Traits::INIT);
+    while (entry < end)
+    {
+        const uint8_t length = entry[1] & ~Panel::DELAY;
+        writeCommand(entry[0], entry + 2, length);
+        const uint8_t *next = entry + 2 + length;
+        if (entry[1] & Panel::DELAY)
+            delay(*next++);
+        entry = next;
+    }
+    const uint8_t madctl = Geometry::MADCTL;
+    writeCommand(0x36, &madctl, 1);
 }
 
-void TftDriver::setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+template <typename Traits>
+void PanelDriver<Traits>::setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
-    writeCommand(0x2A);
-    writeData16((x0 << 8) | (x0 & 0xFF));
-    writeData16((x1 << 8) | (x1 & 0xFF));
+    // 偏移是编译期常量，为 0 时整段加法被优化掉
+    x0 += Geometry::COL_OFFSET;
+    x1 += Geometry::COL_OFFSET;
+    y0 += Geometry::ROW_OFFSET;
+    y1 += Geometry::ROW_OFFSET;
+    const uint8_t columns[4] = {
+        static_cast<uint8_t>(x0 >> 8), static_cast<uint8_t>(x0 & 0xFF),
+        static_cast<uint8_t>(x1 >> 8), static_cast<uint8_t>(x1 & 0xFF)};
+    const uint8_t rows[4] = {
+        static_cast<uint8_t>(y0 >> 8), static_cast<uint8_t>(y0 & 0xFF),
+        static_cast<uint8_t>(y1 >> 8), static_cast<uint8_t>(y1 & 0xFF)};
+
+    startWrite();
+    sendCommand(0x2A);
+    sendBytes(columns, sizeof(columns));
+    sendCommand(0x2B);
+    sendBytes(rows, sizeof(rows));
+    sendCommand(0x2C);
+    endWrite();
+}
+
+template <typename Traits>
+void PanelDriver<Traits>::pushBlock(uint16_t color, uint32_t count)
+{
+    if (count == 0)
+        return;
 
-    writeCommand(0x2B);
-    writeData16((y0 << 8) | (y0 & 0xFF));
-    writeData16((y1 << 8) | (y1 & 0xFF));
+    uint16_t *line = _lineBuffer[0];
+    const uint32_t filled = min<uint32_t>(count, LINE_PIXELS);
+    const uint16_t wire = toWireOrder(color);
+    for (uint32_t i = 0; i < filled; i++)
+        line[i] = wire;
 
-    writeCommand(0x2C);
+    startWrite();
+    while (count > 0)
+    {
+        const uint32_t n = min<uint32_t>(count, LINE_PIXELS);
+        sendBytes(reinterpret_cast<const uint8_t *>(line), n * sizeof(uint16_t));
+        count -= n;
+    }
+    endWrite();
 }
 
-void TftDriver::fillScreen(uint16_t color)
+template <typename Traits>
+void PanelDriver<Traits>::writePixels(const uint16_t *pixels, uint32_t count)
+{
+    // 两块行缓冲交替使用：一块在发送时准备另一块。
+    // Arduino 的 writeBytes 为阻塞实现，此时退化为顺序执行，但每行只有一次调用开销。
+    uint8_t slot = 0;
+    startWrite();
+    while (count > 0)
+    {
+        const uint32_t n = min<uint32_t>(count, LINE_PIXELS);
+        uint16_t *line = _lineBuffer[slot];
+        for (uint32_t i = 0; i < n; i++)
+            line[i] = toWireOrder(pixels[i]);
+        sendBytes(reinterpret_cast<const uint8_t *>(line), n * sizeof(uint16_t));
+        pixels += n;
+        count -= n;
+        slot ^= 1;
+    }
+    endWrite();
+}
+
+template <typename Traits>
+void PanelDriver<Traits>::fillScreen(uint16_t color)
 {
     fillRect(0, 0, WIDTH, HEIGHT, color);
 }
 
-void TftDriver::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+template <typename Traits>
+void PanelDriver<Traits>::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 {
+    if (x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        h += y;
+        y = 0;
+    }
     if (x >= WIDTH || y >= HEIGHT || w <= 0 || h <= 0)
         return;
     if (x + w > WIDTH)
@@ -137,26 +245,59 @@ void TftDriver::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t co
     if (y + h > HEIGHT)
         h = HEIGHT - y;
 
+    startWrite();
     setAddrWindow(x, y, x + w - 1, y + h - 1);
-    digitalWrite(_dc, HIGH);
-    digitalWrite(_cs, LOW);
-    for (uint32_t i = 0; i < static_cast<uint32_t>(w) * h; i++)
+    pushBlock(color, static_cast<uint32_t>(w) * h);
+    endWrite();
+}
+
+template <typename Traits>
+void PanelDriver<Traits>::pushImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pixels, int16_t stride)
+{
+    if (x < 0 || y < 0 || x + w > WIDTH || y + h > HEIGHT || w <= 0 || h <= 0)
+        return;
+
+    startWrite();
+    setAddrWindow(x, y, x + w - 1, y + h - 1);
+    if (stride == w)
     {
-        _spi.transfer16(color);
+        writePixels(pixels, static_cast<uint32_t>(w) * h);
     }
-    digitalWrite(_cs, HIGH);
+    else
+    {
+        for (int16_t row = 0; row < h; row++)
+            writePixels(pixels + static_cast<int32_t>(row) * stride, w);
+    }
+    endWrite();
 }
 
-void TftDriver::drawPixel(int16_t x, int16_t y, uint16_t color)
+template <typename Traits>
+void PanelDriver<Traits>::drawPixel(int16_t x, int16_t y, uint16_t color)
 {
     if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT)
         return;
+
+    const uint16_t wire = toWireOrder(color);
+    startWrite();
     setAddrWindow(x, y, x, y);
-    writeData16(color);
+    sendBytes(reinterpret_cast<const uint8_t *>(&wire), sizeof(wire));
+    endWrite();
 }
 
-void TftDriver::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+template <typename Traits>
+void PanelDriver<Traits>::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
 {
+    if (x0 == x1)
+    {
+        fillRect(x0, min(y0, y1), 1, abs(y1 - y0) + 1, color);
+        return;
+    }
+    if (y0 == y1)
+    {
+        fillRect(min(x0, x1), y0, abs(x1 - x0) + 1, 1, color);
+        return;
+    }
+
     int16_t steep = abs(y1 - y0) > abs(x1 - x0);
     if (steep)
     {
@@ -174,58 +315,95 @@ void TftDriver::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_
     int16_t err = dx / 2;
     int16_t ystep = (y0 < y1) ? 1 : -1;
 
+    // 同一行（或列）上连续的像素合并为一次开窗 + 连续填充
+    startWrite();
+    int16_t runStart = x0;
     for (; x0 <= x1; x0++)
     {
-        if (steep)
-            drawPixel(y0, x0, color);
-        else
-            drawPixel(x0, y0, color);
         err -= dy;
+        if (err < 0 || x0 == x1)
+        {
+            if (steep)
+                fillRect(y0, runStart, 1, x0 - runStart + 1, color);
+            else
+                fillRect(runStart, y0, x0 - runStart + 1, 1, color);
+            runStart = x0 + 1;
+        }
         if (err < 0)
         {
             y0 += ystep;
             err += dx;
         }
     }
+    endWrite();
 }
 
-void TftDriver::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+template <typename Traits>
+void PanelDriver<Traits>::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 {
-    drawLine(x, y, x + w - 1, y, color);
-    drawLine(x, y + h - 1, x + w - 1, y + h - 1, color);
-    drawLine(x, y, x, y + h - 1, color);
-    drawLine(x + w - 1, y, x + w - 1, y + h - 1, color);
+    startWrite();
+    fillRect(x, y, w, 1, color);
+    fillRect(x, y + h - 1, w, 1, color);
+    fillRect(x, y, 1, h, color);
+    fillRect(x + w - 1, y, 1, h, color);
+    endWrite();
 }
 
-void TftDriver::drawChar5x7(int16_t x, int16_t y, char c, uint16_t color, uint8_t size)
+template <typename Traits>
+void PanelDriver<Traits>::drawChar5x7(int16_t x, int16_t y, char c, uint16_t color, uint8_t size)
 {
-    if (c < 32 || c > 127)
-        c = '?';
-
-    uint16_t idx = (c - 32) * 5;
-    for (uint8_t i = 0; i < 5; i++)
+    if (size <= Font5x7::MAX_MASK_SIZE)
     {
-        uint8_t line = pgm_read_byte(font5x7 + idx + i);
-        for (uint8_t j = 0; j < 8; j++)
+        // 按行取放大后的掩码，连续的点合并成一段横线
+        const uint8_t rows = Font5x7::GLYPH_HEIGHT * size;
+        for (uint8_t row = 0; row < rows; row++)
         {
-            if (line & 0x1)
+            uint32_t mask = Font5x7::rowMask(c, size, row);
+            uint8_t col = 0;
+            while (mask)
             {
-                if (size == 1)
-                    drawPixel(x + i, y + j, color);
-                else
-                    fillRect(x + i * size, y + j * size, size, size, color);
+                while (!(mask & 0x1))
+                {
+                    mask >>= 1;
+                    col++;
+                }
+                uint8_t run = 0;
+                while (mask & 0x1)
+                {
+                    mask >>= 1;
+                    run++;
+                }
+                fillRect(x + col, y + row, run, 1, color);
+                col += run;
             }
+        }
+        return;
+    }
+
+    for (uint8_t i = 0; i < Font5x7::GLYPH_WIDTH; i++)
+    {
+        uint8_t line = Font5x7::column(c, i);
+        for (uint8_t j = 0; j < Font5x7::GLYPH_HEIGHT; j++)
+        {
+            if (line & 0x1)
+                fillRect(x + i * size, y + j * size, size, size, color);
             line >>= 1;
         }
     }
 }
 
-void TftDriver::drawText(int16_t x, int16_t y, const String &text, uint16_t color, uint8_t size)
+template <typename Traits>
+void PanelDriver<Traits>::drawText(int16_t x, int16_t y, StrView text, uint16_t color, uint8_t size)
 {
+    startWrite();
     int16_t cursor = x;
     for (size_t i = 0; i < text.length(); i++)
     {
         drawChar5x7(cursor, y, text[i], color, size);
-        cursor += 6 * size;
+        cursor += Font5x7::ADVANCE * size;
     }
+    endWrite();
 }
+
+template class PanelDriver<St7789Panel>;
+template class PanelDriver<Ili9341Panel>;
@@ -2,24 +2,59 @@
 
 #include <Arduino.h>
 #include <SPI.h>
+#include "PanelTraits.h"
+#include "core/FixedString.h"
 
-class TftDriver
+// SPI 屏驱动，按面板特性（PanelTraits.h）在编译期特化：尺寸、窗口偏移、MADCTL 与初始化表都是常量，
+// 裁剪与开窗计算在编译时折叠，换面板不会在绘制路径上引入运行时分支。
+// 成员定义在 TftDriver.cpp 中，对已知面板显式实例化；固件用的是 TftDriver（即 ActivePanel 的特化）。
+template <typename Traits>
+class PanelDriver
 {
 public:
-    static constexpr int16_t WIDTH = 240;
-    static constexpr int16_t HEIGHT = 320;
+    typedef Panel::Geometry<Traits> Geometry;
+    static constexpr int16_t WIDTH = Geometry::WIDTH;
+    static constexpr int16_t HEIGHT = Geometry::HEIGHT;
+    static constexpr uint16_t LINE_PIXELS = WIDTH > HEIGHT ? WIDTH : HEIGHT;
+    static constexpr size_t INIT_COMMANDS = Panel::initCommands(Traits::INIT, sizeof(Traits::INIT));
 
-    TftDriver(uint8_t csPin, uint8_t dcPin, uint8_t rstPin, uint8_t mosiPin, uint8_t sclkPin);
+    static_assert(Panel::validInit(Traits::INIT, sizeof(Traits::INIT)), "panel init table is truncated");
+    static_assert(Geometry::COL_OFFSET + WIDTH <= (Geometry::SWAPPED ? Traits::GRAM_HEIGHT : Traits::GRAM_WIDTH) &&
+                      Geometry::ROW_OFFSET + HEIGHT <= (Geometry::SWAPPED ? Traits::GRAM_WIDTH : Traits::GRAM_HEIGHT),
+                  "panel glass does not fit its GRAM");
+
+    PanelDriver(uint8_t csPin, uint8_t dcPin, uint8_t rstPin, uint8_t mosiPin, uint8_t sclkPin);
 
     void begin();
+    // 分两步启动：beginAsleep() 复位并写好寄存器，面板仍在睡眠、不显示；此时已可写入显存（开机快照），
+    // wake() 再退出睡眠并打开显示，第一帧可见画面就是预先写入的内容
+    void beginAsleep();
+    void wake();
 
     void fillScreen(uint16_t color);
     void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
     void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
     void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
     void drawPixel(int16_t x, int16_t y, uint16_t color);
+    // 把 w*h 的像素块（行跨度 stride 个像素）推送到屏幕 (x, y) 处，整块必须落在屏内
+    void pushImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pixels, int16_t stride);
+
+    void drawText(int16_t x, int16_t y, StrView text, uint16_t color, uint8_t size);
+
+    // 流式写入接口：startWrite() 拉低 CS 后可多次开窗并连续推送像素，endWrite() 结束。
+    // 支持嵌套调用，只有最外层会真正切换 CS。
+    void startWrite();
+    void endWrite();
+    void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+    // 向当前窗口重复写入 count 个同色像素
+    void pushBlock(uint16_t color, uint32_t count);
+    // 向当前窗口写入 count 个像素（本机字节序的 RGB565）
+    void writePixels(const uint16_t *pixels, uint32_t count);
 
-    void drawText(int16_t x, int16_t y, const String &text, uint16_t color, uint8_t size);
+    // 累计经 SPI 发出的字节数（命令 + 数据），用于统计单帧刷新量
+    uint32_t bytesSent() const { return _bytesSent; }
+    // 累计 SPI 事务数（最外层 startWrite 拉低 CS 的次数）
+    uint32_t transactions() const { return _transactions; }
 
 private:
     uint8_t _cs;
@@ -28,11 +63,21 @@ private:
     uint8_t _mosi;
     uint8_t _sclk;
     SPIClass _spi;
+    uint32_t _bytesSent = 0;
+    uint32_t _transactions = 0;
+    uint8_t _writeDepth = 0;
+    uint32_t _resetMillis = 0;
+    uint16_t _lineBuffer[2][LINE_PIXELS];
 
     void tftInit();
-    void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
-    void writeCommand(uint8_t cmd);
-    void writeData(uint8_t data);
-    void writeData16(uint16_t data);
+    void sendCommand(uint8_t cmd);
+    void sendBytes(const uint8_t *data, uint32_t length);
+    // 命令与参数在同一次片选内连续发送
+    void writeCommand(uint8_t cmd, const uint8_t *data = nullptr, uint8_t length = 0);
     void drawChar5x7(int16_t x, int16_t y, char c, uint16_t color, uint8_t size);
 };
+
+extern template class PanelDriver<St7789Panel>;
+extern template class PanelDriver<Ili9341Panel>;
+
+typedef PanelDriver<ActivePanel> TftDriver;
@@ -0,0 +1,208 @@
+#include "ButtonGestures.h"
+
+namespace
+{
+constexpr uint32_t US_PER_MS = 1000;
+
+// 32 位微秒时间戳约 71 分钟回绕一次，按差值的符号比较先后
+bool reached(uint32_t t, uint32_t deadline)
+{
+    return static_cast<int32_t>(t - deadline) >= 0;
+}
+} // namespace
+
+ButtonGestures::Config ButtonGestures::defaultConfig()
+{
+    Config config;
+    config.debounceMs = 20;
+    config.longPressMs = 600;
+    config.repeatMs = 400;
+    config.doubleClickMs = 250;
+    return config;
+}
+
+void ButtonGestures::setHandler(Handler handler, void *context)
+{
+    _handler = handler;
+    _context = context;
+}
+
+bool IRAM_ATTR ButtonGestures::pushEdgeFromISR(bool pressed, uint32_t micros)
+{
+    const Edge edge = {micros, pressed};
+    if (_edges.push(edge))
+        return true;
+    _edgesDropped = _edgesDropped + 1;
+    return false;
+}
+
+void ButtonGestures::feed(bool pressed, uint32_t micros)
+{
+    _now = micros;
+    drain();
+    const Edge edge = {micros, pressed};
+    process(edge);
+}
+
+void ButtonGestures::poll(uint32_t now)
+{
+    _now = now;
+    drain();
+    advance(now);
+}
+
+void ButtonGestures::inject(Gesture gesture, uint32_t micros, uint32_t now)
+{
+    _now = now;
+    emit(gesture, 1, micros, micros);
+}
+
+uint32_t ButtonGestures::microsUntilDeadline(uint32_t now) const
+{
+    uint32_t wait = NO_DEADLINE;
+    if (_locked)
+        wait = reached(now, _lockoutEnd) ? 0 : _lockoutEnd - now;
+    if (hasDeadline())
+        wait = min(wait, reached(now, _deadline) ? 0 : _deadline - now);
+    return wait;
+}
+
+ButtonGestures::Stats ButtonGestures::stats() const
+{
+    Stats stats;
+    stats.edges = _edgeCount;
+    stats.bounces = _bounces;
+    stats.edgesDropped = _edgesDropped;
+    stats.gestures = _gestures;
+    stats.lastLatencyMicros = _lastLatency;
+    stats.maxLatencyMicros = _maxLatency;
+    stats.avgLatencyMicros = _gestures ? static_cast<uint32_t>(_latencyTotal / _gestures) : 0;
+    return stats;
+}
+
+void ButtonGestures::drain()
+{
+    Edge edge;
+    while (_edges.pop(edge))
+        process(edge);
+}
+
+void ButtonGestures::process(const Edge &edge)
+{
+    // 先把边沿之前到期的超时处理完，状态机始终按时间顺序推进
+    advance(edge.micros);
+    _edgeCount++;
+    _raw = edge.pressed;
+    if (_locked)
+    {
+        _bounces++;
+        return;
+    }
+    if (edge.pressed != _stable)
+        accept(edge.pressed, edge.micros);
+}
+
+void ButtonGestures::advance(uint32_t t)
+{
+    for (;;)
+    {
+        const bool settle = _locked && reached(t, _lockoutEnd);
+        const bool timeout = hasDeadline() && reached(t, _deadline);
+        if (!settle && !timeout)
+            return;
+
+        if (settle && (!timeout || reached(_deadline, _lockoutEnd)))
+        {
+            // 锁定结束时电平已与稳定值不同，说明抖动中夹着一次真实的翻转
+            _locked = false;
+            if (_raw != _stable)
+                accept(_raw, _lockoutEnd);
+        }
+        else
+        {
+            onDeadline();
+        }
+    }
+}
+
+void ButtonGestures::accept(bool pressed, uint32_t t)
+{
+    _stable = pressed;
+    _locked = true;
+    _lockoutEnd = t + _config.debounceMs * US_PER_MS;
+
+    if (pressed)
+    {
+        if (_state == State::Idle)
+        {
+            _state = State::Pressed;
+            _pressAt = t;
+            _deadline = t + _config.longPressMs * US_PER_MS;
+        }
+        else if (_state == State::WaitSecond)
+        {
+            _state = State::WaitRelease;
+            emit(Gesture::DoubleClick, 1, t, t);
+        }
+        return;
+    }
+
+    if (_state == State::Pressed && _config.doubleClickMs)
+    {
+        _state = State::WaitSecond;
+        _deadline = t + _config.doubleClickMs * US_PER_MS;
+        return;
+    }
+    const bool shortPress = _state == State::Pressed;
+    _state = State::Idle;
+    if (shortPress)
+        emit(Gesture::ShortPress, 1, _pressAt, t);
+}
+
+void ButtonGestures::onDeadline()
+{
+    const uint32_t at = _deadline;
+    switch (_state)
+    {
+    case State::Pressed:
+        _repeats = 0;
+        if (_config.repeatMs)
+        {
+            _state = State::Held;
+            _deadline = at + _config.repeatMs * US_PER_MS;
+        }
+        else
+        {
+            _state = State::WaitRelease;
+        }
+        emit(Gesture::LongPress, 1, _pressAt, at);
+        break;
+    case State::Held:
+        _deadline = at + _config.repeatMs * US_PER_MS;
+        if (_repeats < 255)
+            _repeats++;
+        emit(Gesture::Repeat, _repeats, _pressAt, at);
+        break;
+    case State::WaitSecond:
+        _state = State::Idle;
+        emit(Gesture::ShortPress, 1, _pressAt, at);
+        break;
+    default:
+        break;
+    }
+}
+
+void ButtonGestures::emit(Gesture gesture, uint8_t count, uint32_t pressMicros, uint32_t micros)
+{
+    // 补处理的边沿（例如渲染期间积压的）确认时刻早于 _now，差值即处理延迟
+    const uint32_t latency = reached(_now, micros) ? _now - micros : 0;
+    _lastLatency = latency;
+    _maxLatency = max(_maxLatency, latency);
+    _latencyTotal += latency;
+    _gestures++;
+
+    if (!_handler)
+        return;
+    const Event event = {gesture, count, pressMicros, micros};
+    _handler(event, _context);
+}
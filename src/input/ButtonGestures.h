@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Arduino.h>
+#include "core/SpscQueue.h"
+
+// 按键手势识别：中断只把带时间戳的边沿压进无锁环形队列，任务里的状态机完成消抖，
+// 识别短按、长按、长按连发与双击后回调处理函数。
+// 时间全部由调用方传入，主机端可以用合成的边沿序列逐微秒复现。
+class ButtonGestures
+{
+public:
+    static constexpr uint8_t EDGE_QUEUE = 32;
+    static constexpr uint32_t NO_DEADLINE = 0xFFFFFFFFu;
+
+    enum class Gesture : uint8_t
+    {
+        ShortPress,
+        LongPress,
+        Repeat,
+        DoubleClick,
+    };
+
+    struct Config
+    {
+        // 接受一个边沿后锁定的时长，期间的抖动只记录电平，锁定结束时再与稳定电平比对
+        uint16_t debounceMs;
+        uint16_t longPressMs;
+        // 长按后继续按住的连发间隔，0 为不连发
+        uint16_t repeatMs;
+        // 松开后等待第二次按下的窗口，0 为关闭双击（短按在松开时立即触发）
+        uint16_t doubleClickMs;
+    };
+
+    struct Event
+    {
+        Gesture gesture;
+        uint8_t count;        // 连发序号，从 1 开始；其余手势为 1
+        uint32_t pressMicros; // 本次手势的按下时刻
+        uint32_t micros;      // 手势被确认的时刻（边沿或超时）
+    };
+    typedef void (*Handler)(const Event &event, void *context);
+
+    struct Stats
+    {
+        uint32_t edges;
+        uint32_t bounces;      // 锁定期内被滤掉的边沿
+        uint32_t edgesDropped; // 队列满时丢弃
+        uint32_t gestures;
+        uint32_t lastLatencyMicros; // 手势确认到处理函数执行
+        uint32_t maxLatencyMicros;
+        uint32_t avgLatencyMicros;
+    };
+
+    static Config defaultConfig();
+
+    explicit ButtonGestures(const Config &config = defaultConfig()) : _config(config) {}
+
+    void setHandler(Handler handler, void *context = nullptr);
+
+    // 只能在中断里调用（单生产者）；pressed 为中断时刻读到的按下电平
+    bool IRAM_ATTR pushEdgeFromISR(bool pressed, uint32_t micros);
+    // 在任务里直接送入一个边沿（例如被唤醒源吞掉的按下沿），先处理队列里更早的边沿
+    void feed(bool pressed, uint32_t micros);
+    // 处理队列中的边沿与到 now 为止的超时；处理函数在这里被调用
+    void poll(uint32_t now);
+    // 串口等其他输入源复用同一条手势处理路径
+    void inject(Gesture gesture, uint32_t micros, uint32_t now);
+
+    // 距下一个超时（消抖结束、长按、连发、双击窗口）的微秒数；没有时为 NO_DEADLINE
+    uint32_t microsUntilDeadline(uint32_t now) const;
+    bool isPressed() const { return _stable; }
+
+    Stats stats() const;
+
+private:
+    enum class State : uint8_t
+    {
+        Idle,
+        Pressed,
+        Held,
+        WaitSecond,
+        WaitRelease,
+    };
+
+    struct Edge
+    {
+        uint32_t micros;
+        bool pressed;
+    };
+
+    Config _config;
+    Handler _handler = nullptr;
+    void *_context = nullptr;
+
+    SpscQueue<Edge, EDGE_QUEUE> _edges;
+    bool _raw = false;
+    bool _stable = false;
+    bool _locked = false;
+    uint32_t _lockoutEnd = 0;
+
+    State _state = State::Idle;
+    uint32_t _pressAt = 0;
+    uint32_t _deadline = 0;
+    uint8_t _repeats = 0;
+    uint32_t _now = 0;
+
+    uint32_t _edgeCount = 0;
+    uint32_t _bounces = 0;
+    volatile uint32_t _edgesDropped = 0;
+    uint32_t _gestures = 0;
+    uint32_t _lastLatency = 0;
+    uint32_t _maxLatency = 0;
+    uint64_t _latencyTotal = 0;
+
+    bool hasDeadline() const { return _state == State::Pressed || _state == State::Held || _state == State::WaitSecond; }
+    void drain();
+    void process(const Edge &edge);
+    void advance(uint32_t t);
+    void accept(bool pressed, uint32_t t);
+    void onDeadline();
+    void emit(Gesture gesture, uint8_t count, uint32_t pressMicros, uint32_t micros);
+};
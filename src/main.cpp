@@ -1,31 +1,452 @@
 #include <Arduino.h>
 #include <SPIFFS.h>
+#include <Wire.h>
+#include <driver/gpio.h>
+#include <driver/uart.h>
+#include <esp_sleep.h>
 
+#include "core/AllocCounter.h"
+#include "core/AssetStore.h"
+#include "core/Log.h"
+#include "core/Profiler.h"
+#include "core/Scheduler.h"
+#include "display/BootSnapshot.h"
+#include "display/FrameBuffer.h"
 #include "display/TftDriver.h"
+#include "input/ButtonGestures.h"
+#include "sensors/HistoryLog.h"
+#include "sensors/I2cSensors.h"
+#include "sensors/SensorHistory.h"
+#include "sensors/SensorHub.h"
 #include "theme/ThemeManager.h"
 #include "ui/DashboardRenderer.h"
+#include "ui/RenderPipeline.h"
+#include "ui/Sparkline.h"
 
 namespace
 {
+#if defined(PANEL_ILI9341)
+// README 引脚定义中 ILI9341 模块的接线
+constexpr uint8_t TFT_CS = 10;
+constexpr uint8_t TFT_DC = 18;
+constexpr uint8_t TFT_RST = 17;
+constexpr uint8_t TFT_MOSI = 11;
+constexpr uint8_t TFT_SCLK = 12;
+constexpr uint8_t I2C_SDA = 8;
+constexpr uint8_t I2C_SCL = 9;
+#else
 constexpr uint8_t TFT_CS = 8;
 constexpr uint8_t TFT_DC = 9;
 constexpr uint8_t TFT_RST = 10;
 constexpr uint8_t TFT_MOSI = 11;
 constexpr uint8_t TFT_SCLK = 12;
+// 当前接线的屏幕占用了 GPIO8/9，I2C 改接到空闲的 GPIO38/39
+constexpr uint8_t I2C_SDA = 38;
+constexpr uint8_t I2C_SCL = 39;
+#endif
 constexpr uint8_t THEME_SWITCH_BUTTON = 0;
 
+// 静态数据演示：每 10 秒更新时间文本（便于看到配置和刷新流程）
+constexpr uint32_t CLOCK_REFRESH_MS = 10000;
+// 显示秒时改为每秒走一秒；冒号每 500 ms 闪烁一次（只重画冒号格）
+constexpr bool CLOCK_SHOW_SECONDS = false;
+constexpr bool CLOCK_BLINK_COLON = true;
+constexpr uint32_t COLON_BLINK_MS = 500;
+// 短按/双击切换主题时的过渡动画；按住连续切换时不播放
+constexpr ThemeTransition::Effect SWITCH_TRANSITION = ThemeTransition::Effect::Crossfade;
+// 主题文件监视：定期比较索引与当前主题文件的大小/修改时间，变化时自动热重载（只重画差异区域）
+constexpr bool ENABLE_THEME_WATCH = true;
+constexpr uint32_t THEME_WATCH_MS = 1000;
+// 渲染在途或主题写入待落盘时的轮询间隔
+constexpr uint32_t HOUSEKEEPING_MS = 20;
+// 开机快照：切换/重载主题（以及开机后第一帧）之后画面稳定这么久才擦写闪存，连续切换只保存最后一套
+constexpr bool ENABLE_BOOT_SNAPSHOT = true;
+constexpr uint32_t SNAPSHOT_SETTLE_MS = 3000;
+// 启动到快照上屏的目标耗时，超出时告警
+constexpr uint32_t BOOT_FIRST_PIXEL_BUDGET_MS = 300;
+// 距下一个截止时刻不少于此值且渲染空闲时进入 light sleep；串口唤醒会丢掉首个字符
+constexpr bool ENABLE_LIGHT_SLEEP = true;
+constexpr uint32_t LIGHT_SLEEP_MIN_US = 50000;
+// 环境传感器：AHT20/BMP280/BH1750 共用 I2C 总线，在独立任务里采样，显示值变化时才刷新温湿度与气压文本
+constexpr bool ENABLE_SENSORS = true;
+constexpr uint32_t I2C_FREQ_HZ = 400000;
+// 环境历史：读数汇总成 1 小时原始 / 24 小时分钟 / 7 天 15 分钟三层，温湿度与气压文字右侧画迷你图
+// （默认 24 小时，串口 h 切换到 7 天），每关闭一个 15 分钟槽向 history 分区追加一段
+constexpr bool ENABLE_HISTORY = true;
+constexpr uint32_t HISTORY_TICK_MS = 10000;
+// 迷你图纵轴的最小跨度（温度 °C、湿度 %、气压 hPa），平稳时不把噪声放大成满幅锯齿
+constexpr float CHART_MIN_RANGE[EnvCharts::COUNT] = {2.0f, 5.0f, 2.0f};
+
+enum AppEvent : uint8_t
+{
+    EVENT_BUTTON_EDGE = 1,
+    EVENT_SERIAL_RX = 2,
+    EVENT_SENSOR_SAMPLE = 3,
+};
+
 TftDriver g_display(TFT_CS, TFT_DC, TFT_RST, TFT_MOSI, TFT_SCLK);
+FrameBuffer g_canvas(g_display);
 ThemeManager g_themeManager;
-DashboardRenderer g_renderer(g_display);
+DashboardRenderer g_renderer(g_canvas);
+RenderPipeline g_pipeline(g_renderer);
+Scheduler g_scheduler;
+ButtonGestures g_buttons;
+BootSnapshot g_snapshot;
+Aht20Sensor g_aht20(Wire);
+Bmp280Sensor g_bmp280(Wire);
+Bh1750Sensor g_bh1750(Wire);
+SensorHub g_sensors;
+// 光照暂不上屏，只在统计里显示
+float g_illuminance = -1;
+SensorHistory g_history;
+HistoryLog g_historyLog;
+SparklinePlotter g_plotter;
+EnvCharts g_charts;
+// 迷你图显示 7 天（15 分钟层）而不是 24 小时（分钟层）
+bool g_chartWeek = false;
+// 历史有了新点，下次刷新时重新降采样
+bool g_chartsStale = true;
+bool g_historySavePending = false;
+
+Scheduler::TimerId g_buttonTimer = Scheduler::NO_TIMER;
+Scheduler::TimerId g_housekeepingTimer = Scheduler::NO_TIMER;
+Scheduler::TimerId g_snapshotTimer = Scheduler::NO_TIMER;
+
+// 启动计时：快照上屏与第一帧实时画面推送完成的时刻（均从上电起算）
+uint32_t g_bootFirstPixelMs = 0;
+uint32_t g_bootSubmitMicros = 0;
+bool g_bootLive = false;
+
+void onSnapshotTimer(void *)
+{
+    // 渲染任务还在刷屏时前台缓冲会变，稍后再试
+    if (!g_pipeline.idle())
+    {
+        g_snapshotTimer = g_scheduler.startOneShot(HOUSEKEEPING_MS, onSnapshotTimer);
+        return;
+    }
+    g_snapshot.save(g_canvas, g_themeManager.currentThemeNumber());
+}
+
+void scheduleSnapshot()
+{
+    if (ENABLE_BOOT_SNAPSHOT && !g_scheduler.restart(g_snapshotTimer, SNAPSHOT_SETTLE_MS))
+        g_snapshotTimer = g_scheduler.startOneShot(SNAPSHOT_SETTLE_MS, onSnapshotTimer);
+}
+
+void logBootLive()
+{
+    g_bootLive = true;
+    const uint32_t liveMs = (g_bootSubmitMicros + g_pipeline.stats().lastLatencyMicros) / 1000;
+    if (!g_bootFirstPixelMs)
+        g_bootFirstPixelMs = liveMs;
+    Log::printf("[启动] ✅ 实时画面: 启动后 %u ms（首个像素 %u ms）\n", liveMs, g_bootFirstPixelMs);
+    scheduleSnapshot();
+}
+
+void onHousekeeping(void *)
+{
+    g_pipeline.service();
+    g_themeManager.service();
+    if (!g_bootLive && g_pipeline.stats().rendered)
+        logBootLive();
+    if (!g_pipeline.idle() || g_themeManager.persistence().pending())
+        g_housekeepingTimer = g_scheduler.startOneShot(HOUSEKEEPING_MS, onHousekeeping);
+}
+
+void scheduleHousekeeping()
+{
+    if (!g_scheduler.isActive(g_housekeepingTimer))
+        g_housekeepingTimer = g_scheduler.startOneShot(HOUSEKEEPING_MS, onHousekeeping);
+}
+
+// millis() 约 49.7 天回绕一次，累加差值得到不回绕的开机秒数；HISTORY_TICK_MS 保证调用足够频繁
+uint32_t uptimeSeconds()
+{
+    static uint32_t lastMs = 0;
+    static uint64_t totalMs = 0;
+    const uint32_t nowMs = millis();
+    totalMs += nowMs - lastMs;
+    lastMs = nowMs;
+    return static_cast<uint32_t>(totalMs / 1000);
+}
+
+SensorHistory::Tier chartTier()
+{
+    return g_chartWeek ? SensorHistory::Tier::Quarter : SensorHistory::Tier::Minute;
+}
+
+// 按当前主题重新排布迷你图；版式变了（切换主题、读数位数变化）或历史有新点时才解码历史并降采样。
+// 返回图表内容是否变化。只显示文本里确实是读数的行，天气描述、预报区间旁边不画
+bool refreshCharts()
+{
+    if (!g_history.ready())
+        return false;
+
+    bool changed = false;
+    const SensorHistory::Tier tier = chartTier();
+    const uint16_t count = SensorHistory::pointsOf(tier);
+    for (uint8_t i = 0; i < EnvCharts::COUNT; i++)
+    {
+        Sparkline &line = g_charts.lines[i];
+        Sparkline layout;
+        SparklinePlotter::layout(g_themeManager.theme(), i, layout);
+        if (!g_themeManager.showsSensor(static_cast<Quantity>(i)))
+            layout.width = 0;
+        const bool moved = layout.x != line.x || layout.y != line.y || layout.width != line.width || layout.height != line.height;
+        if (!moved && !g_chartsStale)
+            continue;
+
+        if (layout.width)
+        {
+            g_history.read(tier, i, count, g_plotter.points());
+            g_plotter.plot(count, CHART_MIN_RANGE[i], layout);
+        }
+        if (layout != line)
+        {
+            line = layout;
+            changed = true;
+        }
+    }
+    g_chartsStale = false;
+    return changed;
+}
+
+// 把当前主题的快照交给渲染任务，立即返回；inputMicros 为触发本次刷新的输入时刻
+void renderCurrentTheme(uint32_t inputMicros, ThemeTransition::Effect transition = ThemeTransition::Effect::None)
+{
+    refreshCharts();
+    g_pipeline.submit(g_themeManager.theme(), g_themeManager.currentThemeNumber(), inputMicros, false, transition, &g_charts);
+    scheduleHousekeeping();
+}
+
+// 推进历史时钟：图表所用的层有新点时标记重算，关闭了 15 分钟槽时在渲染空闲时落盘。返回迷你图是否变化
+bool serviceHistory()
+{
+    const uint8_t closed = g_history.advance(uptimeSeconds());
+    if (closed & (1 << static_cast<uint8_t>(chartTier())))
+        g_chartsStale = true;
+    if (closed & (1 << static_cast<uint8_t>(SensorHistory::Tier::Quarter)))
+        g_historySavePending = true;
+    // 擦写闪存会暂停两个核的缓存，等渲染任务空闲；没赶上的段下次补写
+    if (g_historySavePending && g_pipeline.idle())
+    {
+        g_historyLog.save(g_history);
+        g_historySavePending = false;
+    }
+    return g_chartsStale && refreshCharts();
+}
+
+void printStats()
+{
+    const RenderPipeline::Stats render = g_pipeline.stats();
+    Log::printf("[渲染] 投递 %u 帧, 渲染 %u 帧, 合并 %u, 丢弃 %u, 队列 %u/%u (峰值 %u), 延迟 %u us (平均 %u, 最大 %u)\n",
+                render.submitted, render.rendered, render.merged, render.dropped, static_cast<unsigned>(g_pipeline.queueDepth()),
+                static_cast<unsigned>(RenderPipeline::QUEUE_DEPTH), render.maxQueueDepth, render.lastLatencyMicros,
+                render.avgLatencyMicros, render.maxLatencyMicros);
+
+    const Scheduler::Stats sched = g_scheduler.stats();
+    Log::printf("[调度] 定时器触发 %u 次, 事件 %u 个 (丢弃 %u), 抖动 平均 %u us / 最大 %u us, 空闲 %u%%\n", sched.timersFired,
+                sched.eventsDispatched, sched.eventsDropped, sched.avgJitterMicros, sched.maxJitterMicros, sched.idlePercent);
+
+    const ButtonGestures::Stats input = g_buttons.stats();
+    Log::printf("[按键] 边沿 %u 个 (滤除抖动 %u, 丢弃 %u), 手势 %u 次, 确认到处理延迟 %u us (平均 %u, 最大 %u)\n", input.edges,
+                input.bounces, input.edgesDropped, input.gestures, input.lastLatencyMicros, input.avgLatencyMicros,
+                input.maxLatencyMicros);
+
+    const SensorHub::Stats sensors = g_sensors.stats();
+    Log::printf("[传感器] %u 个, 读取 %u 次 (失败 %u), 样本 %u (丢弃 %u), 队列峰值 %u/%u, 最近一次读取 %u us, 光照 %.0f lx\n",
+                g_sensors.driverCount(), sensors.reads, sensors.failures, sensors.samples, sensors.dropped, sensors.maxQueueDepth,
+                static_cast<unsigned>(SensorHub::QUEUE_DEPTH), sensors.lastReadMicros, g_illuminance);
+
+    const HistoryLog::Stats history = g_historyLog.stats();
+    Log::printf("[历史] 环形缓冲 %u 字节, 恢复 %u 段 (损坏 %u), 追加 %u 段 (最近 %u us), 共擦除 %u 字节, 迷你图 %s\n",
+                static_cast<unsigned>(g_history.memoryBytes()), history.restored, history.corrupt, history.appended,
+                history.lastAppendMicros, history.erasedBytes, g_chartWeek ? "7 天" : "24 小时");
+
+    const BootSnapshot::Stats snapshot = g_snapshot.stats();
+    Log::printf("[快照] 保存 %u 次 (内容未变跳过 %u), 最近 %u 字节 / %u us, 共擦除 %u 字节, 开机上屏 %u us\n", snapshot.saves,
+                snapshot.unchanged, snapshot.lastSaveBytes, snapshot.lastSaveMicros, snapshot.erasedBytes, snapshot.showMicros);
+
+    if (AllocCounter::enabled())
+        Log::printf("[内存] 堆分配 最近一帧 %u 次 / 最近一次切换 %u 次, 空闲堆 %u 字节 (最低 %u)\n",
+                    static_cast<unsigned>(g_renderer.lastAllocations()), static_cast<unsigned>(g_themeManager.lastSwitchAllocations()),
+                    static_cast<unsigned>(ESP.getFreeHeap()), static_cast<unsigned>(ESP.getMinFreeHeap()));
+}
+
+// 按键与串口命令共用的手势处理：短按下一套、双击上一套、长按重载，继续按住每次连发切到下一套
+void onGesture(const ButtonGestures::Event &event, void *)
+{
+    bool changed = false;
+    ThemeTransition::Effect transition = ThemeTransition::Effect::None;
+    switch (event.gesture)
+    {
+    case ButtonGestures::Gesture::ShortPress:
+        changed = g_themeManager.switchToNextTheme();
+        transition = SWITCH_TRANSITION;
+        break;
+    case ButtonGestures::Gesture::Repeat:
+        changed = g_themeManager.switchToNextTheme();
+        break;
+    case ButtonGestures::Gesture::DoubleClick:
+        changed = g_themeManager.switchToPreviousTheme();
+        transition = SWITCH_TRANSITION;
+        break;
+    case ButtonGestures::Gesture::LongPress:
+        changed = g_themeManager.reloadActiveTheme();
+        break;
+    }
+    if (changed)
+    {
+        renderCurrentTheme(event.micros, transition);
+        scheduleSnapshot();
+    }
+}
+
+void serviceButtons();
+
+void onButtonTimer(void *)
+{
+    serviceButtons();
+}
+
+// 处理积压的边沿与到期的手势超时，再按状态机的下一个超时重新定时
+void serviceButtons()
+{
+    g_buttons.poll(micros());
+    const uint32_t waitMicros = g_buttons.microsUntilDeadline(micros());
+    if (waitMicros == ButtonGestures::NO_DEADLINE)
+    {
+        g_scheduler.cancel(g_buttonTimer);
+        return;
+    }
+    const uint32_t waitMs = (waitMicros + 999) / 1000;
+    if (!g_scheduler.restart(g_buttonTimer, waitMs))
+        g_buttonTimer = g_scheduler.startOneShot(waitMs, onButtonTimer);
+}
+
+void IRAM_ATTR onButtonEdge()
+{
+    g_buttons.pushEdgeFromISR(digitalRead(THEME_SWITCH_BUTTON) == LOW, micros());
+    g_scheduler.postFromISR(EVENT_BUTTON_EDGE);
+}
+
+void onButtonEvent(const Scheduler::Event &, void *)
+{
+    serviceButtons();
+}
+
+void onSerialEvent(const Scheduler::Event &event, void *)
+{
+    while (Serial.available())
+    {
+        char c = Serial.read();
+        if (c == 'n' || c == 'N')
+            g_buttons.inject(ButtonGestures::Gesture::ShortPress, event.timestamp, micros());
+        else if (c == 'p' || c == 'P')
+            g_buttons.inject(ButtonGestures::Gesture::DoubleClick, event.timestamp, micros());
+        else if (c == 'r' || c == 'R')
+            g_buttons.inject(ButtonGestures::Gesture::LongPress, event.timestamp, micros());
+        else if (c == 's' || c == 'S')
+            printStats();
+        else if (c == 't' || c == 'T')
+            Profiler::dumpChromeTrace(Serial);
+        else if (c == 'c' || c == 'C')
+            Profiler::clear();
+        else if (c == 'h' || c == 'H')
+        {
+            g_chartWeek = !g_chartWeek;
+            g_chartsStale = true;
+            if (refreshCharts())
+                renderCurrentTheme(event.timestamp);
+        }
+    }
+}
+
+// 采样任务里调用：只投递事件，样本留在队列里由 loop() 取
+void onSensorSamples(void *)
+{
+    g_scheduler.post(EVENT_SENSOR_SAMPLE);
+}
+
+void onSensorEvent(const Scheduler::Event &event, void *)
+{
+    SensorSample sample;
+    bool changed = false;
+    while (g_sensors.pop(sample))
+    {
+        if (sample.quantity == Quantity::Illuminance)
+            g_illuminance = sample.value;
+        g_history.record(sample.quantity, sample.value, uptimeSeconds());
+        changed = g_themeManager.setSensorValue(sample.quantity, sample.value) || changed;
+    }
+    changed = serviceHistory() || changed;
+    // 四舍五入后的显示值与迷你图都没变时不投递帧，传感器噪声不会带来 SPI 流量
+    if (changed)
+        renderCurrentTheme(event.timestamp);
+}
+
+void onHistoryTick(void *)
+{
+    // 没有传感器或读数中断时也要按时关闭时间槽（记为缺测），迷你图照常左移
+    if (serviceHistory())
+        renderCurrentTheme(micros());
+}
+
+void onClockRefresh(void *)
+{
+    g_themeManager.tickMockClock(CLOCK_SHOW_SECONDS ? 1 : 60);
+    renderCurrentTheme(micros());
+}
 
-unsigned long g_lastButtonTick = 0;
-unsigned long g_lastClockRefreshTick = 0;
+void onThemeWatch(void *)
+{
+    if (g_themeManager.filesChanged() && g_themeManager.reloadActiveTheme())
+    {
+        renderCurrentTheme(micros());
+        scheduleSnapshot();
+    }
+}
 
+void onColonBlink(void *)
+{
+    static bool visible = true;
+    visible = !visible;
+    g_themeManager.setClockColonVisible(visible);
+    renderCurrentTheme(micros());
+}
 
-void renderCurrentTheme()
+void idleHook(uint32_t sleepMicros, void *)
 {
-    g_renderer.render(g_themeManager.theme(), g_themeManager.currentThemeNumber());
+    // 浅睡眠会停掉采样任务所在的核：采样任务的到期时刻也算截止时刻，按时醒来，采样节拍不受 loop() 睡眠方式影响
+    const uint64_t lightSleepMicros =
+        min<uint64_t>(sleepMicros, static_cast<uint64_t>(g_sensors.untilNextDue(millis())) * 1000);
+    // 渲染任务还在刷屏、采样任务正在 I2C 读取或等待转换、或离下一个截止时刻太近时，只阻塞等待任务通知
+    if (!ENABLE_LIGHT_SLEEP || lightSleepMicros < LIGHT_SLEEP_MIN_US || !g_pipeline.idle() || g_sensors.busy())
+    {
+        Scheduler::waitForNotification(sleepMicros, nullptr);
+        return;
+    }
+
+    const gpio_num_t button = static_cast<gpio_num_t>(THEME_SWITCH_BUTTON);
+    esp_sleep_enable_timer_wakeup(lightSleepMicros);
+    gpio_wakeup_enable(button, GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+    uart_set_wakeup_threshold(UART_NUM_0, 3);
+    esp_sleep_enable_uart_wakeup(UART_NUM_0);
+    esp_light_sleep_start();
 
+    // 唤醒电平占用了按键的中断类型，恢复成双边沿；按键唤醒时按下沿已被吞掉，补送一个
+    const esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+    gpio_wakeup_disable(button);
+    gpio_set_intr_type(button, GPIO_INTR_ANYEDGE);
+    if (cause == ESP_SLEEP_WAKEUP_GPIO)
+    {
+        g_buttons.feed(true, micros());
+        serviceButtons();
+    }
+    else if (cause == ESP_SLEEP_WAKEUP_UART)
+        g_scheduler.post(EVENT_SERIAL_RX);
 }
 } // namespace
 
@@ -36,7 +457,18 @@ void setup()
 
     pinMode(THEME_SWITCH_BUTTON, INPUT_PULLUP);
 
-    g_display.begin();
+    // 面板复位后到退出睡眠之间必须等 120 ms，正好用来把上次的画面写进显存；唤醒后第一眼看到的就是它
+    g_display.beginAsleep();
+    g_canvas.begin();
+    const bool snapshotShown = ENABLE_BOOT_SNAPSHOT && g_snapshot.begin() && g_snapshot.show(g_canvas);
+    g_display.wake();
+    if (snapshotShown)
+    {
+        g_bootFirstPixelMs = millis();
+        Log::printf("[启动] %s 快照上屏: 启动后 %u ms（解码推送 %u us，主题 %u）\n",
+                    g_bootFirstPixelMs <= BOOT_FIRST_PIXEL_BUDGET_MS ? "⚡" : "⚠️", g_bootFirstPixelMs,
+                    g_snapshot.stats().showMicros, g_snapshot.themeNumber());
+    }
 
     if (!SPIFFS.begin(true))
     {
@@ -46,49 +478,59 @@ void setup()
 
     {
         Serial.println("[文件系统] ✅ SPIFFS 挂载成功");
+        // 有资源归档时按哈希索引直接定位，否则逐个打开散装文件
+        Assets.begin(SPIFFS);
     }
 
     g_themeManager.begin();
-    renderCurrentTheme();
+    g_pipeline.begin();
 
-    Serial.println("[提示] GPIO0短按切换主题，串口输入 n 切换、r 重载");
-}
+    g_buttons.setHandler(onGesture);
+    g_scheduler.begin();
+    g_scheduler.onEvent(EVENT_BUTTON_EDGE, onButtonEvent);
+    g_scheduler.onEvent(EVENT_SERIAL_RX, onSerialEvent);
+    g_scheduler.onEvent(EVENT_SENSOR_SAMPLE, onSensorEvent);
+    g_scheduler.setIdleHook(idleHook);
+    if (CLOCK_SHOW_SECONDS)
+        g_themeManager.setClockFormat(true);
+    g_scheduler.startPeriodic(CLOCK_SHOW_SECONDS ? 1000 : CLOCK_REFRESH_MS, onClockRefresh);
+    if (CLOCK_BLINK_COLON)
+        g_scheduler.startPeriodic(COLON_BLINK_MS, onColonBlink);
+    if (ENABLE_THEME_WATCH)
+        g_scheduler.startPeriodic(THEME_WATCH_MS, onThemeWatch);
+    attachInterrupt(digitalPinToInterrupt(THEME_SWITCH_BUTTON), onButtonEdge, CHANGE);
+    Serial.onReceive([]() { g_scheduler.post(EVENT_SERIAL_RX); });
 
-void loop()
+    // 第一帧实时渲染与屏幕上的快照比对，只推送不同的区域
+    g_bootSubmitMicros = micros();
+    renderCurrentTheme(g_bootSubmitMicros);
 
-{
-    if (digitalRead(THEME_SWITCH_BUTTON) == LOW && (millis() - g_lastButtonTick) > 350)
+    // 探测传感器要等器件上电（AHT20 约 40 ms），放在第一帧投递之后，不推迟实时画面
+    if (ENABLE_SENSORS)
     {
-        g_lastButtonTick = millis();
-        if (g_themeManager.switchToNextTheme())
-        {
-            renderCurrentTheme();
-        }
-
+        Wire.begin(I2C_SDA, I2C_SCL, I2C_FREQ_HZ);
+        g_sensors.add(g_aht20);
+        g_sensors.add(g_bmp280);
+        g_sensors.add(g_bh1750);
+        g_sensors.setNotify(onSensorSamples);
+        g_sensors.begin();
     }
 
-    if (Serial.available())
+    // 扫描 history 分区恢复历史同样放在第一帧之后；恢复完成后补一帧带迷你图的画面
+    if (ENABLE_HISTORY && g_history.begin() && g_plotter.begin())
     {
-        char c = Serial.read();
-        if (c == 'n' || c == 'N')
-        {
-            if (g_themeManager.switchToNextTheme())
-                renderCurrentTheme();
-        }
-        else if (c == 'r' || c == 'R')
-        {
-            if (g_themeManager.reloadActiveTheme())
-                renderCurrentTheme();
-
-        }
+        g_historyLog.begin(g_history, uptimeSeconds());
+        g_scheduler.startPeriodic(HISTORY_TICK_MS, onHistoryTick);
+        g_chartsStale = true;
+        if (refreshCharts())
+            renderCurrentTheme(micros());
     }
 
-    // 静态数据演示：每 10 秒更新时间文本（便于看到配置和刷新流程）
-    if ((millis() - g_lastClockRefreshTick) > 10000)
-    {
-        g_lastClockRefreshTick = millis();
-        g_themeManager.tickMockClock();
-        renderCurrentTheme();
-    }
+    Serial.println("[提示] GPIO0短按下一套、双击上一套、长按重载（按住连续切换）；串口输入 n/p/r 同上，s 查看渲染、调度、按键、传感器与历史统计，h 切换 24 小时/7 天曲线，t 导出性能追踪、c 清空");
 }
 
+void loop()
+{
+    // 分发按键/串口事件与到期定时器，其余时间休眠到下一个截止时刻
+    g_scheduler.runOnce();
+}
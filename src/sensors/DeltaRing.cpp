@@ -0,0 +1,80 @@
+#include "DeltaRing.h"
+
+DeltaRing::~DeltaRing()
+{
+    free(_keys);
+}
+
+bool DeltaRing::begin(uint32_t points)
+{
+    free(_keys);
+    _keys = nullptr;
+    _deltas = nullptr;
+    _slots = 0;
+
+    const uint32_t blocks = (points + BLOCK - 1) / BLOCK + 1;
+    // 基准值与增量放在同一块内存里，基准值在前保证对齐
+    const size_t bytes = sizeof(int16_t) * blocks + static_cast<size_t>(blocks) * BLOCK;
+    void *memory = nullptr;
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound())
+        memory = ps_malloc(bytes);
+#endif
+    if (!memory)
+        memory = malloc(bytes);
+    if (!memory)
+        return false;
+
+    _keys = static_cast<int16_t *>(memory);
+    _deltas = reinterpret_cast<int8_t *>(_keys + blocks);
+    _slots = blocks * BLOCK;
+    clear();
+    return true;
+}
+
+void DeltaRing::clear()
+{
+    _head = 0;
+    _count = 0;
+    _value = 0;
+    _blockHasValue = false;
+}
+
+void DeltaRing::push(int16_t value)
+{
+    if (!_slots)
+        return;
+
+    const uint32_t position = _head;
+    const uint32_t block = position / BLOCK;
+    if (position % BLOCK == 0)
+    {
+        // 开始覆盖最旧的一块
+        if (_count > _slots - BLOCK)
+            _count = _slots - BLOCK;
+        _keys[block] = _value;
+        _blockHasValue = false;
+    }
+
+    int8_t delta = GAP_DELTA;
+    if (value != GAP)
+    {
+        if (!_blockHasValue)
+        {
+            // 块内第一个有效点：改写基准值，之前的缺测点不依赖它
+            _keys[block] = value;
+            _value = value;
+            _blockHasValue = true;
+            delta = 0;
+        }
+        else
+        {
+            const int32_t step = constrain(static_cast<int32_t>(value) - _value, -127, 127);
+            _value += step;
+            delta = static_cast<int8_t>(step);
+        }
+    }
+    _deltas[position] = delta;
+    _head = (position + 1) % _slots;
+    _count++;
+}
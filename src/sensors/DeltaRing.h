@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 定长增量编码环形序列（量化后的 int16 采样）：每 BLOCK 个点存一个 int16 基准值，其余每点一个 int8 增量，
+// 约 1.06 字节/点。编码端按解码结果累加（闭环），单步变化超过 ±127 个量化单位时分几步追上，误差不会累积；
+// 增量 -128 表示该点缺测。开始覆盖一个块时整块旧数据作废，写满后可见长度在 capacity() 与 capacity() + BLOCK - 1 之间。
+// 只在一个任务里读写（loop()），不加锁。
+class DeltaRing
+{
+public:
+    static constexpr uint16_t BLOCK = 32;
+    // 缺测点在接口上的表示
+    static constexpr int16_t GAP = INT16_MIN;
+
+    DeltaRing() = default;
+    DeltaRing(const DeltaRing &) = delete;
+    DeltaRing &operator=(const DeltaRing &) = delete;
+    ~DeltaRing();
+
+    // 至少容纳 points 个点（按块向上取整，另加一块用于覆盖）；优先放 PSRAM
+    bool begin(uint32_t points);
+    void clear();
+
+    // 追加一个点，GAP 表示缺测
+    void push(int16_t value);
+
+    uint32_t size() const { return _count; }
+    uint32_t capacity() const { return _slots ? _slots - BLOCK : 0; }
+    // 按时间顺序解码最近 count 个点：out[count-1] 为最新一点，历史不足的部分填 GAP
+    void read(uint32_t count, int16_t *out) const
+    {
+        decode(count, [out](uint32_t i, int16_t value) { out[i] = value; });
+    }
+    // 同上，逐点交给 emit(i, value)，调用方可以边解码边换算或只取其中一段
+    template <typename Emit>
+    void decode(uint32_t count, Emit &&emit) const;
+    // 占用的堆内存（基准值 + 增量）
+    size_t memoryBytes() const { return _slots ? _slots + sizeof(int16_t) * (_slots / BLOCK) : 0; }
+
+private:
+    static constexpr int8_t GAP_DELTA = INT8_MIN;
+
+    int16_t *_keys = nullptr;
+    int8_t *_deltas = nullptr;
+    uint32_t _slots = 0; // 物理点数，BLOCK 的整数倍
+    uint32_t _head = 0;  // 下一个写入位置
+    uint32_t _count = 0;
+    int16_t _value = 0;  // 当前块解码到最新一点的值
+    bool _blockHasValue = false;
+};
+
+template <typename Emit>
+void DeltaRing::decode(uint32_t count, Emit &&emit) const
+{
+    const uint32_t available = min<uint32_t>(count, _count);
+    const uint32_t missing = count - available;
+    for (uint32_t i = 0; i < missing; i++)
+        emit(i, GAP);
+    if (!available)
+        return;
+
+    // 从起点所在块的基准值开始解码
+    uint32_t position = (_head + _slots - available) % _slots;
+    int16_t value = _keys[position / BLOCK];
+    for (uint32_t p = position - position % BLOCK; p < position; p++)
+    {
+        if (_deltas[p] != GAP_DELTA)
+            value += _deltas[p];
+    }
+
+    for (uint32_t i = 0; i < available; i++)
+    {
+        if (position % BLOCK == 0)
+            value = _keys[position / BLOCK];
+        const int8_t delta = _deltas[position];
+        if (delta == GAP_DELTA)
+            emit(missing + i, GAP);
+        else
+        {
+            value += delta;
+            emit(missing + i, value);
+        }
+        position = (position + 1) % _slots;
+    }
+}
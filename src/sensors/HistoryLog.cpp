@@ -0,0 +1,208 @@
+#include "HistoryLog.h"
+#include "core/Log.h"
+#include "theme/ThemeBinary.h"
+
+namespace
+{
+constexpr int8_t GAP_DELTA = INT8_MIN;
+// save() 落后太多时（例如长时间渲染繁忙）只补最近这么多段，其余留在内存里随环形缓冲滚出
+constexpr uint32_t MAX_CATCH_UP = 4;
+} // namespace
+
+uint32_t HistoryLog::addressOf(uint32_t slot) const
+{
+    return slot / SLOTS_PER_SECTOR * SPI_FLASH_SEC_SIZE + slot % SLOTS_PER_SECTOR * sizeof(Segment);
+}
+
+bool HistoryLog::readSlot(uint32_t slot, Segment &segment, bool &erased) const
+{
+    if (esp_partition_read(_partition, addressOf(slot), &segment, sizeof(segment)) != ESP_OK)
+        return false;
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&segment);
+    erased = true;
+    for (size_t i = 0; erased && i < sizeof(segment); i++)
+        erased = bytes[i] == 0xFF;
+    return true;
+}
+
+bool HistoryLog::validSegment(const Segment &segment)
+{
+    return segment.magic == MAGIC && segment.version == VERSION && segment.minutes == SensorHistory::MINUTES_PER_QUARTER &&
+           segment.crc == ThemeBinary::crc32(reinterpret_cast<const uint8_t *>(&segment), offsetof(Segment, crc));
+}
+
+void HistoryLog::encode(const SensorHistory::QuarterMinutes &minutes, Segment &segment)
+{
+    for (uint8_t s = 0; s < SensorHistory::SERIES; s++)
+    {
+        // 基准取第一个有效值；增量按解码结果累加，与 DeltaRing 相同
+        int16_t value = 0;
+        for (int16_t minute : minutes[s])
+        {
+            if (minute != DeltaRing::GAP)
+            {
+                value = minute;
+                break;
+            }
+        }
+        segment.keys[s] = value;
+        for (uint8_t i = 0; i < SensorHistory::MINUTES_PER_QUARTER; i++)
+        {
+            if (minutes[s][i] == DeltaRing::GAP)
+            {
+                segment.deltas[s][i] = GAP_DELTA;
+                continue;
+            }
+            const int32_t step = constrain(static_cast<int32_t>(minutes[s][i]) - value, -127, 127);
+            value += step;
+            segment.deltas[s][i] = static_cast<int8_t>(step);
+        }
+    }
+}
+
+void HistoryLog::decode(const Segment &segment, SensorHistory::QuarterMinutes &minutes)
+{
+    for (uint8_t s = 0; s < SensorHistory::SERIES; s++)
+    {
+        int16_t value = segment.keys[s];
+        for (uint8_t i = 0; i < SensorHistory::MINUTES_PER_QUARTER; i++)
+        {
+            const int8_t delta = segment.deltas[s][i];
+            if (delta == GAP_DELTA)
+                minutes[s][i] = DeltaRing::GAP;
+            else
+            {
+                value += delta;
+                minutes[s][i] = value;
+            }
+        }
+    }
+}
+
+bool HistoryLog::begin(SensorHistory &history, uint32_t nowS, const char *label)
+{
+    _partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, PARTITION_SUBTYPE, label);
+    if (!_partition)
+    {
+        Log::printf("[历史] ⚠️ 没有历史分区 %s，重启后历史从零开始\n", label);
+        return false;
+    }
+
+    const uint32_t start = micros();
+    _slotCount = _partition->size / SPI_FLASH_SEC_SIZE * SLOTS_PER_SECTOR;
+    _stats = Stats();
+
+    // 第一遍找序号最新的段
+    Segment segment;
+    bool erased = false;
+    bool found = false;
+    uint32_t newest = 0;
+    for (uint32_t slot = 0; slot < _slotCount; slot++)
+    {
+        if (!readSlot(slot, segment, erased) || erased)
+            continue;
+        if (!validSegment(segment))
+        {
+            _stats.corrupt++;
+            continue;
+        }
+        if (!found || static_cast<int32_t>(segment.sequence - _sequence) > 0)
+        {
+            newest = slot;
+            _sequence = segment.sequence;
+            found = true;
+        }
+    }
+
+    // 段是按槽位顺序循环写入的：从最新一段的下一个槽位绕一圈，正好是从旧到新
+    if (found)
+    {
+        SensorHistory::QuarterMinutes minutes;
+        for (uint32_t i = 1; i <= _slotCount; i++)
+        {
+            const uint32_t slot = (newest + i) % _slotCount;
+            if (!readSlot(slot, segment, erased) || erased || !validSegment(segment))
+                continue;
+            decode(segment, minutes);
+            history.restoreQuarter(segment.quarter, minutes);
+            _savedQuarter = segment.quarter;
+            _hasSaved = true;
+            _stats.restored++;
+        }
+    }
+    history.finishRestore(nowS);
+
+    // 下一段写在最新一段之后的第一个空位；本扇区没有空位时换到下一个扇区（写入前擦除）
+    _writeSlot = found ? (newest + 1) % _slotCount : 0;
+    while (_writeSlot % SLOTS_PER_SECTOR != 0 && readSlot(_writeSlot, segment, erased) && !erased)
+        _writeSlot = (_writeSlot + 1) % _slotCount;
+
+    _stats.restoreMicros = micros() - start;
+    Log::printf("[历史] ✅ 已恢复 %u 段 (%u 段损坏跳过), 分区可存 %u 段 (约 %u 天), 耗时 %u us\n", _stats.restored,
+                _stats.corrupt, _slotCount, static_cast<unsigned>(_slotCount / 96), _stats.restoreMicros);
+    return true;
+}
+
+bool HistoryLog::append(uint32_t quarter, const SensorHistory::QuarterMinutes &minutes)
+{
+    const uint32_t start = micros();
+    if (_writeSlot % SLOTS_PER_SECTOR == 0)
+    {
+        const uint32_t sector = _writeSlot / SLOTS_PER_SECTOR * SPI_FLASH_SEC_SIZE;
+        if (esp_partition_erase_range(_partition, sector, SPI_FLASH_SEC_SIZE) != ESP_OK)
+            return false;
+        _stats.erasedBytes += SPI_FLASH_SEC_SIZE;
+    }
+
+    Segment segment = {};
+    segment.magic = MAGIC;
+    segment.version = VERSION;
+    segment.minutes = SensorHistory::MINUTES_PER_QUARTER;
+    segment.sequence = _sequence + 1;
+    segment.quarter = quarter;
+    encode(minutes, segment);
+    segment.crc = ThemeBinary::crc32(reinterpret_cast<const uint8_t *>(&segment), offsetof(Segment, crc));
+    if (esp_partition_write(_partition, addressOf(_writeSlot), &segment, sizeof(segment)) != ESP_OK)
+        return false;
+
+    _sequence = segment.sequence;
+    _writeSlot = (_writeSlot + 1) % _slotCount;
+    _stats.appended++;
+    _stats.lastAppendMicros = micros() - start;
+    return true;
+}
+
+uint8_t HistoryLog::save(const SensorHistory &history)
+{
+    uint32_t last = 0;
+    if (!_partition || !history.lastClosedQuarter(last) || (_hasSaved && static_cast<int32_t>(last - _savedQuarter) <= 0))
+        return 0;
+
+    uint32_t first = _hasSaved ? _savedQuarter + 1 : last;
+    if (last - first >= MAX_CATCH_UP)
+        first = last - MAX_CATCH_UP + 1;
+
+    uint8_t written = 0;
+    SensorHistory::QuarterMinutes minutes;
+    for (uint32_t quarter = first; quarter <= last; quarter++)
+    {
+        history.quarterMinutes(quarter, minutes);
+        bool empty = true;
+        for (uint8_t s = 0; empty && s < SensorHistory::SERIES; s++)
+        {
+            for (int16_t minute : minutes[s])
+                empty = empty && minute == DeltaRing::GAP;
+        }
+        if (empty)
+            continue;
+        if (!append(quarter, minutes))
+        {
+            Log::printf("[历史] ❌ 历史段写入失败\n");
+            return written;
+        }
+        written++;
+    }
+    _savedQuarter = last;
+    _hasSaved = true;
+    return written;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+#include "SensorHistory.h"
+
+// 环境历史落盘：每关闭一个 15 分钟槽，把其中 15 个分钟值（温湿度、气压各一个 int16 基准 + 15 个 int8 闭环增量）
+// 连同槽号、序号与 CRC 作为 68 字节的段追加写进专用闪存分区。段按扇区顺序写满后回到开头，
+// 写入新扇区前先擦除它（其中最旧的约 15 小时历史随之丢弃）；64 KB 分区约能存 10 天。
+// 开机时扫描全部段，从最新一段之后绕一圈即按写入顺序重放进 SensorHistory，15 分钟层由分钟值重算。
+// 写到一半掉电的段 CRC 不对，扫描时跳过，下一段写在它后面的空位上。
+class HistoryLog
+{
+public:
+    static constexpr uint16_t MAGIC = 0x4853; // "SH"
+    static constexpr uint8_t VERSION = 1;
+    // partitions.csv 中 history 分区的自定义数据子类型
+    static constexpr esp_partition_subtype_t PARTITION_SUBTYPE = static_cast<esp_partition_subtype_t>(0x41);
+
+    struct Stats
+    {
+        uint32_t restored;       // 开机时重放的段
+        uint32_t corrupt;        // 扫描时 CRC 或格式不对的段
+        uint32_t appended;
+        uint32_t erasedBytes;
+        uint32_t lastAppendMicros;
+        uint32_t restoreMicros;
+    };
+
+    // 查找分区、扫描已有的段并按顺序恢复进 history（须已 begin），nowS 为当前开机时长（秒）
+    bool begin(SensorHistory &history, uint32_t nowS, const char *label = "history");
+
+    // 追加上次保存以来关闭的 15 分钟槽（全部缺测的槽跳过），返回写入的段数。
+    // 擦写闪存期间两个核的缓存都被关闭，调用方应在渲染空闲时调用
+    uint8_t save(const SensorHistory &history);
+
+    static constexpr size_t segmentBytes() { return sizeof(Segment); }
+    // 每天写入的字节数（每 15 分钟一段）
+    static constexpr uint32_t bytesPerDay() { return sizeof(Segment) * 96; }
+    uint32_t capacitySegments() const { return _slotCount; }
+
+    const Stats &stats() const { return _stats; }
+
+private:
+#pragma pack(push, 1)
+    struct Segment
+    {
+        uint16_t magic;
+        uint8_t version;
+        uint8_t minutes;
+        uint32_t sequence;
+        uint32_t quarter; // 15 分钟槽号（SensorHistory 内部时间 / 900）
+        int16_t keys[SensorHistory::SERIES];
+        int8_t deltas[SensorHistory::SERIES][SensorHistory::MINUTES_PER_QUARTER];
+        uint8_t reserved;
+        uint32_t crc; // 之前所有字节
+    };
+#pragma pack(pop)
+    static_assert(sizeof(Segment) % 4 == 0, "Segments must stay word aligned in flash");
+
+    static constexpr uint32_t SLOTS_PER_SECTOR = SPI_FLASH_SEC_SIZE / sizeof(Segment);
+
+    const esp_partition_t *_partition = nullptr;
+    uint32_t _slotCount = 0;
+    uint32_t _writeSlot = 0;
+    uint32_t _sequence = 0;
+    // 已写入的最新 15 分钟槽号；_hasSaved 为 false 时还没有
+    uint32_t _savedQuarter = 0;
+    bool _hasSaved = false;
+    Stats _stats = {};
+
+    uint32_t addressOf(uint32_t slot) const;
+    bool readSlot(uint32_t slot, Segment &segment, bool &erased) const;
+    static bool validSegment(const Segment &segment);
+    static void encode(const SensorHistory::QuarterMinutes &minutes, Segment &segment);
+    static void decode(const Segment &segment, SensorHistory::QuarterMinutes &minutes);
+    bool append(uint32_t quarter, const SensorHistory::QuarterMinutes &minutes);
+};
@@ -0,0 +1,178 @@
+#include "I2cSensors.h"
+
+namespace
+{
+constexpr uint8_t AHT20_STATUS = 0x71;
+constexpr uint8_t AHT20_BUSY = 0x80;
+constexpr uint8_t AHT20_CALIBRATED = 0x08;
+constexpr uint32_t AHT20_POWER_ON_MS = 40;
+constexpr uint32_t AHT20_CONVERSION_MS = 80;
+
+constexpr uint8_t BMP280_CALIBRATION = 0x88;
+constexpr uint8_t BMP280_CHIP_ID = 0xD0;
+constexpr uint8_t BMP280_CTRL_MEAS = 0xF4;
+constexpr uint8_t BMP280_CONFIG = 0xF5;
+constexpr uint8_t BMP280_DATA = 0xF7;
+constexpr uint8_t BMP280_ID = 0x58;
+// 温度 1 倍、气压 4 倍过采样，强制模式；片内 IIR 关闭，由 SensorHub 滤波
+constexpr uint8_t BMP280_FORCED = (1 << 5) | (3 << 2) | 1;
+constexpr uint32_t BMP280_CONVERSION_MS = 14;
+
+constexpr uint8_t BH1750_POWER_ON = 0x01;
+constexpr uint8_t BH1750_ONE_TIME_HIGH_RES = 0x20;
+constexpr uint32_t BH1750_CONVERSION_MS = 180;
+
+int16_t le16(const uint8_t *p)
+{
+    return static_cast<int16_t>(p[0] | (p[1] << 8));
+}
+} // namespace
+
+bool I2cSensor::writeBytes(const uint8_t *data, uint8_t length)
+{
+    _wire.beginTransmission(_address);
+    _wire.write(data, length);
+    return _wire.endTransmission() == 0;
+}
+
+bool I2cSensor::readBytes(uint8_t *data, uint8_t length)
+{
+    if (_wire.requestFrom(_address, length) != length)
+        return false;
+    for (uint8_t i = 0; i < length; i++)
+        data[i] = _wire.read();
+    return true;
+}
+
+bool I2cSensor::readRegisters(uint8_t reg, uint8_t *data, uint8_t length)
+{
+    _wire.beginTransmission(_address);
+    _wire.write(reg);
+    return _wire.endTransmission(false) == 0 && readBytes(data, length);
+}
+
+bool Aht20Sensor::begin()
+{
+    delay(AHT20_POWER_ON_MS);
+    uint8_t status = 0;
+    if (!readBytes(&status, 1))
+        return false;
+    if (status & AHT20_CALIBRATED)
+        return true;
+
+    // 上电后未加载校准系数时需要初始化一次
+    const uint8_t init[] = {0xBE, 0x08, 0x00};
+    if (!writeBytes(init, sizeof(init)))
+        return false;
+    delay(10);
+    return readBytes(&status, 1) && (status & AHT20_CALIBRATED);
+}
+
+uint8_t Aht20Sensor::crc8(const uint8_t *data, uint8_t length)
+{
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+    }
+    return crc;
+}
+
+uint8_t Aht20Sensor::read(SensorReading (&out)[MAX_READINGS])
+{
+    const uint8_t trigger[] = {0xAC, 0x33, 0x00};
+    if (!writeBytes(trigger, sizeof(trigger)))
+        return 0;
+    delay(AHT20_CONVERSION_MS);
+
+    uint8_t data[7];
+    if (!readBytes(data, sizeof(data)) || (data[0] & AHT20_BUSY) || crc8(data, 6) != data[6])
+        return 0;
+
+    const uint32_t humidity = (static_cast<uint32_t>(data[1]) << 12) | (data[2] << 4) | (data[3] >> 4);
+    const uint32_t temperature = (static_cast<uint32_t>(data[3] & 0x0F) << 16) | (data[4] << 8) | data[5];
+    out[0] = {Quantity::Temperature, temperature * 200.0f / 1048576.0f - 50.0f};
+    out[1] = {Quantity::Humidity, humidity * 100.0f / 1048576.0f};
+    return 2;
+}
+
+bool Bmp280Sensor::begin()
+{
+    uint8_t id = 0;
+    uint8_t raw[24];
+    if (!readRegisters(BMP280_CHIP_ID, &id, 1) || id != BMP280_ID || !readRegisters(BMP280_CALIBRATION, raw, sizeof(raw)))
+        return false;
+
+    _cal.t1 = static_cast<uint16_t>(le16(raw));
+    _cal.t2 = le16(raw + 2);
+    _cal.t3 = le16(raw + 4);
+    _cal.p1 = static_cast<uint16_t>(le16(raw + 6));
+    _cal.p2 = le16(raw + 8);
+    _cal.p3 = le16(raw + 10);
+    _cal.p4 = le16(raw + 12);
+    _cal.p5 = le16(raw + 14);
+    _cal.p6 = le16(raw + 16);
+    _cal.p7 = le16(raw + 18);
+    _cal.p8 = le16(raw + 20);
+    _cal.p9 = le16(raw + 22);
+
+    const uint8_t config[] = {BMP280_CONFIG, 0x00};
+    return writeBytes(config, sizeof(config));
+}
+
+uint8_t Bmp280Sensor::read(SensorReading (&out)[MAX_READINGS])
+{
+    const uint8_t trigger[] = {BMP280_CTRL_MEAS, BMP280_FORCED};
+    if (!writeBytes(trigger, sizeof(trigger)))
+        return 0;
+    delay(BMP280_CONVERSION_MS);
+
+    uint8_t data[6];
+    if (!readRegisters(BMP280_DATA, data, sizeof(data)))
+        return 0;
+    const int32_t adcP = (static_cast<int32_t>(data[0]) << 12) | (data[1] << 4) | (data[2] >> 4);
+    const int32_t adcT = (static_cast<int32_t>(data[3]) << 12) | (data[4] << 4) | (data[5] >> 4);
+
+    // 数据手册 3.11.3 的定点补偿公式
+    int32_t var1 = ((((adcT >> 3) - (static_cast<int32_t>(_cal.t1) << 1))) * _cal.t2) >> 11;
+    int32_t var2 = (((((adcT >> 4) - _cal.t1) * ((adcT >> 4) - _cal.t1)) >> 12) * _cal.t3) >> 14;
+    const int32_t tFine = var1 + var2;
+
+    int64_t p1 = static_cast<int64_t>(tFine) - 128000;
+    int64_t p2 = p1 * p1 * _cal.p6;
+    p2 = p2 + ((p1 * _cal.p5) << 17);
+    p2 = p2 + (static_cast<int64_t>(_cal.p4) << 35);
+    p1 = ((p1 * p1 * _cal.p3) >> 8) + ((p1 * _cal.p2) << 12);
+    p1 = ((static_cast<int64_t>(1) << 47) + p1) * _cal.p1 >> 33;
+    if (p1 == 0)
+        return 0;
+    int64_t p = 1048576 - adcP;
+    p = (((p << 31) - p2) * 3125) / p1;
+    p1 = (static_cast<int64_t>(_cal.p9) * (p >> 13) * (p >> 13)) >> 25;
+    p2 = (static_cast<int64_t>(_cal.p8) * p) >> 19;
+    p = ((p + p1 + p2) >> 8) + (static_cast<int64_t>(_cal.p7) << 4);
+
+    // p 为 Q24.8 格式的帕斯卡
+    out[0] = {Quantity::Pressure, static_cast<float>(p) / 25600.0f};
+    return 1;
+}
+
+bool Bh1750Sensor::begin()
+{
+    return writeBytes(&BH1750_POWER_ON, 1);
+}
+
+uint8_t Bh1750Sensor::read(SensorReading (&out)[MAX_READINGS])
+{
+    if (!writeBytes(&BH1750_ONE_TIME_HIGH_RES, 1))
+        return 0;
+    delay(BH1750_CONVERSION_MS);
+
+    uint8_t data[2];
+    if (!readBytes(data, sizeof(data)))
+        return 0;
+    out[0] = {Quantity::Illuminance, ((data[0] << 8) | data[1]) / 1.2f};
+    return 1;
+}
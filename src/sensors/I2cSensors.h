@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include "SensorDriver.h"
+
+// 共用 I2C 总线上的环境传感器（地址见 README 引脚定义）。都用单次转换模式：
+// 每次读取先触发转换、等待完成再取结果，两次采样之间器件处于待机。等待用 delay()，只应在采样任务里调用。
+class I2cSensor : public SensorDriver
+{
+public:
+    I2cSensor(TwoWire &wire, uint8_t address) : _wire(wire), _address(address) {}
+
+protected:
+    TwoWire &_wire;
+    uint8_t _address;
+
+    bool writeBytes(const uint8_t *data, uint8_t length);
+    bool readBytes(uint8_t *data, uint8_t length);
+    bool readRegisters(uint8_t reg, uint8_t *data, uint8_t length);
+};
+
+// AHT20 温湿度：触发后约 80 ms 完成转换，7 字节结果带 CRC
+class Aht20Sensor : public I2cSensor
+{
+public:
+    static constexpr uint8_t ADDRESS = 0x38;
+
+    explicit Aht20Sensor(TwoWire &wire, uint8_t address = ADDRESS) : I2cSensor(wire, address) {}
+
+    const char *name() const override { return "AHT20"; }
+    bool begin() override;
+    uint32_t intervalMs() const override { return 2000; }
+    uint8_t read(SensorReading (&out)[MAX_READINGS]) override;
+
+private:
+    static uint8_t crc8(const uint8_t *data, uint8_t length);
+};
+
+// BMP280 气压：强制模式，气压 4 倍过采样（约 14 ms），温度只用于补偿，室温以 AHT20 为准
+class Bmp280Sensor : public I2cSensor
+{
+public:
+    static constexpr uint8_t ADDRESS = 0x76;
+
+    explicit Bmp280Sensor(TwoWire &wire, uint8_t address = ADDRESS) : I2cSensor(wire, address) {}
+
+    const char *name() const override { return "BMP280"; }
+    bool begin() override;
+    uint32_t intervalMs() const override { return 2000; }
+    uint8_t read(SensorReading (&out)[MAX_READINGS]) override;
+
+private:
+    struct Calibration
+    {
+        uint16_t t1;
+        int16_t t2, t3;
+        uint16_t p1;
+        int16_t p2, p3, p4, p5, p6, p7, p8, p9;
+    };
+
+    Calibration _cal = {};
+};
+
+// BH1750 光照：单次高分辨率模式，最长 180 ms 转换
+class Bh1750Sensor : public I2cSensor
+{
+public:
+    static constexpr uint8_t ADDRESS = 0x23;
+
+    explicit Bh1750Sensor(TwoWire &wire, uint8_t address = ADDRESS) : I2cSensor(wire, address) {}
+
+    const char *name() const override { return "BH1750"; }
+    bool begin() override;
+    uint32_t intervalMs() const override { return 1000; }
+    uint8_t read(SensorReading (&out)[MAX_READINGS]) override;
+};
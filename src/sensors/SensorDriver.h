@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 传感器测得的物理量；每个量在 SensorHub 里有自己的滤波器，同一个量只应由一个驱动提供
+enum class Quantity : uint8_t
+{
+    Temperature, // ℃
+    Humidity,    // %RH
+    Pressure,    // hPa
+    Illuminance, // lx
+};
+
+constexpr uint8_t QUANTITY_COUNT = 4;
+
+struct SensorReading
+{
+    Quantity quantity;
+    float value;
+};
+
+// 经过滤波、送往界面的样本
+struct SensorSample
+{
+    Quantity quantity;
+    float value;     // 滤波后
+    float raw;       // 本次原始读数
+    uint32_t timeMs; // 采样时刻
+};
+
+// 传感器驱动接口：SensorHub 按各驱动自己的周期在采样任务里调用 read()，读取可以阻塞（等待转换完成）。
+// 新增传感器：实现这个接口，在 setup() 里 SensorHub::add()。
+class SensorDriver
+{
+public:
+    // 一个驱动一次最多返回的读数（AHT20 同时给出温度与湿度）
+    static constexpr uint8_t MAX_READINGS = 2;
+
+    virtual ~SensorDriver() {}
+
+    virtual const char *name() const = 0;
+    // 探测并配置器件；失败的驱动不会被登记
+    virtual bool begin() = 0;
+    virtual uint32_t intervalMs() const = 0;
+    // 读一次，返回写入 out 的读数个数，0 表示本次读取失败
+    virtual uint8_t read(SensorReading (&out)[MAX_READINGS]) = 0;
+};
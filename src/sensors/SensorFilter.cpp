@@ -0,0 +1,35 @@
+#include "SensorFilter.h"
+
+float SensorFilter::update(float raw)
+{
+    _window[_next] = raw;
+    _next = (_next + 1) % WINDOW;
+    const bool first = _count == 0;
+    if (_count < WINDOW)
+        _count++;
+
+    const float middle = median();
+    _average = first ? middle : _average + _alpha * (middle - _average);
+    return _average;
+}
+
+void SensorFilter::reset()
+{
+    _count = 0;
+    _next = 0;
+    _average = 0;
+}
+
+float SensorFilter::median() const
+{
+    // 至多 5 个数，插入排序足够
+    float sorted[WINDOW];
+    for (uint8_t i = 0; i < _count; i++)
+    {
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > _window[i]; j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = _window[i];
+    }
+    return (_count & 1) ? sorted[_count / 2] : (sorted[_count / 2 - 1] + sorted[_count / 2]) / 2;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Arduino.h>
+
+// 两级滤波：先取最近 WINDOW 个读数的中值剔除偶发尖峰（I2C 干扰、转换未完成），再做指数滑动平均压低噪声。
+// 窗口未满时对已有读数取中值；第一个读数直接作为平均值的起点，不从 0 爬升。
+class SensorFilter
+{
+public:
+    static constexpr uint8_t WINDOW = 5;
+
+    explicit SensorFilter(float alpha = 0.25f) : _alpha(alpha) {}
+
+    float update(float raw);
+    void reset();
+
+    bool hasValue() const { return _count > 0; }
+    float value() const { return _average; }
+
+private:
+    float _alpha;
+    float _window[WINDOW] = {};
+    uint8_t _count = 0;
+    uint8_t _next = 0;
+    float _average = 0;
+
+    float median() const;
+};
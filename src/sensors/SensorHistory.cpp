@@ -0,0 +1,224 @@
+#include "SensorHistory.h"
+#include <cmath>
+#include "core/Log.h"
+
+namespace
+{
+constexpr uint32_t PERIODS_S[SensorHistory::TIER_COUNT] = {2, 60, 900};
+constexpr uint32_t POINTS[SensorHistory::TIER_COUNT] = {1800, 1440, 672};
+constexpr float SCALES[SensorHistory::SERIES] = {20.0f, 10.0f, 10.0f};
+static_assert(PERIODS_S[2] == PERIODS_S[1] * SensorHistory::MINUTES_PER_QUARTER, "Quarter tier must hold 15 minutes");
+} // namespace
+
+uint32_t SensorHistory::periodOf(Tier tier)
+{
+    return PERIODS_S[static_cast<uint8_t>(tier)];
+}
+
+uint32_t SensorHistory::pointsOf(Tier tier)
+{
+    return POINTS[static_cast<uint8_t>(tier)];
+}
+
+int8_t SensorHistory::seriesOf(Quantity quantity)
+{
+    switch (quantity)
+    {
+    case Quantity::Temperature:
+        return 0;
+    case Quantity::Humidity:
+        return 1;
+    case Quantity::Pressure:
+        return 2;
+    default:
+        return -1;
+    }
+}
+
+int16_t SensorHistory::quantize(uint8_t series, float value)
+{
+    // GAP 留给缺测
+    const float scaled = roundf(value * SCALES[series]);
+    return static_cast<int16_t>(constrain(scaled, static_cast<float>(INT16_MIN + 1), static_cast<float>(INT16_MAX)));
+}
+
+float SensorHistory::dequantize(uint8_t series, int16_t value)
+{
+    return value == DeltaRing::GAP ? NAN : value / SCALES[series];
+}
+
+bool SensorHistory::begin()
+{
+    if (_ready)
+        return true;
+    for (uint8_t tier = 0; tier < TIER_COUNT; tier++)
+    {
+        for (uint8_t s = 0; s < SERIES; s++)
+        {
+            if (!_rings[tier][s].begin(POINTS[tier]))
+            {
+                Log::printf("[历史] ❌ 环形缓冲分配失败\n");
+                return false;
+            }
+        }
+    }
+    _ready = true;
+    Log::printf("[历史] ✅ 温湿度与气压历史: 1 小时原始 / 24 小时分钟 / 7 天 15 分钟, 共 %u 字节\n",
+                static_cast<unsigned>(memoryBytes()));
+    return true;
+}
+
+void SensorHistory::record(Quantity quantity, float value, uint32_t nowS)
+{
+    const int8_t series = seriesOf(quantity);
+    if (!_ready || series < 0 || std::isnan(value))
+        return;
+    advanceTo(nowS + _offset);
+    Accumulator &raw = _accumulators[static_cast<uint8_t>(Tier::Raw)];
+    raw.sum[series] += value;
+    raw.count[series]++;
+}
+
+uint8_t SensorHistory::advance(uint32_t nowS)
+{
+    if (_ready)
+        advanceTo(nowS + _offset);
+    const uint8_t closed = _closedTiers;
+    _closedTiers = 0;
+    return closed;
+}
+
+void SensorHistory::advanceTo(uint32_t timeS)
+{
+    // 先关下层：下层槽关闭时会把平均值汇总进上层
+    for (uint8_t tier = 0; tier < TIER_COUNT; tier++)
+        advanceTier(tier, timeS / PERIODS_S[tier]);
+}
+
+void SensorHistory::advanceTier(uint8_t tier, uint32_t slot)
+{
+    if (slot <= _open[tier])
+        return;
+    if (slot - _open[tier] > POINTS[tier])
+    {
+        // 空白超过整层跨度：旧数据全部过期，不必逐槽补缺测
+        for (DeltaRing &ring : _rings[tier])
+            ring.clear();
+        _accumulators[tier] = Accumulator();
+        _open[tier] = slot;
+        _closedTiers |= 1 << tier;
+        return;
+    }
+    while (_open[tier] < slot)
+        closeSlot(tier);
+}
+
+void SensorHistory::closeSlot(uint8_t tier)
+{
+    Accumulator &acc = _accumulators[tier];
+    float values[SERIES];
+    for (uint8_t s = 0; s < SERIES; s++)
+    {
+        const int16_t quantized = acc.count[s] ? quantize(s, acc.sum[s] / acc.count[s]) : DeltaRing::GAP;
+        _rings[tier][s].push(quantized);
+        // 上层按量化后的值汇总，从闪存恢复分钟值后重算出的 15 分钟值与原来完全一致
+        values[s] = dequantize(s, quantized);
+    }
+    acc = Accumulator();
+    const uint32_t startS = _open[tier] * PERIODS_S[tier];
+    _open[tier]++;
+    _closedTiers |= 1 << tier;
+    if (tier + 1 < TIER_COUNT)
+        accumulate(tier + 1, startS, values);
+}
+
+void SensorHistory::accumulate(uint8_t tier, uint32_t timeS, const float (&values)[SERIES])
+{
+    advanceTier(tier, timeS / PERIODS_S[tier]);
+    Accumulator &acc = _accumulators[tier];
+    for (uint8_t s = 0; s < SERIES; s++)
+    {
+        if (std::isnan(values[s]))
+            continue;
+        acc.sum[s] += values[s];
+        acc.count[s]++;
+    }
+}
+
+void SensorHistory::read(Tier tier, uint8_t series, uint32_t count, float *out) const
+{
+    _rings[static_cast<uint8_t>(tier)][series].decode(count, [out, series](uint32_t i, int16_t value) {
+        out[i] = dequantize(series, value);
+    });
+}
+
+void SensorHistory::quarterMinutes(uint32_t quarter, QuarterMinutes &out) const
+{
+    const uint8_t minute = static_cast<uint8_t>(Tier::Minute);
+    const uint32_t first = quarter * MINUTES_PER_QUARTER;
+    for (uint8_t s = 0; s < SERIES; s++)
+    {
+        for (int16_t &value : out[s])
+            value = DeltaRing::GAP;
+    }
+    if (first + MINUTES_PER_QUARTER > _open[minute] || _open[minute] - first > POINTS[minute])
+        return;
+
+    // 分钟层最新一点是 _open - 1 号槽，从该 15 分钟槽的第一分钟解码，只留前 15 个
+    const uint32_t back = _open[minute] - first;
+    for (uint8_t s = 0; s < SERIES; s++)
+    {
+        int16_t *values = out[s];
+        _rings[minute][s].decode(back, [values](uint32_t i, int16_t value) {
+            if (i < MINUTES_PER_QUARTER)
+                values[i] = value;
+        });
+    }
+}
+
+bool SensorHistory::lastClosedQuarter(uint32_t &quarter) const
+{
+    const uint32_t open = _open[static_cast<uint8_t>(Tier::Quarter)];
+    if (!open)
+        return false;
+    quarter = open - 1;
+    return true;
+}
+
+void SensorHistory::restoreQuarter(uint32_t quarter, const QuarterMinutes &minutes)
+{
+    const uint8_t minute = static_cast<uint8_t>(Tier::Minute);
+    if (!_ready || quarter * MINUTES_PER_QUARTER < _open[minute])
+        return;
+    for (uint8_t i = 0; i < MINUTES_PER_QUARTER; i++)
+    {
+        float values[SERIES];
+        for (uint8_t s = 0; s < SERIES; s++)
+            values[s] = dequantize(s, minutes[s][i]);
+        const uint32_t timeS = (quarter * MINUTES_PER_QUARTER + i) * PERIODS_S[minute];
+        accumulate(minute, timeS, values);
+    }
+    advanceTier(minute, (quarter + 1) * MINUTES_PER_QUARTER);
+    advanceTier(static_cast<uint8_t>(Tier::Quarter), quarter + 1);
+}
+
+void SensorHistory::finishRestore(uint32_t nowS)
+{
+    const uint32_t endS = _open[static_cast<uint8_t>(Tier::Quarter)] * PERIODS_S[static_cast<uint8_t>(Tier::Quarter)];
+    // 没有 RTC 时开机时长从 0 起算，恢复的历史总在“未来”：整体平移，断电期间的空白不计
+    _offset = endS > nowS ? endS - nowS : 0;
+    const uint8_t raw = static_cast<uint8_t>(Tier::Raw);
+    _open[raw] = max<uint32_t>(_open[raw], endS / PERIODS_S[raw]);
+    _closedTiers = 0;
+}
+
+size_t SensorHistory::memoryBytes() const
+{
+    size_t bytes = 0;
+    for (uint8_t tier = 0; tier < TIER_COUNT; tier++)
+    {
+        for (const DeltaRing &ring : _rings[tier])
+            bytes += ring.memoryBytes();
+    }
+    return bytes;
+}
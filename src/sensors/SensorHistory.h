@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "DeltaRing.h"
+#include "SensorDriver.h"
+
+// 环境历史：温度、湿度、气压各三层定长增量编码环（见 DeltaRing），内存固定、开机时一次分配：
+//   原始层   2 秒一点 × 1800（1 小时）
+//   分钟层   1 分钟一点 × 1440（24 小时，24 小时曲线）
+//   15 分钟层 15 分钟一点 × 672（7 天，7 天曲线）
+// 每层按时间槽累加读数，槽结束时求平均写入本层并汇总到上一层；整个槽没有读数时记为缺测。
+// 时间用单调递增的秒数（没有 RTC，取开机时长）；从闪存恢复的历史晚于当前时间时整体平移，开机后接着往后记。
+// 只在 loop() 里调用。
+class SensorHistory
+{
+public:
+    enum class Tier : uint8_t
+    {
+        Raw,
+        Minute,
+        Quarter,
+    };
+    static constexpr uint8_t TIER_COUNT = 3;
+    // 记录的物理量：温度、湿度、气压（光照不上屏，不记录）
+    static constexpr uint8_t SERIES = 3;
+    static constexpr uint8_t MINUTES_PER_QUARTER = 15;
+
+    typedef int16_t QuarterMinutes[SERIES][MINUTES_PER_QUARTER];
+
+    static uint32_t periodOf(Tier tier);
+    static uint32_t pointsOf(Tier tier);
+    // Quantity 对应的序列号，不记录的物理量返回 -1
+    static int8_t seriesOf(Quantity quantity);
+    // 量化：温度 0.05 °C，湿度 0.1 %，气压 0.1 hPa。相邻两点最多相差 127 个单位（6.35 °C / 12.7 % / 12.7 hPa），
+    // 更快的突变分几点追上
+    static int16_t quantize(uint8_t series, float value);
+    static float dequantize(uint8_t series, int16_t value);
+
+    bool begin();
+    bool ready() const { return _ready; }
+
+    // 记录一次滤波后的读数；nowS 为单调递增的秒数
+    void record(Quantity quantity, float value, uint32_t nowS);
+    // 推进到 nowS，关闭已经结束的时间槽。返回自上次调用以来关闭过时间槽的层（bit n 对应 Tier n）
+    uint8_t advance(uint32_t nowS);
+
+    // 某层最近 count 个已关闭的点，按时间顺序（out[count-1] 最新），缺测为 NAN
+    void read(Tier tier, uint8_t series, uint32_t count, float *out) const;
+    // 第 quarter 个 15 分钟槽内的分钟值（量化后），已滚出分钟层的点为 DeltaRing::GAP
+    void quarterMinutes(uint32_t quarter, QuarterMinutes &out) const;
+    // 最近一个已关闭的 15 分钟槽号；还没有关闭过时返回 false
+    bool lastClosedQuarter(uint32_t &quarter) const;
+
+    // 恢复一个 15 分钟槽的分钟值（须按时间顺序调用），再由 finishRestore 把时钟接到恢复的末尾
+    void restoreQuarter(uint32_t quarter, const QuarterMinutes &minutes);
+    void finishRestore(uint32_t nowS);
+
+    // 三层环形缓冲占用的堆内存
+    size_t memoryBytes() const;
+
+private:
+    struct Accumulator
+    {
+        float sum[SERIES];
+        uint16_t count[SERIES];
+    };
+
+    DeltaRing _rings[TIER_COUNT][SERIES];
+    Accumulator _accumulators[TIER_COUNT] = {};
+    // 各层正在累加的时间槽号（时间 / 周期）
+    uint32_t _open[TIER_COUNT] = {};
+    // 内部时间 = nowS + _offset
+    uint32_t _offset = 0;
+    uint8_t _closedTiers = 0;
+    bool _ready = false;
+
+    void advanceTo(uint32_t timeS);
+    void advanceTier(uint8_t tier, uint32_t slot);
+    void closeSlot(uint8_t tier);
+    void accumulate(uint8_t tier, uint32_t timeS, const float (&values)[SERIES]);
+};
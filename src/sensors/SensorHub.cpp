@@ -0,0 +1,167 @@
+#include "SensorHub.h"
+#include "core/Log.h"
+
+namespace
+{
+// 没有登记驱动时 poll() 的空转间隔
+constexpr uint32_t IDLE_POLL_MS = 1000;
+
+void raiseTo(std::atomic<uint32_t> &peak, uint32_t value)
+{
+    if (value > peak.load(std::memory_order_relaxed))
+        peak.store(value, std::memory_order_relaxed);
+}
+} // namespace
+
+bool SensorHub::add(SensorDriver &driver)
+{
+    if (_driverCount >= MAX_DRIVERS)
+        return false;
+    if (!driver.begin())
+    {
+        Log::printf("[传感器] ⚠️ 未检测到 %s，跳过\n", driver.name());
+        return false;
+    }
+    _drivers[_driverCount] = &driver;
+    _due[_driverCount] = millis();
+    _nextDueMs.store(_due[_driverCount], std::memory_order_release);
+    _driverCount++;
+    Log::printf("[传感器] ✅ %s 已就绪, 每 %u ms 采样一次\n", driver.name(), driver.intervalMs());
+    return true;
+}
+
+void SensorHub::setNotify(Notify notify, void *context)
+{
+    _notify = notify;
+    _notifyContext = context;
+}
+
+bool SensorHub::begin()
+{
+    if (_task || !_driverCount)
+        return _task != nullptr;
+
+    _running = true;
+    _exited = false;
+    if (xTaskCreatePinnedToCore(taskEntry, "sensors", STACK_BYTES, this, PRIORITY, &_task, SENSOR_CORE) != pdPASS)
+    {
+        _task = nullptr;
+        _running = false;
+        Serial.println("[传感器] ❌ 采样任务创建失败");
+        return false;
+    }
+    Log::printf("[传感器] ✅ 采样任务已启动 (核 %d), %u 个传感器\n", static_cast<int>(SENSOR_CORE), _driverCount);
+    return true;
+}
+
+void SensorHub::end()
+{
+    if (!_task)
+        return;
+
+    _running = false;
+    xTaskNotifyGive(_task);
+    while (!_exited)
+        vTaskDelay(1);
+    _task = nullptr;
+}
+
+uint32_t SensorHub::poll(uint32_t nowMs)
+{
+    if (!_driverCount)
+        return IDLE_POLL_MS;
+
+    bool pushed = false;
+    uint32_t wait = UINT32_MAX;
+    for (uint8_t i = 0; i < _driverCount; i++)
+    {
+        const uint32_t interval = _drivers[i]->intervalMs();
+        if (static_cast<int32_t>(nowMs - _due[i]) >= 0)
+        {
+            _busy.store(true, std::memory_order_release);
+            pushed = sample(*_drivers[i], nowMs) || pushed;
+            // 保持固定节拍；落后超过一个周期（读取卡住、任务被饿死）时从现在重新计时，不补读
+            _due[i] += interval;
+            if (static_cast<int32_t>(nowMs - _due[i]) >= 0)
+                _due[i] = nowMs + interval;
+        }
+        wait = min<uint32_t>(wait, _due[i] - nowMs);
+    }
+    _nextDueMs.store(nowMs + wait, std::memory_order_release);
+    _busy.store(false, std::memory_order_release);
+
+    if (pushed && _notify)
+        _notify(_notifyContext);
+    return wait;
+}
+
+uint32_t SensorHub::untilNextDue(uint32_t nowMs) const
+{
+    if (!_task)
+        return UINT32_MAX;
+    const int32_t wait = static_cast<int32_t>(_nextDueMs.load(std::memory_order_acquire) - nowMs);
+    return wait > 0 ? static_cast<uint32_t>(wait) : 0;
+}
+
+bool SensorHub::sample(SensorDriver &driver, uint32_t nowMs)
+{
+    SensorReading readings[SensorDriver::MAX_READINGS];
+    const uint32_t start = micros();
+    const uint8_t count = driver.read(readings);
+    _lastReadMicros.store(micros() - start, std::memory_order_relaxed);
+    _reads.fetch_add(1, std::memory_order_relaxed);
+    if (!count)
+    {
+        _failures.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool pushed = false;
+    for (uint8_t i = 0; i < count && i < SensorDriver::MAX_READINGS; i++)
+    {
+        SensorSample sample;
+        sample.quantity = readings[i].quantity;
+        sample.raw = readings[i].value;
+        sample.value = _filters[static_cast<uint8_t>(sample.quantity)].update(sample.raw);
+        sample.timeMs = nowMs;
+        _samples.fetch_add(1, std::memory_order_relaxed);
+        if (!_queue.push(sample))
+        {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        raiseTo(_maxQueueDepth, _queue.size());
+        pushed = true;
+    }
+    return pushed;
+}
+
+void SensorHub::run()
+{
+    while (_running)
+    {
+        const uint32_t wait = poll(millis());
+        // 用任务通知等待而不是 vTaskDelay，end() 可以随时唤醒
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+    }
+
+    _exited = true;
+    vTaskDelete(nullptr);
+}
+
+void SensorHub::taskEntry(void *arg)
+{
+    static_cast<SensorHub *>(arg)->run();
+}
+
+SensorHub::Stats SensorHub::stats() const
+{
+    Stats s;
+    s.reads = _reads.load(std::memory_order_relaxed);
+    s.failures = _failures.load(std::memory_order_relaxed);
+    s.samples = _samples.load(std::memory_order_relaxed);
+    s.dropped = _dropped.load(std::memory_order_relaxed);
+    s.maxQueueDepth = _maxQueueDepth.load(std::memory_order_relaxed);
+    s.lastReadMicros = _lastReadMicros.load(std::memory_order_relaxed);
+    return s;
+}
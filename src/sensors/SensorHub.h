@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "SensorDriver.h"
+#include "SensorFilter.h"
+#include "core/SpscQueue.h"
+
+// 传感器采集：各驱动按自己的周期在独立的采样任务里读取（I2C 转换等待不占用 loop()），
+// 每个物理量经中值 + 滑动平均滤波后放进无锁 SPSC 队列，由 loop() 取出交给界面。
+// 队列满时丢弃新样本并计数：界面只关心最新值，下一轮采样会补上。
+class SensorHub
+{
+public:
+    static constexpr uint8_t MAX_DRIVERS = 4;
+    static constexpr size_t QUEUE_DEPTH = 16;
+    static constexpr uint32_t STACK_BYTES = 4096;
+    // 低于渲染任务；读取时大部分时间阻塞在转换等待上
+    static constexpr UBaseType_t PRIORITY = 1;
+    static constexpr BaseType_t SENSOR_CORE = 0;
+
+    typedef void (*Notify)(void *context);
+
+    struct Stats
+    {
+        uint32_t reads;
+        uint32_t failures;
+        uint32_t samples;
+        uint32_t dropped; // 队列满被丢弃的样本
+        uint32_t maxQueueDepth;
+        uint32_t lastReadMicros; // 最近一次驱动读取耗时（含转换等待）
+    };
+
+    // 探测并登记驱动；begin() 失败或已满时返回 false
+    bool add(SensorDriver &driver);
+    uint8_t driverCount() const { return _driverCount; }
+
+    // 有样本入队后在采样任务里调用，用来唤醒消费者（例如向 Scheduler 投递事件）
+    void setNotify(Notify notify, void *context = nullptr);
+
+    // 创建采样任务；没有登记任何驱动时不创建
+    bool begin();
+    // 停止采样任务（主机端测试用），返回前任务已退出
+    void end();
+
+    // 读取所有到期的驱动，返回距下一次到期的毫秒数。采样任务循环调用；
+    // 不创建任务时可由调用方按自己的时钟驱动（主机端回放轨迹）
+    uint32_t poll(uint32_t nowMs);
+
+    // 仅消费者调用
+    bool pop(SensorSample &sample) { return _queue.pop(sample); }
+
+    // 采样任务正在读取驱动（I2C 传输或转换等待中），此时不能进入浅睡眠
+    bool busy() const { return _busy.load(std::memory_order_acquire); }
+    // 距下一个驱动到期的毫秒数；采样任务没有运行时返回 UINT32_MAX
+    uint32_t untilNextDue(uint32_t nowMs) const;
+
+    Stats stats() const;
+
+private:
+    SensorDriver *_drivers[MAX_DRIVERS] = {};
+    uint32_t _due[MAX_DRIVERS] = {};
+    uint8_t _driverCount = 0;
+    SensorFilter _filters[QUANTITY_COUNT];
+
+    SpscQueue<SensorSample, QUEUE_DEPTH> _queue;
+    Notify _notify = nullptr;
+    void *_notifyContext = nullptr;
+
+    TaskHandle_t _task = nullptr;
+    std::atomic<bool> _running{false};
+    std::atomic<bool> _exited{false};
+    std::atomic<bool> _busy{false};
+    std::atomic<uint32_t> _nextDueMs{0};
+
+    // 以下由采样任务写入
+    std::atomic<uint32_t> _reads{0};
+    std::atomic<uint32_t> _failures{0};
+    std::atomic<uint32_t> _samples{0};
+    std::atomic<uint32_t> _dropped{0};
+    std::atomic<uint32_t> _maxQueueDepth{0};
+    std::atomic<uint32_t> _lastReadMicros{0};
+
+    bool sample(SensorDriver &driver, uint32_t nowMs);
+    void run();
+    static void taskEntry(void *arg);
+};
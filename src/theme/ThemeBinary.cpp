@@ -0,0 +1,93 @@
+#include "ThemeBinary.h"
+
+namespace ThemeBinary
+{
+namespace
+{
+const char *stringAt(const char *table, uint16_t tableSize, uint16_t offset)
+{
+    return offset < tableSize ? table + offset : "";
+}
+
+void applyText(const TextRecord &rec, const char *table, uint16_t tableSize, TextStyle &style)
+{
+    if (rec.mask & FIELD_X) style.x = rec.x;
+    if (rec.mask & FIELD_Y) style.y = rec.y;
+    if (rec.mask & FIELD_SIZE) style.size = rec.size;
+    if (rec.mask & FIELD_COLOR) style.color = rec.color;
+    if (rec.mask & FIELD_VALUE) style.value = stringAt(table, tableSize, rec.value);
+    if (rec.font != NO_STRING) style.font = stringAt(table, tableSize, rec.font);
+}
+
+void applyModule(const ModuleRecord &rec, ModuleStyle &style)
+{
+    if (rec.mask & FIELD_X) style.x = rec.x;
+    if (rec.mask & FIELD_Y) style.y = rec.y;
+    if (rec.mask & FIELD_W) style.w = rec.w;
+    if (rec.mask & FIELD_H) style.h = rec.h;
+    if (rec.mask & FIELD_OPACITY) style.opacity = rec.opacity;
+    if (rec.mask & FIELD_COLOR) style.color = rec.color;
+}
+} // namespace
+
+uint32_t crc32(const uint8_t *data, size_t length, uint32_t crc)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+bool apply(const uint8_t *data, size_t length, ThemeConfig &theme)
+{
+    if (length < sizeof(Header) + sizeof(Payload))
+        return false;
+
+    Header header;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION)
+        return false;
+    if (sizeof(Header) + header.payloadSize != length)
+        return false;
+
+    const uint8_t *payloadBytes = data + sizeof(Header);
+    if (crc32(payloadBytes, header.payloadSize) != header.crc32)
+        return false;
+
+    Payload payload;
+    memcpy(&payload, payloadBytes, sizeof(payload));
+    const uint16_t tableSize = payload.stringTableSize;
+    if (sizeof(Payload) + tableSize != header.payloadSize)
+        return false;
+    const char *table = reinterpret_cast<const char *>(payloadBytes + sizeof(Payload));
+    if (tableSize > 0 && table[tableSize - 1] != '\0')
+        return false;
+
+    if (payload.backgroundMask & BG_COLOR)
+        theme.backgroundColor = payload.backgroundColor;
+    if (payload.backgroundMask & BG_IMAGE)
+        theme.backgroundImage = theme.paths.intern(stringAt(table, tableSize, payload.backgroundImage));
+
+    TextStyle *texts[6] = {&theme.timeText, &theme.dateText, &theme.tempText,
+                           &theme.humidText, &theme.pressureText, &theme.alarmText};
+    for (uint8_t i = 0; i < 6; i++)
+        applyText(payload.texts[i], table, tableSize, *texts[i]);
+
+    ModuleStyle *modules[3] = {&theme.timeModule, &theme.envModule, &theme.alarmModule};
+    for (uint8_t i = 0; i < 3; i++)
+        applyModule(payload.modules[i], *modules[i]);
+
+    if (payload.imagesMask & IMAGES_PRESENT)
+    {
+        if (payload.imagesMask & IMAGES_WEATHER)
+            theme.weatherIcon = theme.paths.intern(stringAt(table, tableSize, payload.weatherIcon));
+        theme.wifiIcon = theme.paths.intern(stringAt(table, tableSize, payload.wifiIcon));
+        theme.batteryIcon = theme.paths.intern(stringAt(table, tableSize, payload.batteryIcon));
+    }
+    return true;
+}
+} // namespace ThemeBinary
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Arduino.h>
+#include "ThemeTypes.h"
+
+// 预编译主题（*.thm）格式，由 tools/compile_themes.py 生成。
+// 记录为小端紧凑结构，颜色已是 RGB565，字符串以偏移引用字符串表；
+// 每条记录带字段掩码，只覆盖 JSON 中出现过的字段，与 JSON 加载语义一致。
+namespace ThemeBinary
+{
+constexpr uint32_t MAGIC = 0x424D4854; // "THMB"
+constexpr uint16_t VERSION = 2;
+constexpr uint16_t NO_STRING = 0xFFFF;
+constexpr size_t MAX_FILE_SIZE = 1024;
+
+enum FieldMask : uint8_t
+{
+    FIELD_X = 1 << 0,
+    FIELD_Y = 1 << 1,
+    FIELD_SIZE = 1 << 2,
+    FIELD_W = 1 << 3,
+    FIELD_H = 1 << 4,
+    FIELD_COLOR = 1 << 5,
+    FIELD_VALUE = 1 << 6,
+    FIELD_OPACITY = 1 << 7,
+};
+
+enum SectionMask : uint8_t
+{
+    BG_PRESENT = 1 << 0,
+    BG_COLOR = 1 << 1,
+    BG_IMAGE = 1 << 2,
+    IMAGES_PRESENT = 1 << 0,
+    IMAGES_WEATHER = 1 << 1,
+};
+
+#pragma pack(push, 1)
+struct Header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t payloadSize;
+    uint32_t crc32;
+    uint32_t reserved;
+};
+
+struct TextRecord
+{
+    uint8_t mask;
+    uint8_t size;
+    int16_t x;
+    int16_t y;
+    uint16_t color;
+    uint16_t value;
+    uint16_t font; // NO_STRING 表示未指定，使用内置 5x7 字体
+};
+
+struct ModuleRecord
+{
+    uint8_t mask;
+    uint8_t opacity;
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+    uint16_t color;
+};
+
+// 文本顺序：time/date/temp/humidity/pressure/alarm；模块顺序：time/environment/alarm
+struct Payload
+{
+    uint8_t backgroundMask;
+    uint8_t imagesMask;
+    uint16_t backgroundColor;
+    uint16_t backgroundImage;
+    TextRecord texts[6];
+    ModuleRecord modules[3];
+    uint16_t weatherIcon;
+    uint16_t wifiIcon;
+    uint16_t batteryIcon;
+    uint16_t stringTableSize;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(Header) == 16, "ThemeBinary::Header layout");
+static_assert(sizeof(TextRecord) == 12, "ThemeBinary::TextRecord layout");
+static_assert(sizeof(ModuleRecord) == 12, "ThemeBinary::ModuleRecord layout");
+static_assert(sizeof(Payload) == 122, "ThemeBinary::Payload layout");
+
+// 标准 CRC-32（与 zlib.crc32 相同）；分段计算时把上一段的结果作为 crc 传入
+uint32_t crc32(const uint8_t *data, size_t length, uint32_t crc = 0);
+
+// 校验并把 data 中的记录映射到 theme（在调用方给出的默认值之上覆盖），失败时不修改 theme
+bool apply(const uint8_t *data, size_t length, ThemeConfig &theme);
+} // namespace ThemeBinary
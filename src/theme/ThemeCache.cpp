@@ -0,0 +1,123 @@
+#include "ThemeCache.h"
+
+#include <new>
+
+ThemeCache::~ThemeCache()
+{
+    for (Entry &entry : _entries)
+        freeConfig(entry.config);
+}
+
+ThemeConfig *ThemeCache::allocConfig(const ThemeConfig &config)
+{
+    void *memory = nullptr;
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound())
+        memory = ps_malloc(sizeof(ThemeConfig));
+#endif
+    if (!memory)
+        memory = malloc(sizeof(ThemeConfig));
+    if (!memory)
+        return nullptr;
+    return new (memory) ThemeConfig(config);
+}
+
+void ThemeCache::freeConfig(ThemeConfig *config)
+{
+    if (!config)
+        return;
+    config->~ThemeConfig();
+    free(config);
+}
+
+int8_t ThemeCache::indexOf(StrView path) const
+{
+    for (uint8_t i = 0; i < CAPACITY; i++)
+    {
+        if (_entries[i].valid && _entries[i].path == path)
+            return i;
+    }
+    return -1;
+}
+
+uint8_t ThemeCache::size() const
+{
+    uint8_t count = 0;
+    for (const Entry &entry : _entries)
+    {
+        if (entry.valid)
+            count++;
+    }
+    return count;
+}
+
+const ThemeConfig *ThemeCache::find(StrView path)
+{
+    int8_t i = indexOf(path);
+    if (i < 0)
+    {
+        _misses++;
+        return nullptr;
+    }
+    _hits++;
+    _entries[i].lastUse = ++_useClock;
+    return _entries[i].config;
+}
+
+bool ThemeCache::contains(StrView path) const
+{
+    return indexOf(path) >= 0;
+}
+
+void ThemeCache::store(StrView path, StrView source, const FileStamp &stamp, const ThemeConfig &config)
+{
+    int8_t slot = indexOf(path);
+    if (slot < 0)
+    {
+        // 优先空位，否则淘汰最久未使用的一项
+        slot = 0;
+        for (uint8_t i = 0; i < CAPACITY; i++)
+        {
+            if (!_entries[i].valid)
+            {
+                slot = i;
+                break;
+            }
+            if (_entries[i].lastUse < _entries[slot].lastUse)
+                slot = i;
+        }
+        if (_entries[slot].valid)
+            _evictions++;
+    }
+
+    Entry &entry = _entries[slot];
+    if (entry.config)
+        *entry.config = config;
+    else
+        entry.config = allocConfig(config);
+    entry.valid = entry.config != nullptr;
+    if (!entry.valid)
+        return;
+    entry.path = path;
+    entry.source = source;
+    entry.stamp = stamp;
+    entry.lastUse = ++_useClock;
+}
+
+void ThemeCache::invalidate(StrView path)
+{
+    int8_t i = indexOf(path);
+    if (i < 0)
+        return;
+    _entries[i].valid = false;
+}
+
+bool ThemeCache::sourceOf(StrView path, FilePath &source, FileStamp &stamp) const
+{
+    int8_t i = indexOf(path);
+    if (i < 0)
+        return false;
+    source = _entries[i].source;
+    stamp = _entries[i].stamp;
+    return true;
+}
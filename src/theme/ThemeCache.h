@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+#include "core/AssetStore.h"
+#include "ThemeTypes.h"
+
+// 已解析主题的有界 LRU 缓存，ThemeConfig 本体放在 PSRAM 中。
+// 每项记录实际加载的源文件（.thm 或 .json）及其 FileStamp，重载时据此判断是否失效。
+// 槽位内存分配后一直复用，淘汰、失效或重载时只覆盖内容，不重新分配。
+class ThemeCache
+{
+public:
+    static constexpr uint8_t CAPACITY = 8;
+
+    ThemeCache() = default;
+    ThemeCache(const ThemeCache &) = delete;
+    ThemeCache &operator=(const ThemeCache &) = delete;
+    ~ThemeCache();
+
+    // 查找并计入命中/未命中统计
+    const ThemeConfig *find(StrView path);
+    // 只判断是否存在，不影响统计与 LRU 顺序（用于预取）
+    bool contains(StrView path) const;
+    void store(StrView path, StrView source, const FileStamp &stamp, const ThemeConfig &config);
+    void invalidate(StrView path);
+
+    // 返回缓存项对应的源文件与时间戳，未缓存时返回 false
+    bool sourceOf(StrView path, FilePath &source, FileStamp &stamp) const;
+
+    uint32_t hits() const { return _hits; }
+    uint32_t misses() const { return _misses; }
+    uint32_t evictions() const { return _evictions; }
+    uint8_t size() const;
+
+private:
+    struct Entry
+    {
+        FilePath path;
+        FilePath source;
+        FileStamp stamp;
+        ThemeConfig *config = nullptr;
+        bool valid = false;
+        uint32_t lastUse = 0;
+    };
+
+    Entry _entries[CAPACITY];
+    uint32_t _useClock = 0;
+    uint32_t _hits = 0;
+    uint32_t _misses = 0;
+    uint32_t _evictions = 0;
+
+    int8_t indexOf(StrView path) const;
+    static ThemeConfig *allocConfig(const ThemeConfig &config);
+    static void freeConfig(ThemeConfig *config);
+};
@@ -0,0 +1,70 @@
+#include "ThemeDiff.h"
+
+namespace
+{
+ModuleStyle ThemeConfig::*const MODULE_FIELDS[ThemeDiff::MODULE_COUNT] = {
+    &ThemeConfig::timeModule,
+    &ThemeConfig::envModule,
+    &ThemeConfig::alarmModule,
+};
+
+TextStyle ThemeConfig::*const TEXT_FIELDS[ThemeDiff::TEXT_COUNT] = {
+    &ThemeConfig::timeText, &ThemeConfig::dateText,     &ThemeConfig::tempText,
+    &ThemeConfig::humidText, &ThemeConfig::pressureText, &ThemeConfig::alarmText,
+};
+
+uint8_t bitCount(uint8_t bits)
+{
+    uint8_t count = 0;
+    for (; bits; bits &= bits - 1)
+        count++;
+    return count;
+}
+} // namespace
+
+ModuleStyle ThemeConfig::*ThemeDiff::moduleField(uint8_t module)
+{
+    return MODULE_FIELDS[module];
+}
+
+TextStyle ThemeConfig::*ThemeDiff::textField(uint8_t text)
+{
+    return TEXT_FIELDS[text];
+}
+
+ThemeDiff ThemeDiff::between(const ThemeConfig &from, const ThemeConfig &to)
+{
+    ThemeDiff diff;
+    // 路径偏移只在各自的路径表内有效，比较实际路径
+    diff.background = from.backgroundColor != to.backgroundColor ||
+                      from.path(from.backgroundImage) != to.path(to.backgroundImage);
+    diff.weatherIcon = from.path(from.weatherIcon) != to.path(to.weatherIcon);
+
+    for (uint8_t i = 0; i < MODULE_COUNT; i++)
+    {
+        const ModuleStyle &a = from.*MODULE_FIELDS[i];
+        const ModuleStyle &b = to.*MODULE_FIELDS[i];
+        if (a.x != b.x || a.y != b.y || a.w != b.w || a.h != b.h)
+            diff.movedModules |= 1 << i;
+        else if (a.color != b.color || a.opacity != b.opacity)
+            diff.restyledModules |= 1 << i;
+    }
+
+    for (uint8_t i = 0; i < TEXT_COUNT; i++)
+    {
+        const TextStyle &a = from.*TEXT_FIELDS[i];
+        const TextStyle &b = to.*TEXT_FIELDS[i];
+        if (a.x != b.x || a.y != b.y)
+            diff.movedTexts |= 1 << i;
+        else if (a.size != b.size || a.color != b.color || a.font != b.font)
+            diff.restyledTexts |= 1 << i;
+        else if (a.value != b.value)
+            diff.editedTexts |= 1 << i;
+    }
+    return diff;
+}
+
+uint8_t ThemeDiff::changes() const
+{
+    return (background ? 1 : 0) + (weatherIcon ? 1 : 0) + bitCount(modules()) + bitCount(texts());
+}
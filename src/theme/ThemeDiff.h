@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Arduino.h>
+#include "ThemeTypes.h"
+
+// 两套 ThemeConfig 的结构差异：每个面板与文本字段各占一位，按变化类型分组。
+// 热重载时据此只把受影响的区域记为脏区；比较只读两份配置，不分配内存。
+struct ThemeDiff
+{
+    // 位序即 ThemeConfig 中的字段顺序
+    enum Module : uint8_t
+    {
+        TIME_MODULE,
+        ENV_MODULE,
+        ALARM_MODULE,
+        MODULE_COUNT,
+    };
+    enum Text : uint8_t
+    {
+        TIME_TEXT,
+        DATE_TEXT,
+        TEMP_TEXT,
+        HUMID_TEXT,
+        PRESSURE_TEXT,
+        ALARM_TEXT,
+        TEXT_COUNT,
+    };
+
+    bool background = false;      // 背景色或背景图
+    bool weatherIcon = false;     // 天气图标路径
+    uint8_t movedModules = 0;     // 位置或尺寸变化
+    uint8_t restyledModules = 0;  // 只有颜色或不透明度变化
+    uint8_t movedTexts = 0;       // 位置变化
+    uint8_t restyledTexts = 0;    // 位置不变，颜色、字号或字体变化
+    uint8_t editedTexts = 0;      // 只有文字内容变化
+
+    static ThemeDiff between(const ThemeConfig &from, const ThemeConfig &to);
+
+    static ModuleStyle ThemeConfig::*moduleField(uint8_t module);
+    static TextStyle ThemeConfig::*textField(uint8_t text);
+
+    uint8_t modules() const { return movedModules | restyledModules; }
+    uint8_t texts() const { return movedTexts | restyledTexts | editedTexts; }
+    // 除文字内容外还有变化（时钟走动只改内容，不算布局变化）
+    bool layoutChanged() const { return background || weatherIcon || modules() || movedTexts || restyledTexts; }
+    bool empty() const { return !layoutChanged() && !editedTexts; }
+    // 变化的字段数（背景、图标、每个面板与文本各计一项）
+    uint8_t changes() const;
+};
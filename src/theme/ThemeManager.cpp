@@ -1,16 +1,75 @@
 #include "ThemeManager.h"
+#include "core/AllocCounter.h"
+#include "core/AssetStore.h"
+#include "core/Log.h"
+#include "core/Profiler.h"
+
+namespace
+{
+const char *INDEX_PATH = "/theme_config.json";
+
+// 温度、湿度、气压三段文本按 Quantity 的顺序排列；光照不上屏
+constexpr uint8_t SENSOR_TEXTS = 3;
+// 读数越过进位边界不足这么多（显示单位）时不换显示值，滤波后的残余噪声不会让数字来回跳
+constexpr float SENSOR_HYSTERESIS = 0.2f;
+
+// 写入定长字段，放不下时截断并告警
+template <size_t N>
+void loadString(const char *value, FixedString<N> &field)
+{
+    if (!field.assign(value))
+        Log::printf("[主题] ⚠️ 超过 %u 字节已截断: %s\n", static_cast<unsigned>(FixedString<N>::CAPACITY), value);
+}
+
+// 文本中恰好有一段整数（可带负号）时给出它的范围；没有数字或有多段数字时返回 false
+bool findNumber(StrView view, size_t &start, size_t &end)
+{
+    end = 0;
+    for (size_t i = 0; i < view.size(); i++)
+    {
+        if (view[i] < '0' || view[i] > '9')
+            continue;
+        if (end)
+            return false;
+        start = i > 0 && view[i - 1] == '-' ? i - 1 : i;
+        while (i < view.size() && view[i] >= '0' && view[i] <= '9')
+            i++;
+        end = i;
+    }
+    return end != 0;
+}
+
+// 主题文件里的读数只是占位：文本中恰好有一段整数时把它换成 value；
+// 没有数字或有多段数字的文本（天气描述、"7~19" 这样的预报区间）保持原样并返回 false
+bool replaceNumber(TextValue &text, int32_t value)
+{
+    const StrView view = text.view();
+    size_t start = 0;
+    size_t end = 0;
+    if (!findNumber(view, start, end))
+        return false;
+
+    char number[12];
+    const int length = snprintf(number, sizeof(number), "%ld", static_cast<long>(value));
+    TextValue result(StrView(view.data(), start));
+    result.append(StrView(number, length));
+    result.append(StrView(view.data() + end, view.size() - end));
+    text = result;
+    return true;
+}
+} // namespace
 
 uint16_t ThemeManager::rgbTo565(uint8_t r, uint8_t g, uint8_t b)
 {
     return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
 }
 
-uint16_t ThemeManager::parseColor(const String &hex, uint16_t fallback)
+uint16_t ThemeManager::parseColor(const char *hex, uint16_t fallback)
 {
-    if (hex.length() != 7 || hex[0] != '#')
+    if (!hex || strlen(hex) != 7 || hex[0] != '#')
         return fallback;
 
-    long value = strtol(hex.substring(1).c_str(), nullptr, 16);
+    long value = strtol(hex + 1, nullptr, 16);
     return rgbTo565((value >> 16) & 0xFF, (value >> 8) & 0xFF, value & 0xFF);
 }
 
@@ -19,8 +78,9 @@ void ThemeManager::loadTextStyle(JsonObject obj, TextStyle &style)
     if (obj["x"].is<int>()) style.x = obj["x"].as<int>();
     if (obj["y"].is<int>()) style.y = obj["y"].as<int>();
     if (obj["size"].is<int>()) style.size = obj["size"].as<int>();
-    if (obj["color"].is<const char *>()) style.color = parseColor(obj["color"].as<String>(), style.color);
-    if (obj["value"].is<const char *>()) style.value = obj["value"].as<String>();
+    if (obj["color"].is<const char *>()) style.color = parseColor(obj["color"].as<const char *>(), style.color);
+    if (obj["value"].is<const char *>()) loadString(obj["value"].as<const char *>(), style.value);
+    if (obj["font"].is<const char *>()) loadString(obj["font"].as<const char *>(), style.font);
 }
 
 void ThemeManager::loadModuleStyle(JsonObject obj, ModuleStyle &style)
@@ -30,24 +90,45 @@ void ThemeManager::loadModuleStyle(JsonObject obj, ModuleStyle &style)
     if (obj["w"].is<int>()) style.w = obj["w"].as<int>();
     if (obj["h"].is<int>()) style.h = obj["h"].as<int>();
     if (obj["opacity"].is<int>()) style.opacity = constrain(obj["opacity"].as<int>(), 0, 255);
-    if (obj["color"].is<const char *>()) style.color = parseColor(obj["color"].as<String>(), style.color);
+    if (obj["color"].is<const char *>()) style.color = parseColor(obj["color"].as<const char *>(), style.color);
+}
+
+bool ThemeManager::probeFile(const char *path, FileStamp &stamp)
+{
+    return Assets.stat(path, stamp);
+}
+
+bool ThemeManager::sourceChanged(const FilePath &path, const FilePath &source, const FileStamp &cachedStamp)
+{
+    FileStamp currentStamp;
+    probeFile(source.c_str(), currentStamp);
+    if (currentStamp != cachedStamp)
+        return true;
+    FileStamp jsonStamp;
+    return source != path && probeFile(path.c_str(), jsonStamp) && jsonStamp.mtime > cachedStamp.mtime;
 }
 
-bool ThemeManager::readJson(const char *path, DynamicJsonDocument &doc)
+bool ThemeManager::readJson(const char *path, DynamicJsonDocument &doc, FileStamp *stamp)
 {
-    File file = SPIFFS.open(path, "r");
-    if (!file)
+    PROFILE_ZONE("readJson");
+    // 整个文件一次读进缓冲再解析（归档中的 JSON 可能是压缩存储的），不逐字节经文件流读取
+    FileStamp found;
+    char *text = Assets.stat(path, found) ? static_cast<char *>(malloc(found.size + 1)) : nullptr;
+    size_t size = 0;
+    if (!text || !Assets.load(path, text, found.size, size, stamp))
     {
-        Serial.printf("[主题] ❌ 打开配置失败: %s\n", path);
+        free(text);
+        Log::printf("[主题] ❌ 打开配置失败: %s\n", path);
         return false;
     }
 
-    auto err = deserializeJson(doc, file);
-    file.close();
+    // 以 const 输入解析，字符串拷进文档，缓冲可以立即释放
+    auto err = deserializeJson(doc, static_cast<const char *>(text), size);
+    free(text);
 
     if (err)
     {
-        Serial.printf("[主题] ❌ 解析 JSON 失败: %s, 错误: %s\n", path, err.c_str());
+        Log::printf("[主题] ❌ 解析 JSON 失败: %s, 错误: %s\n", path, err.c_str());
         return false;
     }
     return true;
@@ -56,18 +137,20 @@ bool ThemeManager::readJson(const char *path, DynamicJsonDocument &doc)
 bool ThemeManager::loadThemeIndex()
 {
     DynamicJsonDocument doc(2048);
-    if (!readJson("/theme_config.json", doc))
+    FileStamp stamp;
+    if (!readJson(INDEX_PATH, doc, &stamp))
         return false;
+    _indexStamp = stamp;
 
-    _themeIndex.activeTheme = doc["activeTheme"] | "/themes/theme1.json";
+    loadString(doc["activeTheme"] | "/themes/theme1.json", _themeIndex.activeTheme);
     _themeIndex.themeCount = 0;
 
     JsonArray arr = doc["themes"].as<JsonArray>();
     for (JsonVariant v : arr)
     {
-        if (_themeIndex.themeCount >= 8)
+        if (_themeIndex.themeCount >= ThemeIndex::MAX_THEMES)
             break;
-        _themeIndex.themes[_themeIndex.themeCount++] = v.as<String>();
+        loadString(v.as<const char *>(), _themeIndex.themes[_themeIndex.themeCount++]);
     }
 
     if (_themeIndex.themeCount == 0)
@@ -86,83 +169,181 @@ bool ThemeManager::loadThemeIndex()
         }
     }
 
-    Serial.printf("[主题] ✅ 主题索引加载完成, active=%s, count=%d\n", _themeIndex.activeTheme.c_str(), _themeIndex.themeCount);
+    restoreSavedTheme();
+    Log::printf("[主题] ✅ 主题索引加载完成, active=%s, count=%d\n", _themeIndex.activeTheme.c_str(), _themeIndex.themeCount);
     return true;
 }
 
-bool ThemeManager::loadTheme(const String &path)
+FilePath ThemeManager::compiledPathFor(StrView jsonPath)
 {
+    FilePath path = jsonPath.endsWith(".json") ? jsonPath.substr(0, jsonPath.size() - 5) : jsonPath;
+    path.append(".thm");
+    return path;
+}
+
+bool ThemeManager::readCompiledTheme(const FilePath &path, ThemeConfig &theme, FilePath &source, FileStamp &stamp)
+{
+    // 预编译主题由 tools/compile_themes.py 生成，缺失或校验失败时回退到 JSON
+    const FilePath binPath = compiledPathFor(path);
+    FileStamp binStamp;
+    if (!Assets.stat(binPath.c_str(), binStamp))
+        return false;
+    FileStamp jsonStamp;
+    if (probeFile(path.c_str(), jsonStamp) && jsonStamp.mtime > binStamp.mtime)
+    {
+        Log::printf("[主题] ⚠️ 二进制主题比 JSON 旧, 回退 JSON: %s\n", binPath.c_str());
+        return false;
+    }
+    if (binStamp.size > ThemeBinary::MAX_FILE_SIZE)
+    {
+        Log::printf("[主题] ⚠️ 二进制主题过大, 回退 JSON: %s\n", binPath.c_str());
+        return false;
+    }
+
+    uint8_t buffer[ThemeBinary::MAX_FILE_SIZE];
+    size_t size = 0;
+    ThemeConfig compiled;
+    if (!Assets.load(binPath.c_str(), buffer, sizeof(buffer), size, &binStamp) || !ThemeBinary::apply(buffer, size, compiled))
+    {
+        Log::printf("[主题] ⚠️ 二进制主题校验失败, 回退 JSON: %s\n", binPath.c_str());
+        return false;
+    }
+
+    theme = compiled;
+    source = binPath;
+    stamp = binStamp;
+    return true;
+}
+
+bool ThemeManager::readTheme(const FilePath &path, ThemeConfig &theme, FilePath &source, FileStamp &stamp)
+{
+    const unsigned long start = micros();
+    if (readCompiledTheme(path, theme, source, stamp))
+    {
+        if (theme.paths.overflowed())
+            Log::printf("[主题] ⚠️ 路径超过 %u 字节已忽略: %s\n", static_cast<unsigned>(FilePath::CAPACITY), source.c_str());
+        Log::printf("[主题] ✅ 主题配置加载成功: %s (二进制, %lu us)\n", path.c_str(), micros() - start);
+        return true;
+    }
+
     DynamicJsonDocument doc(4096);
-    if (!readJson(path.c_str(), doc))
+    if (!readJson(path.c_str(), doc, &stamp))
         return false;
 
-    _theme = ThemeConfig();
+    // 默认值与空的路径表，整套主题从头填写
+    theme.reset();
+    source = path;
 
     JsonObject background = doc["background"];
     if (!background.isNull())
     {
-        _theme.backgroundColor = parseColor(background["color"] | "#0B1328", _theme.backgroundColor);
-        _theme.backgroundImage = background["image"] | "";
+        theme.backgroundColor = parseColor(background["color"] | "#0B1328", theme.backgroundColor);
+        theme.backgroundImage = theme.paths.intern(background["image"] | "");
     }
 
     JsonObject texts = doc["text"];
     if (!texts.isNull())
     {
-        loadTextStyle(texts["time"], _theme.timeText);
-        loadTextStyle(texts["date"], _theme.dateText);
-        loadTextStyle(texts["temp"], _theme.tempText);
-        loadTextStyle(texts["humidity"], _theme.humidText);
-        loadTextStyle(texts["pressure"], _theme.pressureText);
-        loadTextStyle(texts["alarm"], _theme.alarmText);
+        loadTextStyle(texts["time"], theme.timeText);
+        loadTextStyle(texts["date"], theme.dateText);
+        loadTextStyle(texts["temp"], theme.tempText);
+        loadTextStyle(texts["humidity"], theme.humidText);
+        loadTextStyle(texts["pressure"], theme.pressureText);
+        loadTextStyle(texts["alarm"], theme.alarmText);
     }
 
     JsonObject modules = doc["modules"];
     if (!modules.isNull())
     {
-        loadModuleStyle(modules["time"], _theme.timeModule);
-        loadModuleStyle(modules["environment"], _theme.envModule);
-        loadModuleStyle(modules["alarm"], _theme.alarmModule);
+        loadModuleStyle(modules["time"], theme.timeModule);
+        loadModuleStyle(modules["environment"], theme.envModule);
+        loadModuleStyle(modules["alarm"], theme.alarmModule);
     }
 
     JsonObject images = doc["images"];
     if (!images.isNull())
     {
-        _theme.weatherIcon = images["weatherIcon"] | _theme.weatherIcon;
-        _theme.wifiIcon = images["wifiIcon"] | "";
-        _theme.batteryIcon = images["batteryIcon"] | "";
+        if (images["weatherIcon"].is<const char *>())
+            theme.weatherIcon = theme.paths.intern(images["weatherIcon"].as<const char *>());
+        theme.wifiIcon = theme.paths.intern(images["wifiIcon"] | "");
+        theme.batteryIcon = theme.paths.intern(images["batteryIcon"] | "");
     }
 
-    Serial.printf("[主题] ✅ 主题配置加载成功: %s\n", path.c_str());
+    if (theme.paths.overflowed())
+        Log::printf("[主题] ⚠️ 路径超过 %u 字节已忽略: %s\n", static_cast<unsigned>(FilePath::CAPACITY), path.c_str());
+    Log::printf("[主题] ✅ 主题配置加载成功: %s (JSON, %lu us)\n", path.c_str(), micros() - start);
     return true;
 }
 
-void ThemeManager::saveThemeIndex()
+bool ThemeManager::loadTheme(const FilePath &path)
 {
-    DynamicJsonDocument doc(2048);
-    doc["activeTheme"] = _themeIndex.themes[_currentThemeIndex];
-    JsonArray arr = doc.createNestedArray("themes");
-    for (uint8_t i = 0; i < _themeIndex.themeCount; i++)
-        arr.add(_themeIndex.themes[i]);
-
-    File file = SPIFFS.open("/theme_config.json", "w");
-    if (!file)
+    PROFILE_ZONE("loadTheme");
+    const unsigned long start = micros();
+    const ThemeConfig *cached = _cache.find(path);
+    if (cached)
     {
-        Serial.println("[主题] ❌ 保存主题索引失败");
-        return;
+        _theme = *cached;
+        applySensorValues();
+        Log::printf("[主题] ⚡ 主题缓存命中: %s (%lu us)\n", path.c_str(), micros() - start);
+        return true;
     }
 
-    serializeJsonPretty(doc, file);
-    file.close();
+    // 直接读进 _theme 会在失败时留下半套配置，先读到临时对象
+    ThemeConfig theme;
+    FilePath source;
+    FileStamp stamp;
+    if (!readTheme(path, theme, source, stamp))
+        return false;
+
+    _cache.store(path, source, stamp, theme);
+    _theme = theme;
+    applySensorValues();
+    return true;
+}
+
+bool ThemeManager::prefetchTheme(const FilePath &path)
+{
+    if (_cache.contains(path))
+        return false;
+
+    ThemeConfig theme;
+    FilePath source;
+    FileStamp stamp;
+    if (!readTheme(path, theme, source, stamp))
+        return false;
+
+    _cache.store(path, source, stamp, theme);
+    _prefetches++;
+    Log::printf("[主题缓存] 📥 已预取: %s\n", path.c_str());
+    return true;
+}
+
+void ThemeManager::printCacheStats() const
+{
+    Log::printf("[主题缓存] 命中 %u, 未命中 %u, 预取 %u, 淘汰 %u, 已缓存 %u/%u\n",
+                static_cast<unsigned>(_cache.hits()), static_cast<unsigned>(_cache.misses()),
+                static_cast<unsigned>(_prefetches), static_cast<unsigned>(_cache.evictions()),
+                _cache.size(), ThemeCache::CAPACITY);
+}
+
+void ThemeManager::restoreSavedTheme()
+{
+    // NVS 中的记录优先于索引文件里的 activeTheme（后者只作为首次启动的默认值）
+    uint8_t saved = _persistence.restore(_themeIndex.themes, _themeIndex.themeCount);
+    if (saved == ThemePersistence::NO_INDEX)
+        return;
+    _currentThemeIndex = saved;
+    _themeIndex.activeTheme = _themeIndex.themes[saved];
 }
 
 void ThemeManager::setDefaultThemeData()
 {
-    _theme.timeText = {70, 64, 4, 0xFFFF, "14:30"};
-    _theme.dateText = {70, 104, 2, rgbTo565(0xA7, 0xB2, 0xC7), "2026-10-24"};
-    _theme.tempText = {20, 170, 2, 0xFFFF, "TEMP 26C"};
-    _theme.humidText = {20, 194, 2, 0xFFFF, "HUM 45%"};
-    _theme.pressureText = {20, 218, 2, 0xFFFF, "PRES 1013"};
-    _theme.alarmText = {14, 276, 2, rgbTo565(0xF8, 0xD5, 0x74), "TODO 15:00"};
+    _theme.timeText = {70, 64, 4, 0xFFFF, "14:30", ""};
+    _theme.dateText = {70, 104, 2, rgbTo565(0xA7, 0xB2, 0xC7), "2026-10-24", ""};
+    _theme.tempText = {20, 170, 2, 0xFFFF, "TEMP 26C", ""};
+    _theme.humidText = {20, 194, 2, 0xFFFF, "HUM 45%", ""};
+    _theme.pressureText = {20, 218, 2, 0xFFFF, "PRES 1013", ""};
+    _theme.alarmText = {14, 276, 2, rgbTo565(0xF8, 0xD5, 0x74), "TODO 15:00", ""};
 
     _theme.timeModule = {52, 42, 138, 94, 210, rgbTo565(0x1F, 0x2B, 0x46)};
     _theme.envModule = {12, 152, 216, 84, 220, rgbTo565(0x25, 0x32, 0x50)};
@@ -172,6 +353,7 @@ void ThemeManager::setDefaultThemeData()
 bool ThemeManager::begin()
 {
     setDefaultThemeData();
+    _persistence.begin();
 
     if (!loadThemeIndex())
     {
@@ -186,6 +368,7 @@ bool ThemeManager::begin()
         _themeIndex.themes[5] = "/themes/theme6.json";
         _themeIndex.activeTheme = _themeIndex.themes[0];
         _currentThemeIndex = 0;
+        restoreSavedTheme();
     }
 
     if (!loadTheme(_themeIndex.activeTheme))
@@ -193,6 +376,7 @@ bool ThemeManager::begin()
         Serial.println("[主题] ⚠️ 当前主题加载失败，使用默认样式");
         return false;
     }
+    _prefetchPending = true;
     return true;
 }
 
@@ -201,41 +385,175 @@ bool ThemeManager::switchToNextTheme()
     if (_themeIndex.themeCount == 0)
         return false;
 
-    _currentThemeIndex = (_currentThemeIndex + 1) % _themeIndex.themeCount;
+    return switchToTheme((_currentThemeIndex + 1) % _themeIndex.themeCount);
+}
+
+bool ThemeManager::switchToPreviousTheme()
+{
+    if (_themeIndex.themeCount == 0)
+        return false;
+
+    return switchToTheme((_currentThemeIndex + _themeIndex.themeCount - 1) % _themeIndex.themeCount);
+}
+
+bool ThemeManager::switchToTheme(uint8_t index)
+{
+    const uint32_t allocationsBefore = AllocCounter::count();
+    _currentThemeIndex = index;
     _themeIndex.activeTheme = _themeIndex.themes[_currentThemeIndex];
 
     if (!loadTheme(_themeIndex.activeTheme))
         return false;
 
-    saveThemeIndex();
-    Serial.printf("[主题] 🔁 已切换到第 %d 套主题: %s\n", _currentThemeIndex + 1, _themeIndex.activeTheme.c_str());
+    _persistence.request(_currentThemeIndex, _themeIndex.activeTheme);
+    _prefetchPending = true;
+    _lastSwitchAllocations = AllocCounter::count() - allocationsBefore;
+    Log::printf("[主题] 🔁 已切换到第 %d 套主题: %s (分配 %u 次)\n", _currentThemeIndex + 1, _themeIndex.activeTheme.c_str(),
+                static_cast<unsigned>(_lastSwitchAllocations));
+    printCacheStats();
     return true;
 }
 
 bool ThemeManager::reloadActiveTheme()
 {
-    if (!loadThemeIndex())
+    Assets.refresh();
+    // 索引文件大小与修改时间都未变化时不再重新解析
+    FileStamp indexStamp;
+    if (!probeFile(INDEX_PATH, indexStamp) || indexStamp != _indexStamp)
+    {
+        if (!loadThemeIndex())
+            return false;
+    }
+
+    const ThemeConfig before = _theme;
+    const FilePath &path = _themeIndex.activeTheme;
+    FilePath source;
+    FileStamp cachedStamp;
+    bool unchanged = false;
+    if (_cache.sourceOf(path, source, cachedStamp))
+    {
+        unchanged = !sourceChanged(path, source, cachedStamp);
+        if (!unchanged)
+            _cache.invalidate(path);
+    }
+
+    if (!loadTheme(path))
+        return false;
+    // 主题文件里的时间只是占位，重载后继续显示当前时钟
+    formatClock();
+
+    _lastReloadDiff = ThemeDiff::between(before, _theme);
+    const ThemeDiff &diff = _lastReloadDiff;
+    Log::printf("[主题] ♻️ %s, 差异 %u 项: 背景 %u, 面板 移动 %02X / 换色 %02X, 文本 移动 %02X / 样式 %02X / 内容 %02X, 图标 %u\n",
+                unchanged ? "主题文件未变化, 沿用缓存" : "已重新加载主题", diff.changes(), diff.background,
+                diff.movedModules, diff.restyledModules, diff.movedTexts, diff.restyledTexts, diff.editedTexts, diff.weatherIcon);
+    return true;
+}
+
+bool ThemeManager::filesChanged() const
+{
+    // 归档挂载时先更新散装文件覆盖表，上传的 JSON 才能被探测到
+    Assets.refresh();
+    // 索引缺失时两边都是空时间戳，不会反复触发
+    FileStamp indexStamp;
+    probeFile(INDEX_PATH, indexStamp);
+    if (indexStamp != _indexStamp)
+        return true;
+
+    FilePath source;
+    FileStamp cachedStamp;
+    if (!_cache.sourceOf(_themeIndex.activeTheme, source, cachedStamp))
         return false;
+    return sourceChanged(_themeIndex.activeTheme, source, cachedStamp);
+}
+
+void ThemeManager::service()
+{
+    _persistence.service();
+
+    // 空闲时预取轮换顺序中的下一套主题，使下次切换直接命中缓存
+    if (!_prefetchPending)
+        return;
+    _prefetchPending = false;
 
-    bool ok = loadTheme(_themeIndex.activeTheme);
-    if (ok)
-        Serial.println("[主题] ♻️ 已从 SPIFFS 重新加载主题");
-    return ok;
+    if (_themeIndex.themeCount < 2)
+        return;
+    uint8_t next = (_currentThemeIndex + 1) % _themeIndex.themeCount;
+    prefetchTheme(_themeIndex.themes[next]);
 }
 
-void ThemeManager::tickMockClock()
+void ThemeManager::tickMockClock(uint16_t seconds)
 {
-    static uint8_t minute = 30;
-    static uint8_t hour = 14;
+    _clockSeconds = (_clockSeconds + seconds) % 86400UL;
+    formatClock();
+}
 
-    minute++;
-    if (minute >= 60)
+void ThemeManager::setClockFormat(bool showSeconds)
+{
+    _clockShowSeconds = showSeconds;
+    formatClock();
+}
+
+void ThemeManager::setClockColonVisible(bool visible)
+{
+    _clockColonVisible = visible;
+    formatClock();
+}
+
+void ThemeManager::formatClock()
+{
+    const uint8_t hour = _clockSeconds / 3600;
+    const uint8_t minute = _clockSeconds / 60 % 60;
+    const uint8_t second = _clockSeconds % 60;
+    const char colon = _clockColonVisible ? ':' : ' ';
+
+    char buff[9];
+    buff[0] = '0' + hour / 10;
+    buff[1] = '0' + hour % 10;
+    buff[2] = colon;
+    buff[3] = '0' + minute / 10;
+    buff[4] = '0' + minute % 10;
+    buff[5] = colon;
+    buff[6] = '0' + second / 10;
+    buff[7] = '0' + second % 10;
+    _theme.timeText.value.assign(StrView(buff, _clockShowSeconds ? 8 : 5));
+}
+
+bool ThemeManager::setSensorValue(Quantity quantity, float value)
+{
+    const uint8_t slot = static_cast<uint8_t>(quantity);
+    if (slot >= SENSOR_TEXTS)
+        return false;
+
+    const uint8_t bit = 1 << slot;
+    const int32_t rounded = static_cast<int32_t>(lroundf(value));
+    if ((_sensorValid & bit) &&
+        (rounded == _sensorShown[slot] || fabsf(value - _sensorShown[slot]) < 0.5f + SENSOR_HYSTERESIS))
+        return false;
+
+    _sensorShown[slot] = rounded;
+    _sensorValid |= bit;
+    TextStyle *texts[SENSOR_TEXTS] = {&_theme.tempText, &_theme.humidText, &_theme.pressureText};
+    return replaceNumber(texts[slot]->value, rounded);
+}
+
+bool ThemeManager::showsSensor(Quantity quantity) const
+{
+    const uint8_t slot = static_cast<uint8_t>(quantity);
+    if (slot >= SENSOR_TEXTS)
+        return false;
+    const TextStyle *texts[SENSOR_TEXTS] = {&_theme.tempText, &_theme.humidText, &_theme.pressureText};
+    size_t start = 0;
+    size_t end = 0;
+    return findNumber(texts[slot]->value.view(), start, end);
+}
+
+void ThemeManager::applySensorValues()
+{
+    TextStyle *texts[SENSOR_TEXTS] = {&_theme.tempText, &_theme.humidText, &_theme.pressureText};
+    for (uint8_t slot = 0; slot < SENSOR_TEXTS; slot++)
     {
-        minute = 0;
-        hour = (hour + 1) % 24;
+        if (_sensorValid & (1 << slot))
+            replaceNumber(texts[slot]->value, _sensorShown[slot]);
     }
-
-    char buff[6];
-    snprintf(buff, sizeof(buff), "%02d:%02d", hour, minute);
-    _theme.timeText.value = String(buff);
 }
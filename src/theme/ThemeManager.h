@@ -1,9 +1,13 @@
 #pragma once
 
 #include <Arduino.h>
-#include <SPIFFS.h>
 #include <ArduinoJson.h>
 #include "ThemeTypes.h"
+#include "ThemeBinary.h"
+#include "ThemeCache.h"
+#include "ThemeDiff.h"
+#include "ThemePersistence.h"
+#include "sensors/SensorDriver.h"
 
 class ThemeManager
 {
@@ -11,26 +15,70 @@ public:
     bool begin();
 
     bool switchToNextTheme();
+    bool switchToPreviousTheme();
+    // 重新读取索引与当前主题（文件未变化时沿用缓存），保留时钟文本，并记录与重载前的差异
     bool reloadActiveTheme();
-    void tickMockClock();
+    // 文件监视：比较索引与当前主题源文件（.thm 或 .json）的大小与修改时间，只探测不加载；
+    // 当前用 .thm 时 JSON 比它新也算变化（上传了新的 JSON）
+    bool filesChanged() const;
+    // 模拟时钟前进 seconds 秒并改写时间文本（写入已有缓冲，不分配内存）
+    void tickMockClock(uint16_t seconds = 60);
+    // showSeconds 时显示 HH:MM:SS；冒号隐藏时以空格占位，时钟组件只需重画冒号格
+    void setClockFormat(bool showSeconds);
+    void setClockColonVisible(bool visible);
+    // 把传感器读数四舍五入后写进温度/湿度/气压文本中唯一的一段数字（"TEMP 26C" -> "TEMP 27C"）；
+    // 显示值不变、或只在进位边界附近抖动时不改文本并返回 false。切换与重载主题后沿用最近的读数
+    bool setSensorValue(Quantity quantity, float value);
+    // 当前主题的该行文本是否显示这个读数（只有一段数字，setSensorValue 能改写它）
+    bool showsSensor(Quantity quantity) const;
+    // 在 loop() 空闲时调用：执行延后的主题预取与当前主题保存
+    void service();
+    void printCacheStats() const;
 
     const ThemeConfig &theme() const { return _theme; }
+    const FilePath &activeThemePath() const { return _themeIndex.activeTheme; }
+    const ThemeDiff &lastReloadDiff() const { return _lastReloadDiff; }
     uint8_t currentThemeNumber() const { return _currentThemeIndex + 1; }
+    const ThemePersistence &persistence() const { return _persistence; }
+    // 最近一次主题切换（加载、缓存与持久化请求）在 loop() 所在核上的堆分配次数
+    uint32_t lastSwitchAllocations() const { return _lastSwitchAllocations; }
 
 private:
     ThemeConfig _theme;
     ThemeIndex _themeIndex;
     uint8_t _currentThemeIndex = 0;
 
-    bool readJson(const char *path, DynamicJsonDocument &doc);
+    ThemeCache _cache;
+    FileStamp _indexStamp;
+    bool _prefetchPending = false;
+    uint32_t _prefetches = 0;
+    uint32_t _clockSeconds = 14 * 3600L + 30 * 60;
+    bool _clockShowSeconds = false;
+    bool _clockColonVisible = true;
+    int32_t _sensorShown[3] = {};
+    uint8_t _sensorValid = 0;
+    uint32_t _lastSwitchAllocations = 0;
+    ThemeDiff _lastReloadDiff;
+    ThemePersistence _persistence;
+
+    bool readJson(const char *path, DynamicJsonDocument &doc, FileStamp *stamp = nullptr);
     bool loadThemeIndex();
-    bool loadTheme(const String &path);
-    void saveThemeIndex();
+    bool loadTheme(const FilePath &path);
+    bool switchToTheme(uint8_t index);
+    void formatClock();
+    void applySensorValues();
+    bool prefetchTheme(const FilePath &path);
+    bool readTheme(const FilePath &path, ThemeConfig &theme, FilePath &source, FileStamp &stamp);
+    bool readCompiledTheme(const FilePath &path, ThemeConfig &theme, FilePath &source, FileStamp &stamp);
+    void restoreSavedTheme();
 
     void setDefaultThemeData();
 
+    static bool probeFile(const char *path, FileStamp &stamp);
+    static bool sourceChanged(const FilePath &path, const FilePath &source, const FileStamp &cachedStamp);
+    static FilePath compiledPathFor(StrView jsonPath);
     static uint16_t rgbTo565(uint8_t r, uint8_t g, uint8_t b);
-    static uint16_t parseColor(const String &hex, uint16_t fallback);
+    static uint16_t parseColor(const char *hex, uint16_t fallback);
     static void loadTextStyle(JsonObject obj, TextStyle &style);
     static void loadModuleStyle(JsonObject obj, ModuleStyle &style);
 };
@@ -0,0 +1,88 @@
+#include "ThemePersistence.h"
+#include "ThemeBinary.h"
+#include "core/Log.h"
+
+namespace
+{
+const char *NVS_NAMESPACE = "theme";
+const char *NVS_KEY = "active";
+constexpr uint8_t RECORD_VERSION = 1;
+} // namespace
+
+uint32_t ThemePersistence::pathCrc(StrView path)
+{
+    return ThemeBinary::crc32(reinterpret_cast<const uint8_t *>(path.data()), path.size());
+}
+
+bool ThemePersistence::begin()
+{
+    _ready = _prefs.begin(NVS_NAMESPACE, false);
+    if (!_ready)
+    {
+        Serial.println("[主题] ⚠️ NVS 打开失败, 当前主题将不会保存");
+        return false;
+    }
+
+    Record record;
+    if (_prefs.getBytesLength(NVS_KEY) == sizeof(record) && _prefs.getBytes(NVS_KEY, &record, sizeof(record)) == sizeof(record) &&
+        record.version == RECORD_VERSION)
+        _stored = record;
+    _wanted = _stored;
+    return true;
+}
+
+uint8_t ThemePersistence::restore(const FilePath *paths, uint8_t count) const
+{
+    if (_wanted.index == NO_INDEX)
+        return NO_INDEX;
+    if (_wanted.index < count && pathCrc(paths[_wanted.index]) == _wanted.pathCrc)
+        return _wanted.index;
+
+    // 索引列表被改动过：按路径重新定位
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (pathCrc(paths[i]) == _wanted.pathCrc)
+            return i;
+    }
+    return NO_INDEX;
+}
+
+void ThemePersistence::request(uint8_t index, StrView path)
+{
+    _wanted = {RECORD_VERSION, index, pathCrc(path)};
+    _pending = _wanted.index != _stored.index || _wanted.pathCrc != _stored.pathCrc;
+    _lastRequestMs = millis();
+    _requests++;
+    // 切回已保存的主题时这一批不会写入，计数从头开始
+    _batch = _pending ? _batch + 1 : 0;
+}
+
+void ThemePersistence::service()
+{
+    if (_pending && millis() - _lastRequestMs >= DEBOUNCE_MS)
+        flush();
+}
+
+bool ThemePersistence::flush()
+{
+    if (!_pending || !_ready)
+        return false;
+
+    const unsigned long start = micros();
+    if (_prefs.putBytes(NVS_KEY, &_wanted, sizeof(_wanted)) != sizeof(_wanted))
+    {
+        // 保留待写标记并重新计时，下一个防抖周期再试
+        _lastRequestMs = millis();
+        Log::printf("[主题] ❌ 保存当前主题失败，%u ms 后重试\n", static_cast<unsigned>(DEBOUNCE_MS));
+        return false;
+    }
+    _pending = false;
+    _stored = _wanted;
+    _writes++;
+    const uint32_t batch = _batch;
+    _batch = 0;
+    _lastFlushMicros = micros() - start;
+    Log::printf("[主题] 💾 已保存当前主题 #%d (合并 %u 次切换, 第 %u 次写入, %u us)\n", _stored.index + 1,
+                static_cast<unsigned>(batch), static_cast<unsigned>(_writes), static_cast<unsigned>(_lastFlushMicros));
+    return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "core/FixedString.h"
+
+// 当前主题的持久化：切换时只记下目标，静默 DEBOUNCE_MS 后由 service() 合并成一次写入。
+// 记录是 NVS 中的一个 6 字节条目（序号 + 主题路径 CRC），不再整份重写 theme_config.json。
+class ThemePersistence
+{
+public:
+    static constexpr uint32_t DEBOUNCE_MS = 1500;
+    static constexpr uint8_t NO_INDEX = 0xFF;
+
+    bool begin();
+
+    // 返回记录中（含尚未落盘的变更）的主题序号；路径 CRC 与 paths[index] 不符时按 CRC 重新定位，找不到返回 NO_INDEX
+    uint8_t restore(const FilePath *paths, uint8_t count) const;
+
+    // 记录新的当前主题，重置防抖计时；不会立即写闪存
+    void request(uint8_t index, StrView path);
+    // 在 loop() 空闲时调用：防抖到期后写入
+    void service();
+    // 立即写入尚未落盘的变更（例如关机前），返回是否发生了写入
+    bool flush();
+
+    bool pending() const { return _pending; }
+    uint32_t writeCount() const { return _writes; }
+    uint32_t requestCount() const { return _requests; }
+    uint32_t lastFlushMicros() const { return _lastFlushMicros; }
+
+private:
+#pragma pack(push, 1)
+    struct Record
+    {
+        uint8_t version;
+        uint8_t index;
+        uint32_t pathCrc;
+    };
+#pragma pack(pop)
+
+    Preferences _prefs;
+    bool _ready = false;
+    bool _pending = false;
+    Record _stored = {0, NO_INDEX, 0};
+    Record _wanted = {0, NO_INDEX, 0};
+    unsigned long _lastRequestMs = 0;
+
+    uint32_t _writes = 0;
+    uint32_t _requests = 0;
+    uint32_t _batch = 0;
+    uint32_t _lastFlushMicros = 0;
+
+    static uint32_t pathCrc(StrView path);
+};
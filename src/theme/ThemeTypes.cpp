@@ -0,0 +1,43 @@
+#include "ThemeTypes.h"
+
+#include <type_traits>
+
+namespace
+{
+const char *DEFAULT_WEATHER_ICON = "/icons/weather/default.bin";
+} // namespace
+
+static_assert(std::is_trivially_copyable<ThemeConfig>::value, "ThemeConfig must stay allocation-free to copy");
+
+PathTable::Ref PathTable::intern(StrView path)
+{
+    if (path.empty())
+        return EMPTY;
+    if (path.size() > FilePath::CAPACITY)
+    {
+        _overflowed = true;
+        return EMPTY;
+    }
+
+    // 表很小，线性查找已有的相同路径即可
+    for (Ref ref = 1; ref < _used; ref += strlen(_data + ref) + 1)
+    {
+        if ((*this)[ref] == path)
+            return ref;
+    }
+    if (_used + path.size() + 1 > CAPACITY)
+    {
+        _overflowed = true;
+        return EMPTY;
+    }
+    const Ref ref = _used;
+    memcpy(_data + ref, path.data(), path.size());
+    _data[ref + path.size()] = '\0';
+    _used += path.size() + 1;
+    return ref;
+}
+
+ThemeConfig::ThemeConfig()
+{
+    weatherIcon = paths.intern(DEFAULT_WEATHER_ICON);
+}
@@ -1,6 +1,11 @@
 #pragma once
 
 #include <Arduino.h>
+#include "core/FixedString.h"
+
+// 文本字段容量：31 字节 UTF-8（约 10 个汉字），超长的内容加载时截断并告警
+typedef FixedString<32> TextValue;
+typedef FixedString<16> FontName;
 
 struct TextStyle
 {
@@ -8,7 +13,9 @@ struct TextStyle
     int16_t y = 0;
     uint8_t size = 1;
     uint16_t color = 0xFFFF;
-    String value;
+    TextValue value;
+    // 字体包名（对应 /fonts/<font>.fnt），为空时使用内置 5x7 点阵字体并按 size 放大
+    FontName font;
 };
 
 struct ModuleStyle
@@ -21,10 +28,47 @@ struct ModuleStyle
     uint16_t color = 0x2104;
 };
 
+// 主题内的路径表：一块随主题一起拷贝的定长内存，路径依次追加、相同路径只存一份，
+// 字段只保存偏移（偏移 0 固定是空串）。每次加载主题时整体重置，不会累积碎片。
+class PathTable
+{
+public:
+    typedef uint16_t Ref;
+    static constexpr Ref EMPTY = 0;
+    // 背景、天气、WiFi、电池四条路径各按 SPIFFS 文件名上限留足
+    static constexpr uint16_t CAPACITY = 4 * 32 + 1;
+
+    PathTable() { reset(); }
+
+    void reset()
+    {
+        _data[0] = '\0';
+        _used = 1;
+        _overflowed = false;
+    }
+    // 返回路径的偏移；路径超过 SPIFFS 文件名上限或表已满时返回 EMPTY 并记下溢出
+    Ref intern(StrView path);
+    StrView operator[](Ref ref) const { return ref < _used ? StrView(_data + ref) : StrView(); }
+
+    uint16_t used() const { return _used; }
+    bool overflowed() const { return _overflowed; }
+
+private:
+    char _data[CAPACITY];
+    uint16_t _used = 1;
+    bool _overflowed = false;
+};
+
+// 全部成员都是定长的，ThemeConfig 可按值拷贝（缓存、渲染快照、已显示场景）而不分配内存
 struct ThemeConfig
 {
+    ThemeConfig();
+    // 恢复默认值并清空路径表
+    void reset() { *this = ThemeConfig(); }
+    StrView path(PathTable::Ref ref) const { return paths[ref]; }
+
     uint16_t backgroundColor = 0x0842;
-    String backgroundImage;
+    PathTable::Ref backgroundImage = PathTable::EMPTY;
 
     TextStyle timeText;
     TextStyle dateText;
@@ -37,14 +81,18 @@ struct ThemeConfig
     ModuleStyle envModule;
     ModuleStyle alarmModule;
 
-    String weatherIcon = "/icons/weather/default.bin";
-    String wifiIcon;
-    String batteryIcon;
+    PathTable::Ref weatherIcon = PathTable::EMPTY;
+    PathTable::Ref wifiIcon = PathTable::EMPTY;
+    PathTable::Ref batteryIcon = PathTable::EMPTY;
+
+    PathTable paths;
 };
 
 struct ThemeIndex
 {
-    String activeTheme = "/themes/theme1.json";
-    String themes[8];
+    static constexpr uint8_t MAX_THEMES = 8;
+
+    FilePath activeTheme = "/themes/theme1.json";
+    FilePath themes[MAX_THEMES];
     uint8_t themeCount = 0;
 };
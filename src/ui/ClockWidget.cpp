@@ -0,0 +1,180 @@
+#include "ClockWidget.h"
+
+namespace
+{
+// 精灵下标与字符的对应：0-9、冒号、空格
+const char SPRITE_CHARS[] = "0123456789: ";
+
+uint16_t *allocPixels(size_t count)
+{
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound())
+        return static_cast<uint16_t *>(ps_malloc(count * sizeof(uint16_t)));
+#endif
+    return static_cast<uint16_t *>(malloc(count * sizeof(uint16_t)));
+}
+} // namespace
+
+ClockWidget::~ClockWidget()
+{
+    free(_pixels);
+}
+
+int8_t ClockWidget::spriteIndex(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c == ':')
+        return 10;
+    if (c == ' ')
+        return 11;
+    return -1;
+}
+
+bool ClockWidget::validText(StrView text)
+{
+    if (text.length() == 0 || text.length() > MAX_CELLS)
+        return false;
+    for (size_t i = 0; i < text.length(); i++)
+    {
+        if (spriteIndex(text[i]) < 0)
+            return false;
+    }
+    return true;
+}
+
+void ClockWidget::reset()
+{
+    _active = false;
+    _platesValid = false;
+    _count = 0;
+}
+
+bool ClockWidget::prepare(const TextStyle &style, uint16_t panelColor)
+{
+    reset();
+    if (style.font.length() > 0 || style.size == 0 || style.size > MAX_SIZE)
+        return false;
+
+    _x = style.x;
+    _y = style.y;
+    _size = style.size;
+    _color = style.color;
+    _panelColor = panelColor;
+
+    const size_t cell = cellPixels();
+    const size_t needed = cell * (SPRITE_COUNT + MAX_CELLS + 1);
+    if (needed > _capacity)
+    {
+        free(_pixels);
+        _pixels = allocPixels(needed);
+        _capacity = _pixels ? needed : 0;
+        if (!_pixels)
+        {
+            Serial.println("[时钟] ❌ 精灵缓冲内存不足，改用文本绘制");
+            return false;
+        }
+    }
+    _sprites = _pixels;
+    _plates = _sprites + cell * SPRITE_COUNT;
+    _scratch = _plates + cell * MAX_CELLS;
+
+    for (uint8_t i = 0; i < SPRITE_COUNT; i++)
+        renderSprite(i, SPRITE_CHARS[i]);
+    _active = true;
+    return true;
+}
+
+void ClockWidget::renderSprite(uint8_t index, char c)
+{
+    const int16_t w = cellWidth();
+    const int16_t h = cellHeight();
+    uint16_t *sprite = _sprites + cellPixels() * index;
+    for (int16_t row = 0; row < h; row++)
+    {
+        uint32_t mask = Font5x7::rowMask(c, _size, row);
+        for (int16_t col = 0; col < w; col++, mask >>= 1)
+            sprite[row * w + col] = (mask & 0x1) ? _color : _panelColor;
+    }
+}
+
+void ClockWidget::blitCell(FrameBuffer &canvas, uint8_t cell, char c)
+{
+    const int16_t w = cellWidth();
+    const uint32_t count = cellPixels();
+    const uint16_t *sprite = _sprites + count * spriteIndex(c);
+    const int16_t x = _x + cell * Font5x7::ADVANCE * _size;
+
+    if (!_platesValid)
+    {
+        // 直通模式：精灵底色即面板实色，直接推送
+        canvas.drawImage(x, _y, w, cellHeight(), sprite, w);
+        return;
+    }
+
+    // 按字形位掩码把墨迹叠到截取的底图（半透明面板后的背景图）上；不用颜色判断透明，
+    // 数字颜色与面板实色相同时照样画出
+    const uint16_t *plate = _plates + count * cell;
+    const int16_t h = cellHeight();
+    uint32_t i = 0;
+    for (int16_t row = 0; row < h; row++)
+    {
+        uint32_t mask = Font5x7::rowMask(c, _size, row);
+        for (int16_t col = 0; col < w; col++, i++, mask >>= 1)
+            _scratch[i] = (mask & 0x1) ? _color : plate[i];
+    }
+    canvas.drawImage(x, _y, w, h, _scratch, w);
+}
+
+bool ClockWidget::draw(FrameBuffer &canvas, StrView text)
+{
+    if (!_active || !validText(text))
+        return false;
+
+    const uint8_t count = text.length();
+    // 超出屏幕的部分不需要覆盖
+    const int16_t x1 = min<int16_t>(_x + (count - 1) * Font5x7::ADVANCE * _size + cellWidth() - 1, FrameBuffer::WIDTH - 1);
+    const int16_t y1 = min<int16_t>(_y + cellHeight() - 1, FrameBuffer::HEIGHT - 1);
+    const DirtyRect &clip = canvas.clip();
+    const bool covered = clip.x0 <= _x && clip.y0 <= _y && clip.x1 >= x1 && clip.y1 >= y1;
+
+    if (canvas.isBuffered())
+    {
+        if (!covered)
+        {
+            // 局部重画只补画裁剪区内的部分，底图与已显示内容保持不变
+            canvas.drawText(_x, _y, text, _color, _size);
+            return true;
+        }
+        // 此时字符格下方只有背景、面板与图标，截取为之后逐格更新的底图
+        for (uint8_t i = 0; i < count; i++)
+            canvas.readImage(_x + i * Font5x7::ADVANCE * _size, _y, cellWidth(), cellHeight(), _plates + cellPixels() * i, cellWidth());
+        _platesValid = true;
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+        blitCell(canvas, i, text[i]);
+    memcpy(_shown, text.data(), count);
+    _shown[count] = '\0';
+    _count = count;
+    return true;
+}
+
+bool ClockWidget::update(FrameBuffer &canvas, const TextStyle &style, uint32_t &pixels)
+{
+    pixels = 0;
+    if (!_active || !_platesValid || style.x != _x || style.y != _y || style.size != _size || style.color != _color ||
+        style.font.length() > 0 || style.value.length() != _count || !validText(style.value))
+        return false;
+
+    for (uint8_t i = 0; i < _count; i++)
+    {
+        const char c = style.value[i];
+        if (c == _shown[i])
+            continue;
+        blitCell(canvas, i, c);
+        _shown[i] = c;
+        pixels += cellPixels();
+    }
+    return true;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Arduino.h>
+#include "display/Font5x7.h"
+#include "display/FrameBuffer.h"
+#include "theme/ThemeTypes.h"
+
+// 大号数字时钟：主题加载时把 0-9、冒号与空格（闪烁时替代冒号）按时间文本的字号、颜色
+// 预渲染成 RGB565 精灵，精灵底色为面板与背景混合后的实色（无法回读的直通模式直接推送）。首次整块绘制时截取
+// 每个字符格下的画面，之后每次只比较新旧字符串，把变化的字符格按字形位掩码合成到截取的底图上贴回去，不做任何分配。
+// 只接管 5x7 点阵字体的时间文本；使用字体包、字号过大或含其他字符时由调用方按普通文本绘制。
+class ClockWidget
+{
+public:
+    static constexpr uint8_t MAX_CELLS = 8; // HH:MM:SS
+    static constexpr uint8_t MAX_SIZE = Font5x7::MAX_MASK_SIZE;
+
+    ClockWidget() = default;
+    ClockWidget(const ClockWidget &) = delete;
+    ClockWidget &operator=(const ClockWidget &) = delete;
+    ~ClockWidget();
+
+    // 按文本样式预渲染精灵，样式不适用时返回 false；之前截取的底图一并作废
+    bool prepare(const TextStyle &style, uint16_t panelColor);
+    void reset();
+    bool isActive() const { return _active; }
+
+    // 整块绘制；画布可回读且裁剪区覆盖全部字符格时顺带截取底图。text 不适用时返回 false
+    bool draw(FrameBuffer &canvas, StrView text);
+    // 只贴回与上次整块绘制/更新相比变化的字符格，pixels 为重画的像素数；
+    // 样式不同、长度变化或尚未截取底图时返回 false，由调用方整体重画
+    bool update(FrameBuffer &canvas, const TextStyle &style, uint32_t &pixels);
+
+    // 每个字符格只含字形墨迹（字距列始终为空，不必重画）
+    int16_t cellWidth() const { return Font5x7::GLYPH_WIDTH * _size; }
+    int16_t cellHeight() const { return Font5x7::GLYPH_HEIGHT * _size; }
+    uint32_t cellPixels() const { return static_cast<uint32_t>(cellWidth()) * cellHeight(); }
+
+private:
+    static constexpr uint8_t SPRITE_COUNT = 12;
+
+    bool _active = false;
+    int16_t _x = 0;
+    int16_t _y = 0;
+    uint8_t _size = 0;
+    uint16_t _color = 0;
+    uint16_t _panelColor = 0;
+
+    // 一次分配：SPRITE_COUNT 个精灵、MAX_CELLS 个底图与一个合成缓冲
+    uint16_t *_pixels = nullptr;
+    size_t _capacity = 0;
+    uint16_t *_sprites = nullptr; // 仅直通模式使用
+    uint16_t *_plates = nullptr;
+    uint16_t *_scratch = nullptr;
+
+    bool _platesValid = false;
+    char _shown[MAX_CELLS + 1] = {};
+    uint8_t _count = 0;
+
+    static int8_t spriteIndex(char c);
+    static bool validText(StrView text);
+    void renderSprite(uint8_t index, char c);
+    void blitCell(FrameBuffer &canvas, uint8_t cell, char c);
+};
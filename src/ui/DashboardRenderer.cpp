@@ -1,4 +1,74 @@
 #include "DashboardRenderer.h"
+#include "core/AllocCounter.h"
+#include "core/AssetStore.h"
+#include "core/Log.h"
+#include "core/Profiler.h"
+#include "display/Blend565.h"
+#include "display/Font5x7.h"
+
+namespace
+{
+const char *ICON_ATLAS_PATH = "/icons/weather_24.atlas";
+// 和风天气 999 为“未知”
+constexpr uint16_t UNKNOWN_WEATHER_CODE = 999;
+
+struct WeatherAlias
+{
+    const char *name;
+    uint16_t code;
+};
+
+// 别名比较不区分大小写
+bool equalsIgnoreCase(StrView text, const char *alias)
+{
+    size_t i = 0;
+    for (; i < text.size(); i++)
+    {
+        if (!alias[i] || tolower(static_cast<unsigned char>(text[i])) != alias[i])
+            return false;
+    }
+    return alias[i] == '\0';
+}
+
+const WeatherAlias WEATHER_ALIASES[] = {
+    {"sun", 100},     {"sunny", 100},  {"clear", 100}, {"cloudy", 101}, {"cloud", 101},
+    {"cloudsun", 102}, {"partly", 103}, {"overcast", 104}, {"rain", 305}, {"shower", 300},
+    {"thunder", 302}, {"snow", 400},   {"fog", 501},   {"haze", 502},   {"wind", 2075},
+};
+
+// 文本字段与其所在面板（直通模式下字形混合到面板底色上），顺序即场景中的 z 序，与 ThemeDiff::Text 的位序一致
+struct TextField
+{
+    TextStyle ThemeConfig::*text;
+    ModuleStyle ThemeConfig::*module;
+};
+
+const TextField TEXT_FIELDS[] = {
+    {&ThemeConfig::timeText, &ThemeConfig::timeModule},    {&ThemeConfig::dateText, &ThemeConfig::timeModule},
+    {&ThemeConfig::tempText, &ThemeConfig::envModule},     {&ThemeConfig::humidText, &ThemeConfig::envModule},
+    {&ThemeConfig::pressureText, &ThemeConfig::envModule}, {&ThemeConfig::alarmText, &ThemeConfig::alarmModule},
+};
+constexpr uint8_t TEXT_FIELD_COUNT = sizeof(TEXT_FIELDS) / sizeof(TEXT_FIELDS[0]);
+static_assert(TEXT_FIELD_COUNT == ThemeDiff::TEXT_COUNT, "Text fields must match ThemeDiff");
+// TEXT_FIELDS 中时间文本的下标
+constexpr uint8_t TIME_FIELD = ThemeDiff::TIME_TEXT;
+
+const DirtyRect EMPTY_RECT = {0, 0, -1, -1};
+
+DirtyRect rectOf(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    return {x, y, static_cast<int16_t>(x + w - 1), static_cast<int16_t>(y + h - 1)};
+}
+} // namespace
+
+DashboardRenderer::DashboardRenderer(FrameBuffer &canvas) : _canvas(canvas), _transition(canvas)
+{
+    // 只记录资源入口，字体包在首次使用时才打开
+    _text.begin(Assets);
+    _label.x = 8;
+    _label.y = 8;
+    _label.color = rgbTo565(0x68, 0xB0, 0xFF);
+}
 
 uint16_t DashboardRenderer::rgbTo565(uint8_t r, uint8_t g, uint8_t b)
 {
@@ -7,69 +77,357 @@ uint16_t DashboardRenderer::rgbTo565(uint8_t r, uint8_t g, uint8_t b)
 
 uint16_t DashboardRenderer::blend565(uint16_t fg, uint16_t bg, uint8_t alpha)
 {
-    uint8_t fr = ((fg >> 11) & 0x1F) << 3;
-    uint8_t fgG = ((fg >> 5) & 0x3F) << 2;
-    uint8_t fb = (fg & 0x1F) << 3;
+    return Blend565::blend(fg, bg, alpha);
+}
 
-    uint8_t br = ((bg >> 11) & 0x1F) << 3;
-    uint8_t bgG = ((bg >> 5) & 0x3F) << 2;
-    uint8_t bb = (bg & 0x1F) << 3;
+void DashboardRenderer::renderModule(const ModuleStyle &style, uint16_t backgroundColor)
+{
+    if (!_canvas.isBuffered())
+    {
+        // 直通模式无法回读背景，只能与背景色混合成实色
+        uint16_t color = blend565(style.color, backgroundColor, style.opacity);
+        _canvas.fillRect(style.x, style.y, style.w, style.h, color);
+        _canvas.drawRect(style.x, style.y, style.w, style.h, blend565(0xFFFF, color, 25));
+        return;
+    }
 
-    uint8_t r = ((uint16_t)fr * alpha + (uint16_t)br * (255 - alpha)) / 255;
-    uint8_t g = ((uint16_t)fgG * alpha + (uint16_t)bgG * (255 - alpha)) / 255;
-    uint8_t b = ((uint16_t)fb * alpha + (uint16_t)bb * (255 - alpha)) / 255;
+    // 半透明面板逐像素叠加在背景图上，边框再叠一层淡白色
+    _canvas.blendRect(style.x, style.y, style.w, style.h, style.color, style.opacity);
+    _canvas.blendRect(style.x, style.y, style.w, 1, 0xFFFF, 25);
+    _canvas.blendRect(style.x, style.y + style.h - 1, style.w, 1, 0xFFFF, 25);
+    _canvas.blendRect(style.x, style.y + 1, 1, style.h - 2, 0xFFFF, 25);
+    _canvas.blendRect(style.x + style.w - 1, style.y + 1, 1, style.h - 2, 0xFFFF, 25);
+}
 
-    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+uint16_t DashboardRenderer::weatherCodeFor(StrView iconPath)
+{
+    StrView name = iconPath;
+    int slash = name.rfind('/');
+    if (slash >= 0)
+        name = name.substr(slash + 1);
+    int dot = name.find('.');
+    if (dot >= 0)
+        name = name.substr(0, dot);
+    int dash = name.find('-');
+    if (dash >= 0)
+        name = name.substr(0, dash);
+
+    if (name.size() > 0 && name.size() <= 5 && isDigit(name[0]))
+    {
+        char digits[6];
+        memcpy(digits, name.data(), name.size());
+        digits[name.size()] = '\0';
+        long code = strtol(digits, nullptr, 10);
+        if (code > 0 && code <= 0xFFFF)
+            return static_cast<uint16_t>(code);
+    }
+
+    for (const WeatherAlias &alias : WEATHER_ALIASES)
+    {
+        if (equalsIgnoreCase(name, alias.name))
+            return alias.code;
+    }
+    return UNKNOWN_WEATHER_CODE;
 }
 
-void DashboardRenderer::renderModule(const ModuleStyle &style, uint16_t backgroundColor)
+const uint8_t *DashboardRenderer::weatherIconMask(const ThemeConfig &theme)
 {
-    uint16_t color = blend565(style.color, backgroundColor, style.opacity);
-    _display.fillRect(style.x, style.y, style.w, style.h, color);
-    _display.drawRect(style.x, style.y, style.w, style.h, blend565(0xFFFF, color, 25));
+    if (!_iconsLoaded)
+    {
+        // 首次渲染时（资源已挂载）加载一次，失败后不再重试
+        _iconsLoaded = true;
+        _icons.begin(Assets, ICON_ATLAS_PATH);
+    }
+    const StrView iconPath = theme.path(theme.weatherIcon);
+    if (iconPath != _iconPath)
+    {
+        _iconPath = iconPath;
+        _iconCode = weatherCodeFor(iconPath);
+    }
+    return _icons.find(_iconCode);
 }
 
-void DashboardRenderer::drawWeatherIconSlot(const String &iconPath, const ThemeConfig &theme)
+DirtyRect DashboardRenderer::weatherIconBounds(const ThemeConfig &theme)
 {
-    // 第一阶段仅渲染占位框与文件名，用户后续可替换为真实图标解码。
+    const ModuleStyle &module = theme.envModule;
+    if (weatherIconMask(theme))
+    {
+        const int16_t size = _icons.cellSize();
+        return rectOf(module.x + module.w - size - 8, module.y + 6, size, size);
+    }
+    return rectOf(module.x + module.w - 64, module.y + 8, 56, 22);
+}
+
+void DashboardRenderer::drawWeatherIcon(const ThemeConfig &theme)
+{
+    const uint8_t *mask = weatherIconMask(theme);
+    if (!mask)
+    {
+        drawWeatherIconSlot(theme.path(theme.weatherIcon), theme);
+        return;
+    }
+
+    const ModuleStyle &module = theme.envModule;
+    const int16_t size = _icons.cellSize();
+    uint16_t moduleColor = blend565(module.color, theme.backgroundColor, module.opacity);
+    _canvas.drawAlphaMask(module.x + module.w - size - 8, module.y + 6, size, size, mask, rgbTo565(0xD8, 0xE6, 0xFF), moduleColor);
+}
+
+void DashboardRenderer::drawWeatherIconSlot(StrView iconPath, const ThemeConfig &theme)
+{
+    // 图集缺失或代码未收录时的占位：渲染占位框与文件名
     const int16_t x = theme.envModule.x + theme.envModule.w - 64;
     const int16_t y = theme.envModule.y + 8;
     const int16_t w = 56;
     const int16_t h = 22;
 
     uint16_t bg = blend565(rgbTo565(0x3A, 0x4A, 0x6A), theme.backgroundColor, 190);
-    _display.fillRect(x, y, w, h, bg);
-    _display.drawRect(x, y, w, h, blend565(0xFFFF, bg, 35));
+    _canvas.fillRect(x, y, w, h, bg);
+    _canvas.drawRect(x, y, w, h, blend565(0xFFFF, bg, 35));
 
-    String name = iconPath;
-    int slash = name.lastIndexOf('/');
+    StrView name = iconPath;
+    int slash = name.rfind('/');
     if (slash >= 0)
-        name = name.substring(slash + 1);
-    if (name.length() > 8)
-        name = name.substring(0, 8);
-    if (name.length() == 0)
+        name = name.substr(slash + 1);
+    name = name.substr(0, 8);
+    if (name.empty())
         name = "icon";
 
-    _display.drawText(x + 4, y + 7, name, rgbTo565(0xD8, 0xE6, 0xFF), 1);
+    _canvas.drawText(x + 4, y + 7, name, rgbTo565(0xD8, 0xE6, 0xFF), 1);
 }
 
-void DashboardRenderer::render(const ThemeConfig &theme, uint8_t themeNumber)
+void DashboardRenderer::drawTextStyle(const TextStyle &style, const ModuleStyle &module, uint16_t backgroundColor)
 {
-    _display.fillScreen(theme.backgroundColor);
+    if (style.font.length() > 0)
+    {
+        // 直通模式下字形混合到所在面板的实色上
+        uint16_t moduleColor = blend565(module.color, backgroundColor, module.opacity);
+        if (_text.drawText(_canvas, style.x, style.y, style.value, style.font, style.color, moduleColor))
+            return;
+    }
+    _canvas.drawText(style.x, style.y, style.value, style.color, style.size);
+}
 
-    renderModule(theme.timeModule, theme.backgroundColor);
-    renderModule(theme.envModule, theme.backgroundColor);
-    renderModule(theme.alarmModule, theme.backgroundColor);
+DirtyRect DashboardRenderer::textBounds(const TextStyle &style)
+{
+    DirtyRect ink;
+    if (style.font.length() > 0 && _text.measureText(style.value, style.font, ink))
+        return ink.x0 > ink.x1 ? EMPTY_RECT : DirtyRect{static_cast<int16_t>(style.x + ink.x0), static_cast<int16_t>(style.y + ink.y0),
+                                                        static_cast<int16_t>(style.x + ink.x1), static_cast<int16_t>(style.y + ink.y1)};
 
-    drawWeatherIconSlot(theme.weatherIcon, theme);
+    if (style.value.length() == 0 || style.size == 0)
+        return EMPTY_RECT;
+    // 最后一个字符后的字距列不含墨迹
+    const int16_t width = ((style.value.length() - 1) * Font5x7::ADVANCE + Font5x7::GLYPH_WIDTH) * style.size;
+    return rectOf(style.x, style.y, width, Font5x7::GLYPH_HEIGHT * style.size);
+}
 
-    _display.drawText(theme.timeText.x, theme.timeText.y, theme.timeText.value, theme.timeText.color, theme.timeText.size);
-    _display.drawText(theme.dateText.x, theme.dateText.y, theme.dateText.value, theme.dateText.color, theme.dateText.size);
-    _display.drawText(theme.tempText.x, theme.tempText.y, theme.tempText.value, theme.tempText.color, theme.tempText.size);
-    _display.drawText(theme.humidText.x, theme.humidText.y, theme.humidText.value, theme.humidText.color, theme.humidText.size);
-    _display.drawText(theme.pressureText.x, theme.pressureText.y, theme.pressureText.value, theme.pressureText.color, theme.pressureText.size);
-    _display.drawText(theme.alarmText.x, theme.alarmText.y, theme.alarmText.value, theme.alarmText.color, theme.alarmText.size);
+const TextStyle &DashboardRenderer::textAt(const ThemeConfig &theme, uint8_t slot) const
+{
+    return slot < TEXT_FIELD_COUNT ? theme.*TEXT_FIELDS[slot].text : _label;
+}
+
+void DashboardRenderer::prepareClock(const ThemeConfig &theme)
+{
+    const ModuleStyle &module = theme.timeModule;
+    _clock.prepare(theme.timeText, blend565(module.color, theme.backgroundColor, module.opacity));
+}
+
+void DashboardRenderer::buildScene(const ThemeConfig &theme, uint8_t themeNumber)
+{
+    _shown = theme;
+    _shownNumber = themeNumber;
+    prepareClock(theme);
+    char label[12];
+    snprintf(label, sizeof(label), "THEME:%u", static_cast<unsigned>(themeNumber));
+    _label.value = label;
+    _sceneBuilt = true;
+
+    _scene.clear();
+    _scene.add(SceneGraph::Kind::Background, 0, rectOf(0, 0, FrameBuffer::WIDTH, FrameBuffer::HEIGHT));
+    for (uint8_t i = 0; i < ThemeDiff::MODULE_COUNT; i++)
+    {
+        const ModuleStyle &module = theme.*ThemeDiff::moduleField(i);
+        _moduleNodes[i] = _scene.add(SceneGraph::Kind::Module, i, rectOf(module.x, module.y, module.w, module.h));
+    }
+    _iconNode = _scene.add(SceneGraph::Kind::Icon, 0, weatherIconBounds(theme));
+    for (uint8_t i = 0; i < TEXT_NODES; i++)
+        _textNodes[i] = _scene.add(SceneGraph::Kind::Text, i, textBounds(textAt(theme, i)));
+    _shownCharts = _charts;
+    for (uint8_t i = 0; i < EnvCharts::COUNT; i++)
+        _chartNodes[i] = _scene.add(SceneGraph::Kind::Chart, i, _shownCharts.lines[i].bounds());
+}
+
+void DashboardRenderer::applyLayout(const ThemeConfig &theme, const ThemeDiff &diff)
+{
+    // 面板、图标与路径表换成新主题；文本仍保留已显示的内容，随后由 updateScene 按差异更新
+    ThemeConfig next = theme;
+    for (uint8_t i = 0; i < ThemeDiff::TEXT_COUNT; i++)
+        next.*ThemeDiff::textField(i) = _shown.*ThemeDiff::textField(i);
+    _shown = next;
+
+    // 面板的旧、新范围都记为脏区，压在上面的图标与文本按 z 序一并重画
+    for (uint8_t i = 0; i < ThemeDiff::MODULE_COUNT; i++)
+    {
+        if (!(diff.modules() & (1 << i)))
+            continue;
+        const ModuleStyle &module = _shown.*ThemeDiff::moduleField(i);
+        _scene.setBounds(_moduleNodes[i], rectOf(module.x, module.y, module.w, module.h));
+    }
+    // 图标贴在环境面板右上角
+    if (diff.weatherIcon || (diff.modules() & (1 << ThemeDiff::ENV_MODULE)))
+        _scene.setBounds(_iconNode, weatherIconBounds(_shown));
+    // 时钟精灵的底色取自时间面板，换色后重新预渲染并重画整段时间文本
+    if (diff.modules() & (1 << ThemeDiff::TIME_MODULE))
+    {
+        prepareClock(_shown);
+        _scene.setBounds(_textNodes[TIME_FIELD], textBounds(_shown.timeText));
+    }
+}
+
+void DashboardRenderer::updateScene(const ThemeConfig &theme, uint8_t changedTexts)
+{
+    for (uint8_t i = 0; i < TEXT_FIELD_COUNT; i++)
+    {
+        if (!(changedTexts & (1 << i)))
+            continue;
+
+        TextStyle ThemeConfig::*field = TEXT_FIELDS[i].text;
+        uint32_t pixels = 0;
+        if (i == TIME_FIELD && _clock.update(_canvas, theme.timeText, pixels))
+        {
+            // 只有数字变化：已逐格贴回，不必让场景重画整段文本
+            _shown.timeText.value = theme.timeText.value;
+            _clockPixels += pixels;
+            continue;
+        }
+        _shown.*field = theme.*field;
+        if (i == TIME_FIELD)
+            prepareClock(_shown);
+        _scene.setBounds(_textNodes[i], textBounds(_shown.*field));
+    }
+}
+
+void DashboardRenderer::updateCharts()
+{
+    for (uint8_t i = 0; i < EnvCharts::COUNT; i++)
+    {
+        if (_charts.lines[i] == _shownCharts.lines[i])
+            continue;
+        _shownCharts.lines[i] = _charts.lines[i];
+        _scene.setBounds(_chartNodes[i], _shownCharts.lines[i].bounds());
+    }
+}
+
+void DashboardRenderer::drawChart(uint8_t slot)
+{
+    const Sparkline &line = _shownCharts.lines[slot];
+    // 用同一行文字的颜色，按 60% 混到面板实色上，比读数本身淡一些
+    const TextField &field = TEXT_FIELDS[ThemeDiff::TEMP_TEXT + slot];
+    const ModuleStyle &module = _shown.*field.module;
+    const uint16_t moduleColor = blend565(module.color, _shown.backgroundColor, module.opacity);
+    const uint16_t color = blend565((_shown.*field.text).color, moduleColor, 153);
+    for (uint8_t c = 0; c < line.width; c++)
+    {
+        const uint8_t column = line.columns[c];
+        const uint8_t top = Sparkline::top(column);
+        const uint8_t bottom = Sparkline::bottom(column);
+        if (top <= bottom)
+            _canvas.fillRect(line.x + c, line.y + top, 1, bottom - top + 1, color);
+    }
+}
+
+void DashboardRenderer::paintNode(const SceneGraph::Node &node)
+{
+    switch (node.kind)
+    {
+    case SceneGraph::Kind::Background:
+        if (!_backgrounds.draw(_shown.path(_shown.backgroundImage), _canvas))
+            _canvas.fillScreen(_shown.backgroundColor);
+        break;
+    case SceneGraph::Kind::Module:
+        renderModule(_shown.*ThemeDiff::moduleField(node.slot), _shown.backgroundColor);
+        break;
+    case SceneGraph::Kind::Icon:
+        drawWeatherIcon(_shown);
+        break;
+    case SceneGraph::Kind::Text:
+        // 最后一个文本节点是 "THEME:" 标签，固定用 5x7 字体
+        if (node.slot == TIME_FIELD && _clock.draw(_canvas, _shown.timeText.value))
+            break;
+        if (node.slot < TEXT_FIELD_COUNT)
+            drawTextStyle(_shown.*TEXT_FIELDS[node.slot].text, _shown.*TEXT_FIELDS[node.slot].module, _shown.backgroundColor);
+        else
+            _canvas.drawText(_label.x, _label.y, _label.value, _label.color, 1);
+        break;
+    case SceneGraph::Kind::Chart:
+        drawChart(node.slot);
+        break;
+    }
+}
+
+void DashboardRenderer::compose(const ThemeConfig &theme, uint8_t themeNumber)
+{
+    PROFILE_ZONE("compose");
+    _clockPixels = 0;
+    _lastDiff = ThemeDiff();
+    if (!_sceneBuilt || themeNumber != _shownNumber)
+        buildScene(theme, themeNumber);
+    else
+    {
+        // 同一套主题（时钟走动或热重载）：只重画差异涉及的节点；背景铺满整屏，变化时直接重建
+        _lastDiff = ThemeDiff::between(_shown, theme);
+        if (_lastDiff.background)
+            buildScene(theme, themeNumber);
+        else
+        {
+            if (_lastDiff.layoutChanged())
+                applyLayout(theme, _lastDiff);
+            updateScene(theme, _lastDiff.texts());
+            updateCharts();
+        }
+    }
+
+    // 直通模式下部分图元不受裁剪，只能整屏重画
+    if (!_canvas.isBuffered())
+        _scene.invalidateAll();
+
+    _repaintPixels = _scene.repaint(_canvas, [this](const SceneGraph::Node &node) { paintNode(node); }) + _clockPixels;
+}
+
+void DashboardRenderer::render(const ThemeConfig &theme, uint8_t themeNumber)
+{
+    PROFILE_ZONE("render");
+    const uint32_t allocationsBefore = AllocCounter::count();
+    compose(theme, themeNumber);
+
+    // 画布只把与上一帧不同的区域推送到屏幕
+    uint32_t bytes = _canvas.flush();
+    _allocations = AllocCounter::count() - allocationsBefore;
+    if (_canvas.isBuffered())
+        Log::printf("[渲染] 重画 %u 像素, 刷新 %d 个脏矩形, SPI %u 字节, 分配 %u 次\n", static_cast<unsigned>(_repaintPixels),
+                    _canvas.lastFlushRects(), static_cast<unsigned>(bytes), static_cast<unsigned>(_allocations));
+    if (_lastDiff.layoutChanged())
+        Log::printf("[渲染] ♻️ 增量更新: 差异 %u 项, 重画 %u 像素 (整屏的 %u%%)\n", _lastDiff.changes(),
+                    static_cast<unsigned>(_repaintPixels),
+                    static_cast<unsigned>(_repaintPixels * 100 / (static_cast<uint32_t>(FrameBuffer::WIDTH) * FrameBuffer::HEIGHT)));
+    PROFILE_COUNTER("repaint_px", _repaintPixels);
+    PROFILE_COUNTER("allocs", _allocations);
+    PROFILE_MEMORY();
+}
+
+void DashboardRenderer::renderTransition(const ThemeConfig &theme, uint8_t themeNumber, ThemeTransition::Effect effect)
+{
+    if (effect == ThemeTransition::Effect::None || !_transition.available())
+    {
+        render(theme, themeNumber);
+        return;
+    }
 
-    // 修复原先 "THEME:" + String(...) 触发的运算符报错，使用 String 显式构造。
-    _display.drawText(8, 8, String("THEME:") + String(themeNumber), rgbTo565(0x68, 0xB0, 0xFF), 1);
+    // 新画面只画进后台缓冲，前台缓冲仍是屏幕上的旧画面，由过渡动画逐帧混合推送
+    const uint32_t allocationsBefore = AllocCounter::count();
+    const uint32_t start = micros();
+    compose(theme, themeNumber);
+    _transition.play(effect, micros() - start);
+    _allocations = AllocCounter::count() - allocationsBefore;
 }
@@ -1,22 +1,100 @@
 #pragma once
 
 #include <Arduino.h>
-#include "display/TftDriver.h"
+#include "display/BackgroundCache.h"
+#include "display/FrameBuffer.h"
+#include "display/IconAtlas.h"
+#include "display/TextRenderer.h"
+#include "theme/ThemeDiff.h"
 #include "theme/ThemeTypes.h"
+#include "ClockWidget.h"
+#include "SceneGraph.h"
+#include "Sparkline.h"
+#include "ThemeTransition.h"
 
+// 保留模式仪表盘：首次渲染、换主题或背景变化时按 ThemeConfig 重建场景，
+// 之后每次 render 与已显示的配置做 ThemeDiff，只把变化的面板、图标与文本节点旧、新范围记为脏区并局部重画
+// （热重载改了面板颜色时只重画该面板及压在上面的节点）；时间文本交给 ClockWidget，只贴回变化的数字格。
+// 环境历史迷你图是文本之上的三个节点，内容与位置由调用方算好（见 SparklinePlotter），变化时才重画
 class DashboardRenderer
 {
 public:
-    explicit DashboardRenderer(TftDriver &display) : _display(display) {}
+    explicit DashboardRenderer(FrameBuffer &canvas);
 
     void render(const ThemeConfig &theme, uint8_t themeNumber);
+    // 以过渡动画从屏幕上的旧画面切到新主题；画布不支持时等同 render
+    void renderTransition(const ThemeConfig &theme, uint8_t themeNumber, ThemeTransition::Effect effect);
+    // 下一次 render 显示的迷你图（width 为 0 的不显示）
+    void setCharts(const EnvCharts &charts) { _charts = charts; }
+    // 下一次 render 整屏重画（例如屏幕被外部改写后）
+    void invalidate() { _sceneBuilt = false; }
+
+    const BackgroundCache &backgrounds() const { return _backgrounds; }
+    const IconAtlas &icons() const { return _icons; }
+    const TextRenderer &text() const { return _text; }
+    const SceneGraph &scene() const { return _scene; }
+    const ClockWidget &clock() const { return _clock; }
+    const ThemeTransition &transition() const { return _transition; }
+    // 最近一帧局部重画的像素数（含时钟逐格贴图）
+    uint32_t lastRepaintPixels() const { return _repaintPixels; }
+    // 最近一帧与已显示配置的差异；重建场景（首帧或换主题）时为空
+    const ThemeDiff &lastDiff() const { return _lastDiff; }
+    // 最近一帧（合成、推送与过渡动画）在渲染所在核上的堆分配次数，稳态下应为 0
+    uint32_t lastAllocations() const { return _allocations; }
+
+    // 把主题里的天气图标名（如 /icons/weather/sun.bin）或数字文件名（如 /icons/100.svg）换算为和风天气代码
+    static uint16_t weatherCodeFor(StrView iconPath);
 
 private:
-    TftDriver &_display;
+    FrameBuffer &_canvas;
+    BackgroundCache _backgrounds;
+    IconAtlas _icons;
+    bool _iconsLoaded = false;
+    FilePath _iconPath;
+    uint16_t _iconCode = 0;
+    TextRenderer _text;
+
+    // 六个文本字段加左上角的 "THEME:" 标签
+    static constexpr uint8_t TEXT_NODES = 7;
+    SceneGraph _scene;
+    ThemeConfig _shown;
+    TextStyle _label;
+    uint8_t _shownNumber = 0;
+    bool _sceneBuilt = false;
+    uint8_t _moduleNodes[ThemeDiff::MODULE_COUNT];
+    uint8_t _iconNode = SceneGraph::NONE;
+    uint8_t _textNodes[TEXT_NODES];
+    uint8_t _chartNodes[EnvCharts::COUNT];
+    EnvCharts _charts;
+    EnvCharts _shownCharts;
+    ThemeDiff _lastDiff;
+    ClockWidget _clock;
+    uint32_t _clockPixels = 0;
+    uint32_t _repaintPixels = 0;
+    uint32_t _allocations = 0;
+    ThemeTransition _transition;
 
     static uint16_t rgbTo565(uint8_t r, uint8_t g, uint8_t b);
     static uint16_t blend565(uint16_t fg, uint16_t bg, uint8_t alpha);
 
     void renderModule(const ModuleStyle &style, uint16_t backgroundColor);
-    void drawWeatherIconSlot(const String &iconPath, const ThemeConfig &theme);
+    const uint8_t *weatherIconMask(const ThemeConfig &theme);
+    DirtyRect weatherIconBounds(const ThemeConfig &theme);
+    void drawWeatherIcon(const ThemeConfig &theme);
+    void drawWeatherIconSlot(StrView iconPath, const ThemeConfig &theme);
+    void drawTextStyle(const TextStyle &style, const ModuleStyle &module, uint16_t backgroundColor);
+    DirtyRect textBounds(const TextStyle &style);
+    const TextStyle &textAt(const ThemeConfig &theme, uint8_t slot) const;
+
+    void prepareClock(const ThemeConfig &theme);
+    void buildScene(const ThemeConfig &theme, uint8_t themeNumber);
+    // 面板、图标变化：换上新配置并把受影响节点记为脏区
+    void applyLayout(const ThemeConfig &theme, const ThemeDiff &diff);
+    // changedTexts 为 ThemeDiff 的文本位
+    void updateScene(const ThemeConfig &theme, uint8_t changedTexts);
+    void updateCharts();
+    void drawChart(uint8_t slot);
+    void paintNode(const SceneGraph::Node &node);
+    // 把场景画到后台缓冲，不推送
+    void compose(const ThemeConfig &theme, uint8_t themeNumber);
 };
@@ -0,0 +1,157 @@
+#include "RenderPipeline.h"
+#include "core/Log.h"
+
+bool RenderPipeline::begin()
+{
+    if (_task)
+        return true;
+
+    _running = true;
+    _exited = false;
+    if (xTaskCreatePinnedToCore(taskEntry, "render", STACK_BYTES, this, PRIORITY, &_task, RENDER_CORE) != pdPASS)
+    {
+        _task = nullptr;
+        _running = false;
+        Serial.println("[渲染] ⚠️ 渲染任务创建失败，改为在主循环中同步渲染");
+        return false;
+    }
+    Log::printf("[渲染] ✅ 渲染任务已启动 (核 %d)\n", static_cast<int>(RENDER_CORE));
+    return true;
+}
+
+void RenderPipeline::end()
+{
+    if (!_task)
+        return;
+
+    _running = false;
+    xTaskNotifyGive(_task);
+    while (!_exited)
+        vTaskDelay(1);
+    _task = nullptr;
+}
+
+void RenderPipeline::submit(const ThemeConfig &theme, uint8_t themeNumber, uint32_t inputMicros, bool fullRedraw,
+                            ThemeTransition::Effect transition, const EnvCharts *charts)
+{
+    _submitted++;
+    if (!_task)
+    {
+        Frame frame;
+        frame.theme = theme;
+        frame.charts = charts ? *charts : EnvCharts();
+        frame.themeNumber = themeNumber;
+        frame.fullRedraw = fullRedraw;
+        frame.transition = transition;
+        frame.inputMicros = inputMicros;
+        renderFrame(frame);
+        return;
+    }
+
+    if (_hasDeferred)
+    {
+        // 暂存的旧帧还没送进队列就被取代：保留更早的输入时刻、整屏重画与过渡动画请求
+        _dropped++;
+        _deferred.fullRedraw = _deferred.fullRedraw || fullRedraw;
+        if (transition != ThemeTransition::Effect::None)
+            _deferred.transition = transition;
+    }
+    else
+    {
+        _deferred.fullRedraw = fullRedraw;
+        _deferred.transition = transition;
+        _deferred.inputMicros = inputMicros;
+    }
+    _deferred.theme = theme;
+    _deferred.charts = charts ? *charts : EnvCharts();
+    _deferred.themeNumber = themeNumber;
+    _hasDeferred = true;
+    service();
+}
+
+void RenderPipeline::service()
+{
+    if (_hasDeferred && enqueue(_deferred))
+        _hasDeferred = false;
+}
+
+bool RenderPipeline::enqueue(const Frame &frame)
+{
+    // 先计数再入队，渲染任务减计数时不会出现下溢
+    _pending.fetch_add(1, std::memory_order_acq_rel);
+    if (!_queue.push(frame))
+    {
+        _pending.fetch_sub(1, std::memory_order_acq_rel);
+        return false;
+    }
+    _maxQueueDepth = max<uint32_t>(_maxQueueDepth, _queue.size());
+    xTaskNotifyGive(_task);
+    return true;
+}
+
+void RenderPipeline::renderFrame(const Frame &frame)
+{
+    if (frame.fullRedraw)
+        _renderer.invalidate();
+    _renderer.setCharts(frame.charts);
+    _renderer.renderTransition(frame.theme, frame.themeNumber, frame.transition);
+
+    const uint32_t latency = micros() - frame.inputMicros;
+    _lastLatency.store(latency, std::memory_order_relaxed);
+    if (latency > _maxLatency.load(std::memory_order_relaxed))
+        _maxLatency.store(latency, std::memory_order_relaxed);
+    _latencyTotal.fetch_add(latency, std::memory_order_relaxed);
+    _rendered.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RenderPipeline::run()
+{
+    Frame frame;
+    Frame newer;
+    while (_running)
+    {
+        if (!_queue.pop(frame))
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        // 队列里还有更新的快照时只画最新的一帧，延迟按最早的输入计算
+        uint32_t consumed = 1;
+        while (_queue.pop(newer))
+        {
+            newer.fullRedraw = newer.fullRedraw || frame.fullRedraw;
+            if (newer.transition == ThemeTransition::Effect::None)
+                newer.transition = frame.transition;
+            newer.inputMicros = frame.inputMicros;
+            std::swap(frame, newer);
+            consumed++;
+        }
+        _merged.fetch_add(consumed - 1, std::memory_order_relaxed);
+
+        renderFrame(frame);
+        _pending.fetch_sub(consumed, std::memory_order_acq_rel);
+    }
+
+    _exited = true;
+    vTaskDelete(nullptr);
+}
+
+void RenderPipeline::taskEntry(void *arg)
+{
+    static_cast<RenderPipeline *>(arg)->run();
+}
+
+RenderPipeline::Stats RenderPipeline::stats() const
+{
+    Stats s;
+    s.submitted = _submitted;
+    s.rendered = _rendered.load(std::memory_order_relaxed);
+    s.merged = _merged.load(std::memory_order_relaxed);
+    s.dropped = _dropped;
+    s.maxQueueDepth = _maxQueueDepth;
+    s.lastLatencyMicros = _lastLatency.load(std::memory_order_relaxed);
+    s.maxLatencyMicros = _maxLatency.load(std::memory_order_relaxed);
+    s.avgLatencyMicros = s.rendered ? static_cast<uint32_t>(_latencyTotal.load(std::memory_order_relaxed) / s.rendered) : 0;
+    return s;
+}
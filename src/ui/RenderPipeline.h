@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "core/SpscQueue.h"
+#include "theme/ThemeTypes.h"
+#include "DashboardRenderer.h"
+
+// 渲染流水线：DashboardRenderer（连同画布与 SPI）只在固定于另一个核的渲染任务里运行。
+// 输入与主题逻辑通过 submit() 投递不可变的帧快照，永远不会等待 SPI 传输。
+// 队列满时最新快照暂存在生产者一侧，由 service() 补投；渲染任务取帧时若队列中已有更新的快照，
+// 直接跳到最新一帧（场景按与已显示配置的差异增量重画，跳过中间帧不影响最终画面）。
+class RenderPipeline
+{
+public:
+    static constexpr size_t QUEUE_DEPTH = 4;
+    static constexpr uint32_t STACK_BYTES = 8192;
+    static constexpr UBaseType_t PRIORITY = 2;
+    // Arduino 的 loop() 跑在核 1，渲染放到核 0
+    static constexpr BaseType_t RENDER_CORE = 0;
+
+    struct Stats
+    {
+        uint32_t submitted;
+        uint32_t rendered;
+        uint32_t merged;  // 渲染任务取帧时被更新快照取代的帧
+        uint32_t dropped; // 队列满、暂存期间被更新快照覆盖的帧
+        uint32_t maxQueueDepth;
+        uint32_t lastLatencyMicros; // 输入时刻到该帧推送完成
+        uint32_t maxLatencyMicros;
+        uint32_t avgLatencyMicros;
+    };
+
+    explicit RenderPipeline(DashboardRenderer &renderer) : _renderer(renderer) {}
+
+    // 创建渲染任务；失败时 submit() 退化为在调用方同步渲染
+    bool begin();
+    // 停止渲染任务（主机端测试用），返回前任务已退出
+    void end();
+
+    // 投递一帧，不阻塞；inputMicros 为触发该帧的输入时刻，transition 为切换到这一帧时播放的过渡动画，
+    // charts 为这一帧的环境历史迷你图（随快照复制，为空时不显示）
+    void submit(const ThemeConfig &theme, uint8_t themeNumber, uint32_t inputMicros, bool fullRedraw = false,
+                ThemeTransition::Effect transition = ThemeTransition::Effect::None, const EnvCharts *charts = nullptr);
+    // 补投暂存的帧，在 loop() 中调用
+    void service();
+
+    // 队列已空、没有暂存帧且渲染任务空闲
+    bool idle() const { return !_hasDeferred && _pending.load(std::memory_order_acquire) == 0; }
+    size_t queueDepth() const { return _queue.size(); }
+    Stats stats() const;
+
+private:
+    struct Frame
+    {
+        ThemeConfig theme;
+        EnvCharts charts;
+        uint8_t themeNumber = 0;
+        bool fullRedraw = false;
+        ThemeTransition::Effect transition = ThemeTransition::Effect::None;
+        uint32_t inputMicros = 0;
+    };
+
+    DashboardRenderer &_renderer;
+    SpscQueue<Frame, QUEUE_DEPTH> _queue;
+    TaskHandle_t _task = nullptr;
+    std::atomic<bool> _running{false};
+    std::atomic<bool> _exited{false};
+    // 已投递但尚未渲染完成的帧数（含已入队和正在渲染的）
+    std::atomic<uint32_t> _pending{0};
+
+    // 以下只由生产者访问
+    Frame _deferred;
+    bool _hasDeferred = false;
+    uint32_t _submitted = 0;
+    uint32_t _dropped = 0;
+    uint32_t _maxQueueDepth = 0;
+
+    // 以下由渲染任务写入
+    std::atomic<uint32_t> _rendered{0};
+    std::atomic<uint32_t> _merged{0};
+    std::atomic<uint32_t> _lastLatency{0};
+    std::atomic<uint32_t> _maxLatency{0};
+    std::atomic<uint64_t> _latencyTotal{0};
+
+    bool enqueue(const Frame &frame);
+    void renderFrame(const Frame &frame);
+    void run();
+    static void taskEntry(void *arg);
+};
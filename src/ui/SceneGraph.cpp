@@ -0,0 +1,44 @@
+#include "SceneGraph.h"
+
+void SceneGraph::clear()
+{
+    _count = 0;
+    invalidateAll();
+}
+
+uint8_t SceneGraph::add(Kind kind, uint8_t slot, const DirtyRect &bounds)
+{
+    if (_count == MAX_NODES)
+        return NONE;
+
+    _nodes[_count] = {kind, slot, bounds};
+    invalidate(bounds);
+    return _count++;
+}
+
+void SceneGraph::setBounds(uint8_t id, const DirtyRect &bounds)
+{
+    if (id >= _count)
+        return;
+
+    invalidate(_nodes[id].bounds);
+    invalidate(bounds);
+    _nodes[id].bounds = bounds;
+}
+
+void SceneGraph::invalidate(const DirtyRect &rect)
+{
+    const int16_t x0 = max<int16_t>(rect.x0, 0);
+    const int16_t y0 = max<int16_t>(rect.y0, 0);
+    const int16_t x1 = min<int16_t>(rect.x1, FrameBuffer::WIDTH - 1);
+    const int16_t y1 = min<int16_t>(rect.y1, FrameBuffer::HEIGHT - 1);
+    if (x0 > x1 || y0 > y1)
+        return;
+    _damage.add(x0, y0, x1, y1);
+}
+
+void SceneGraph::invalidateAll()
+{
+    _damage.clear();
+    _damage.add(0, 0, FrameBuffer::WIDTH - 1, FrameBuffer::HEIGHT - 1);
+}
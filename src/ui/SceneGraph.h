@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+#include "display/FrameBuffer.h"
+
+// 保留模式场景：节点按加入顺序即 z 序（先加入的在下层），每个节点记录屏幕包围盒。
+// 节点内容变化时只把旧、新包围盒记为脏区；repaint() 对每块脏区设置画布裁剪，
+// 按 z 序重画与之相交的全部节点，因此被遮挡的下层节点与上层覆盖都能正确恢复。
+class SceneGraph
+{
+public:
+    static constexpr uint8_t MAX_NODES = 16;
+    static constexpr uint8_t NONE = 0xFF;
+
+    enum class Kind : uint8_t
+    {
+        Background,
+        Module,
+        Icon,
+        Text,
+        Chart,
+    };
+
+    struct Node
+    {
+        Kind kind;
+        uint8_t slot; // 同类节点中的序号，由绘制方解释
+        DirtyRect bounds; // x0 > x1 表示当前不可见
+    };
+
+    // 清空节点并把整屏记为脏区
+    void clear();
+    // 追加节点（位于已有节点之上），返回节点编号；满员时返回 NONE
+    uint8_t add(Kind kind, uint8_t slot, const DirtyRect &bounds);
+    // 更新节点包围盒，旧、新区域都记为脏区（内容变化而范围不变时同样调用）
+    void setBounds(uint8_t id, const DirtyRect &bounds);
+    void invalidate(const DirtyRect &rect);
+    void invalidateAll();
+
+    uint8_t count() const { return _count; }
+    const Node &operator[](uint8_t i) const { return _nodes[i]; }
+    const DirtyRectList &damage() const { return _damage; }
+
+    // 按脏区局部重绘：paint(node) 在画布已裁剪到脏区时被调用。返回重画的像素数并清空脏区
+    template <typename Paint>
+    uint32_t repaint(FrameBuffer &canvas, Paint &&paint)
+    {
+        uint32_t pixels = 0;
+        for (uint8_t r = 0; r < _damage.count(); r++)
+        {
+            const DirtyRect &rect = _damage[r];
+            canvas.setClip(rect.x0, rect.y0, rect.x1, rect.y1);
+            for (uint8_t i = 0; i < _count; i++)
+            {
+                if (intersects(_nodes[i].bounds, rect))
+                    paint(_nodes[i]);
+            }
+            pixels += rect.area();
+        }
+        canvas.clearClip();
+        _damage.clear();
+        _lastRepaintPixels = pixels;
+        return pixels;
+    }
+
+    uint32_t lastRepaintPixels() const { return _lastRepaintPixels; }
+
+    static bool intersects(const DirtyRect &a, const DirtyRect &b)
+    {
+        return a.x0 <= a.x1 && a.y0 <= a.y1 && a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+    }
+
+private:
+    Node _nodes[MAX_NODES];
+    uint8_t _count = 0;
+    DirtyRectList _damage;
+    uint32_t _lastRepaintPixels = 0;
+};
@@ -0,0 +1,257 @@
+#include "Sparkline.h"
+#include <cmath>
+#include "display/Font5x7.h"
+
+namespace
+{
+// 文字与图表、图表与面板右边缘的间距
+constexpr int16_t CHART_GAP = 8;
+// 天气图标（或图集缺失时的占位框）占据的面板右上角，与 DashboardRenderer 一致
+constexpr int16_t ICON_LEFT_FROM_RIGHT = 64;
+constexpr int16_t ICON_TOP = 6;
+constexpr int16_t ICON_BOTTOM = 30;
+
+struct ColumnSpans
+{
+    uint8_t top[Sparkline::MAX_COLUMNS];
+    uint8_t bottom[Sparkline::MAX_COLUMNS];
+    uint8_t height;
+
+    void mark(int16_t column, float r0, float r1)
+    {
+        const int16_t last = height - 1;
+        int16_t a = constrain(static_cast<int16_t>(lroundf(min(r0, r1))), 0, last);
+        int16_t b = constrain(static_cast<int16_t>(lroundf(max(r0, r1))), 0, last);
+        top[column] = min<uint8_t>(top[column], a);
+        bottom[column] = max<uint8_t>(bottom[column], b);
+    }
+
+    // 折线段 (c0, r0) -> (c1, r1) 在每列内扫过的行范围
+    void segment(int16_t c0, float r0, int16_t c1, float r1)
+    {
+        if (c0 == c1)
+        {
+            mark(c0, r0, r1);
+            return;
+        }
+        const float span = static_cast<float>(c1 - c0);
+        for (int16_t c = c0; c <= c1; c++)
+        {
+            const float t0 = max(0.0f, (c - c0 - 0.5f) / span);
+            const float t1 = min(1.0f, (c - c0 + 0.5f) / span);
+            mark(c, r0 + (r1 - r0) * t0, r0 + (r1 - r0) * t1);
+        }
+    }
+};
+
+// 下标区间 [first, last) 中有效点的平均位置
+bool averageOf(const float *values, uint32_t first, uint32_t last, float &x, float &y)
+{
+    float sumX = 0;
+    float sumY = 0;
+    uint32_t n = 0;
+    for (uint32_t i = first; i < last; i++)
+    {
+        if (std::isnan(values[i]))
+            continue;
+        sumX += i;
+        sumY += values[i];
+        n++;
+    }
+    if (!n)
+        return false;
+    x = sumX / n;
+    y = sumY / n;
+    return true;
+}
+} // namespace
+
+DirtyRect Sparkline::bounds() const
+{
+    if (!width)
+        return {0, 0, -1, -1};
+    return {x, y, static_cast<int16_t>(x + width - 1), static_cast<int16_t>(y + height - 1)};
+}
+
+bool Sparkline::operator==(const Sparkline &other) const
+{
+    return x == other.x && y == other.y && width == other.width && height == other.height &&
+           memcmp(columns, other.columns, width) == 0;
+}
+
+SparklinePlotter::~SparklinePlotter()
+{
+    free(_points);
+}
+
+bool SparklinePlotter::begin()
+{
+    if (_points)
+        return true;
+    const size_t bytes = sizeof(float) * MAX_POINTS;
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound())
+        _points = static_cast<float *>(ps_malloc(bytes));
+#endif
+    if (!_points)
+        _points = static_cast<float *>(malloc(bytes));
+    return _points != nullptr;
+}
+
+void SparklinePlotter::layout(const ThemeConfig &theme, uint8_t row, Sparkline &line)
+{
+    const TextStyle *texts[EnvCharts::COUNT] = {&theme.tempText, &theme.humidText, &theme.pressureText};
+    const ModuleStyle &module = theme.envModule;
+    line.width = 0;
+    if (row >= EnvCharts::COUNT)
+        return;
+    const TextStyle &text = *texts[row];
+    const uint8_t size = text.size ? text.size : 1;
+
+    // 与文字墨迹（不含字形底部的空行）等高、顶端对齐，字号大于 2 时居中
+    const int16_t textHeight = (Font5x7::GLYPH_HEIGHT - 1) * size;
+    const int16_t height = min<int16_t>(textHeight, Sparkline::MAX_HEIGHT);
+    const int16_t y0 = text.y + (textHeight - height) / 2;
+    const int16_t y1 = y0 + height - 1;
+    const int16_t x0 = text.x + static_cast<int16_t>(text.value.length()) * Font5x7::ADVANCE * size + CHART_GAP;
+    int16_t x1 = module.x + module.w - 1 - CHART_GAP;
+    if (y0 <= module.y + ICON_BOTTOM && y1 >= module.y + ICON_TOP)
+        x1 = min<int16_t>(x1, module.x + module.w - ICON_LEFT_FROM_RIGHT - 1 - CHART_GAP);
+    if (text.x < module.x || y0 <= module.y || y1 >= module.y + module.h - 1 || x1 - x0 + 1 < MIN_WIDTH)
+        return;
+
+    line.x = x0;
+    line.y = y0;
+    line.width = static_cast<uint8_t>(min<int16_t>(x1 - x0 + 1, Sparkline::MAX_COLUMNS));
+    line.height = static_cast<uint8_t>(height);
+}
+
+uint16_t SparklinePlotter::lttb(const float *values, uint16_t count, uint16_t buckets, uint16_t *selected)
+{
+    uint16_t n = 0;
+    if (!count || !buckets)
+        return 0;
+    if (count <= buckets)
+    {
+        // 点数不超过列数，不必降采样
+        for (uint16_t i = 0; i < count; i++)
+        {
+            if (!std::isnan(values[i]))
+                selected[n++] = i;
+        }
+        return n;
+    }
+
+    float ax = 0;
+    float ay = 0;
+    bool hasPrevious = false;
+    for (uint16_t b = 0; b < buckets; b++)
+    {
+        const uint32_t first = static_cast<uint32_t>(b) * count / buckets;
+        const uint32_t last = static_cast<uint32_t>(b + 1) * count / buckets;
+
+        // 下一个桶的平均点作为三角形的第三个顶点；下一桶全缺测（或已是最后一桶）时用本桶的平均点
+        float cx = 0;
+        float cy = 0;
+        const uint32_t nextLast = static_cast<uint32_t>(b + 2) * count / buckets;
+        if (b + 1 >= buckets || !averageOf(values, last, nextLast, cx, cy))
+        {
+            if (!averageOf(values, first, last, cx, cy))
+                continue;
+        }
+
+        int32_t best = -1;
+        float bestArea = -1;
+        for (uint32_t i = first; i < last; i++)
+        {
+            if (std::isnan(values[i]))
+                continue;
+            // 第一个选中点之前没有前一顶点：取桶内第一个有效点，与标准 LTTB 固定首点一致
+            if (!hasPrevious)
+            {
+                best = i;
+                break;
+            }
+            const float area = fabsf((ax - cx) * (values[i] - ay) - (ax - i) * (cy - ay));
+            if (area > bestArea)
+            {
+                bestArea = area;
+                best = i;
+            }
+        }
+        if (best < 0)
+            continue;
+        selected[n++] = static_cast<uint16_t>(best);
+        ax = best;
+        ay = values[best];
+        hasPrevious = true;
+    }
+    return n;
+}
+
+void SparklinePlotter::plot(uint16_t count, float minRange, Sparkline &line)
+{
+    for (uint8_t c = 0; c < line.width; c++)
+        line.columns[c] = Sparkline::EMPTY_COLUMN;
+    count = min<uint16_t>(count, MAX_POINTS);
+    if (!line.width || !_points || !count)
+        return;
+
+    float lo = INFINITY;
+    float hi = -INFINITY;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (std::isnan(_points[i]))
+            continue;
+        lo = min(lo, _points[i]);
+        hi = max(hi, _points[i]);
+    }
+    if (lo > hi)
+        return;
+    // 纵轴至少跨 minRange，平稳时的细小波动不会被放大成满幅锯齿
+    if (hi - lo < minRange)
+    {
+        const float middle = (hi + lo) / 2;
+        lo = middle - minRange / 2;
+        hi = middle + minRange / 2;
+    }
+
+    const uint16_t n = lttb(_points, count, line.width, _selected);
+    const float rowScale = (line.height - 1) / (hi - lo);
+    // 相邻选中点之间缺测超过一列的跨度时断开
+    const uint16_t maxGap = max<uint16_t>(1, count / line.width);
+    ColumnSpans spans;
+    spans.height = line.height;
+    memset(spans.top, 0xFF, sizeof(spans.top));
+    memset(spans.bottom, 0, sizeof(spans.bottom));
+
+    int16_t previousColumn = 0;
+    float previousRow = 0;
+    for (uint16_t k = 0; k < n; k++)
+    {
+        const uint16_t i = _selected[k];
+        const int16_t column = count > 1 ? (static_cast<uint32_t>(i) * (line.width - 1) + (count - 1) / 2) / (count - 1)
+                                         : line.width - 1;
+        const float row = (hi - _points[i]) * rowScale;
+
+        bool connected = k > 0;
+        uint16_t run = 0;
+        for (uint16_t j = connected ? _selected[k - 1] + 1 : i; connected && j < i; j++)
+        {
+            run = std::isnan(_points[j]) ? run + 1 : 0;
+            connected = run <= maxGap;
+        }
+        if (connected)
+            spans.segment(previousColumn, previousRow, column, row);
+        else
+            spans.mark(column, row, row);
+        previousColumn = column;
+        previousRow = row;
+    }
+
+    for (uint8_t c = 0; c < line.width; c++)
+    {
+        if (spans.top[c] <= spans.bottom[c])
+            line.columns[c] = static_cast<uint8_t>((spans.top[c] << 4) | spans.bottom[c]);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Arduino.h>
+#include "display/FrameBuffer.h"
+#include "theme/ThemeTypes.h"
+
+// 迷你折线图：每列存一段竖线（相对图表顶部的起止行），渲染时每列一次 1 像素宽的 fillRect。
+// 图高不超过 16 行，起止行压在一个字节里（高 4 位起始、低 4 位结束），三条图随帧快照一起投递也只有几百字节
+struct Sparkline
+{
+    static constexpr uint8_t MAX_COLUMNS = 128;
+    static constexpr uint8_t MAX_HEIGHT = 16;
+    // 起始行大于结束行：该列没有数据
+    static constexpr uint8_t EMPTY_COLUMN = 0xF0;
+
+    int16_t x = 0;
+    int16_t y = 0;
+    uint8_t width = 0; // 0 表示不显示
+    uint8_t height = 0;
+    uint8_t columns[MAX_COLUMNS];
+
+    static uint8_t top(uint8_t column) { return column >> 4; }
+    static uint8_t bottom(uint8_t column) { return column & 0x0F; }
+
+    DirtyRect bounds() const;
+    bool operator==(const Sparkline &other) const;
+    bool operator!=(const Sparkline &other) const { return !(*this == other); }
+};
+
+// 环境面板里温度、湿度、气压三行文字右侧的迷你图，顺序与 SensorHistory 的序列一致
+struct EnvCharts
+{
+    static constexpr uint8_t COUNT = 3;
+    Sparkline lines[COUNT];
+};
+
+// 把历史序列画成迷你图：先用 LTTB（Largest-Triangle-Three-Buckets）把点数降到图宽，
+// 每列保留与前后两列构成最大三角形的那一点，峰谷不会像等间隔抽样那样被跳过；再把折线按列光栅化成竖线段。
+// 缺测超过一列跨度的地方断开。取样缓冲在 begin() 一次分配，只在 loop() 里调用
+class SparklinePlotter
+{
+public:
+    static constexpr uint16_t MAX_POINTS = 1440;
+    // 放不下这么宽时不显示
+    static constexpr uint8_t MIN_WIDTH = 24;
+
+    SparklinePlotter() = default;
+    SparklinePlotter(const SparklinePlotter &) = delete;
+    SparklinePlotter &operator=(const SparklinePlotter &) = delete;
+    ~SparklinePlotter();
+
+    bool begin();
+    // 历史读进这里（至多 MAX_POINTS 个），再调用 plot
+    float *points() { return _points; }
+
+    // 按主题算出 row（0 温度、1 湿度、2 气压）文字右侧的图表位置：文字宽度按内置 5x7 字体估算，
+    // 与面板右上角的天气图标同行时让开；放不下时 width 为 0
+    static void layout(const ThemeConfig &theme, uint8_t row, Sparkline &line);
+    // 把 points() 里 count 个等间隔的点（NAN 为缺测，最后一点在最右列）画进已 layout 的 line，纵轴至少跨 minRange
+    void plot(uint16_t count, float minRange, Sparkline &line);
+
+    // LTTB：把 values 的下标区间按列均分成 buckets 个桶，每桶选出一个有效点，返回选中的下标个数（跳过全缺测的桶）
+    static uint16_t lttb(const float *values, uint16_t count, uint16_t buckets, uint16_t *selected);
+
+private:
+    float *_points = nullptr;
+    uint16_t _selected[Sparkline::MAX_COLUMNS];
+};
@@ -0,0 +1,113 @@
+#include "ThemeTransition.h"
+#include "core/Log.h"
+#include "core/Profiler.h"
+#include "display/Blend565.h"
+
+namespace
+{
+constexpr uint16_t FRAME_COUNT = static_cast<uint32_t>(ThemeTransition::DURATION_MS) * ThemeTransition::TARGET_FPS / 1000;
+} // namespace
+
+const char *ThemeTransition::effectName(Effect effect)
+{
+    switch (effect)
+    {
+    case Effect::Crossfade:
+        return "交叉淡入";
+    case Effect::Slide:
+        return "滑入";
+    case Effect::Wipe:
+        return "擦除";
+    default:
+        return "无";
+    }
+}
+
+void ThemeTransition::play(Effect effect, uint32_t composeMicros)
+{
+    _stats = {};
+    _stats.effect = effect;
+    _stats.composeMicros = composeMicros;
+    if (effect == Effect::None || !available())
+        return;
+
+    PROFILE_ZONE("transition");
+    uint32_t blendTotal = 0;
+    uint32_t spiTotal = 0;
+    int16_t wipedTo = 0;
+    _pacer.start(TARGET_FPS);
+    for (;;)
+    {
+        // 掉帧时直接跳到当前时刻应显示的进度，最后一帧总是新画面本身
+        const uint32_t frame = min<uint32_t>(_pacer.nextFrame(), FRAME_COUNT - 1);
+        const uint32_t progress = (frame + 1) * 255 / FRAME_COUNT;
+
+        uint32_t blendMicros = 0;
+        const uint32_t start = micros();
+        _stats.spiBytes += presentFrame(effect, progress, wipedTo, blendMicros);
+        blendTotal += blendMicros;
+        spiTotal += micros() - start - blendMicros;
+        _pacer.endFrame();
+        if (frame == FRAME_COUNT - 1)
+            break;
+    }
+    _canvas.commitBack();
+
+    _stats.pacing = _pacer.stats();
+    const uint32_t frames = max<uint32_t>(_stats.pacing.frames, 1);
+    _stats.blendMicros = blendTotal / frames;
+    _stats.spiMicros = spiTotal / frames;
+    Log::printf("[过渡] %s %u 帧, 实际 %u.%u fps (目标 %u), 掉帧 %u, 超预算 %u, 合成 %u us, 每帧 混合 %u us / SPI %u us (%u 字节)\n",
+                effectName(effect), _stats.pacing.frames, _stats.pacing.fpsX10 / 10, _stats.pacing.fpsX10 % 10, TARGET_FPS,
+                _stats.pacing.dropped, _stats.pacing.overBudget, composeMicros, _stats.blendMicros, _stats.spiMicros,
+                _stats.spiBytes / frames);
+}
+
+uint32_t ThemeTransition::presentFrame(Effect effect, uint32_t progress, int16_t &wipedTo, uint32_t &blendMicros)
+{
+    const int16_t width = FrameBuffer::WIDTH;
+    const uint16_t *from = _canvas.frontPixels();
+    const uint16_t *to = _canvas.backPixels();
+
+    if (effect == Effect::Wipe)
+    {
+        // 已擦过的列不再变化，只推送新露出的一段，直接取自后台缓冲
+        const int16_t edge = static_cast<int16_t>(width * progress / 255);
+        if (edge <= wipedTo)
+            return 0;
+        const uint32_t bytes = _canvas.pushDirect(wipedTo, 0, edge - wipedTo, FrameBuffer::HEIGHT, to + wipedTo, width);
+        wipedTo = edge;
+        return bytes;
+    }
+
+    uint32_t bytes = 0;
+    const int16_t shift = static_cast<int16_t>(width * progress / 255);
+    for (int16_t y = 0; y < FrameBuffer::HEIGHT; y += STRIP_ROWS)
+    {
+        const int16_t rows = min<int16_t>(STRIP_ROWS, FrameBuffer::HEIGHT - y);
+        const int32_t offset = static_cast<int32_t>(y) * width;
+        const size_t count = static_cast<size_t>(rows) * width;
+
+        const uint32_t start = micros();
+        if (effect == Effect::Crossfade)
+        {
+            memcpy(_strip, from + offset, count * sizeof(uint16_t));
+            Blend565::blendSpan(_strip, to + offset, static_cast<uint8_t>(progress), count);
+        }
+        else
+        {
+            // 旧画面左移 shift 列，新画面从右侧跟进
+            for (int16_t row = 0; row < rows; row++)
+            {
+                uint16_t *dst = _strip + row * width;
+                const int32_t line = offset + static_cast<int32_t>(row) * width;
+                memcpy(dst, from + line + shift, (width - shift) * sizeof(uint16_t));
+                memcpy(dst + width - shift, to + line, shift * sizeof(uint16_t));
+            }
+        }
+        blendMicros += micros() - start;
+
+        bytes += _canvas.pushDirect(0, y, width, rows, _strip, width);
+    }
+    return bytes;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+#include "core/FramePacer.h"
+#include "display/FrameBuffer.h"
+
+// 主题切换过渡动画。画布的前台缓冲是屏幕上的旧画面，后台缓冲已画好新画面（两者都在 PSRAM），
+// 每一帧按条带从两者合成到内部 RAM 的小缓冲里直接推送到屏幕，内部 RAM 中不会同时存在两整帧。
+// 帧节拍由 FramePacer 控制，结束后屏幕与后台缓冲一致。
+class ThemeTransition
+{
+public:
+    enum class Effect : uint8_t
+    {
+        None,
+        Crossfade, // 交叉淡入
+        Slide,     // 新画面从右侧推入
+        Wipe,      // 从左到右擦除
+    };
+
+    static constexpr uint16_t TARGET_FPS = 30;
+    static constexpr uint16_t DURATION_MS = 400;
+    static constexpr int16_t STRIP_ROWS = 16;
+
+    struct Stats
+    {
+        Effect effect;
+        FramePacer::Stats pacing;
+        // 各阶段每帧平均耗时：合成新画面（只在开始时一次）、条带混合、SPI 推送
+        uint32_t composeMicros;
+        uint32_t blendMicros;
+        uint32_t spiMicros;
+        uint32_t spiBytes;
+    };
+
+    explicit ThemeTransition(FrameBuffer &canvas) : _canvas(canvas) {}
+
+    // 画布须为缓冲模式且前台缓冲有效
+    bool available() const { return _canvas.isBuffered() && _canvas.frontPixels(); }
+    // 播放一次过渡；composeMicros 为调用方画新画面的耗时，只用于统计
+    void play(Effect effect, uint32_t composeMicros);
+
+    const Stats &lastStats() const { return _stats; }
+    static const char *effectName(Effect effect);
+
+private:
+    FrameBuffer &_canvas;
+    FramePacer _pacer;
+    Stats _stats = {};
+    uint16_t _strip[FrameBuffer::WIDTH * STRIP_ROWS];
+
+    uint32_t presentFrame(Effect effect, uint32_t progress, int16_t &wipedTo, uint32_t &blendMicros);
+};
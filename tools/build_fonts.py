@@ -0,0 +1,189 @@
+"""把 TTF/OTF 字体预渲染为 4 位抗锯齿字体包 data/fonts/<name>.fnt。
+
+设备端不做矢量光栅化：构建期按 fonts/fonts.json 列出的字号把所需字符渲染成 0..15 的覆盖率位图，
+连同比例字宽度量写入字体包，运行时只需查表、解码 4 位蒙版并与画布混合。
+
+字符集由每个字体包的 charset 列表拼成，每项可以是：
+  "ascii"   可打印 ASCII（0x20..0x7E）
+  "themes"  data/themes/*.json 中出现过的全部字符
+  文件名     fonts/ 下的文本文件（如 cjk_subset.txt），收录其中除空白外的全部字符
+
+源字体不随仓库分发（许可与体积原因），放到 fonts/ 下即可；找不到源字体的字体包会被跳过，
+主题里引用它的文本退回内置 5x7 字体。
+
+格式（小端，与 src/display/FontPack.h 保持一致）：
+  Header 20 字节: magic 'FNT4', version, glyphCount, pixelSize, ascent, lineHeight, reserved, bitmapBytes, indexCrc
+  索引: glyphCount 个 16 字节记录，按码位升序: codepoint, offset, width, height, left, top, advance, 3 字节保留
+  位图: 每个字形 height 行，每行 (width + 1) / 2 字节，低半字节为左侧像素
+indexCrc 只覆盖索引。
+
+依赖 Pillow；装有 fontTools 时用字体的 cmap 判断字形是否存在。既可作为 PlatformIO extra_script
+在构建前自动运行，也可手动执行：
+  python tools/build_fonts.py [data 目录]
+"""
+
+import glob
+import json
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b"FNT4"
+VERSION = 1
+# 与 GlyphCache::SLOT_BYTES 一致，更大的字形设备端无法缓存
+MAX_GLYPH_BYTES = 24 * 48
+MAX_PIXEL_SIZE = 48
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+FONTS_DIR = os.path.join(TOOLS_DIR, "..", "fonts")
+CONFIG_PATH = os.path.join(FONTS_DIR, "fonts.json")
+
+
+def theme_chars(data_dir):
+    chars = set()
+
+    def walk(node):
+        if isinstance(node, dict):
+            for value in node.values():
+                walk(value)
+        elif isinstance(node, list):
+            for value in node:
+                walk(value)
+        elif isinstance(node, str):
+            chars.update(node)
+
+    for path in glob.glob(os.path.join(data_dir, "themes", "*.json")):
+        with open(path, "r", encoding="utf-8") as fp:
+            walk(json.load(fp))
+    return chars
+
+
+def charset_of(pack, data_dir):
+    chars = set()
+    sources = []
+    for item in pack.get("charset", ["ascii"]):
+        if item == "ascii":
+            chars.update(chr(c) for c in range(0x20, 0x7F))
+        elif item == "themes":
+            chars.update(theme_chars(data_dir))
+            sources.extend(glob.glob(os.path.join(data_dir, "themes", "*.json")))
+        else:
+            path = os.path.join(FONTS_DIR, item)
+            with open(path, "r", encoding="utf-8") as fp:
+                chars.update(fp.read())
+            sources.append(path)
+    chars = {c for c in chars if c == " " or not c.isspace()}
+    return sorted(chars, key=ord), sources
+
+
+def glyph_filter(source, font):
+    try:
+        from fontTools.ttLib import TTFont
+
+        cmap = TTFont(source, fontNumber=0, lazy=True).getBestCmap() or {}
+        return lambda ch: ord(ch) in cmap
+    except ImportError:
+        pass
+
+    # 没有 fontTools 时，与私用区码位渲染出的 .notdef 方框比较
+    notdef = render_glyph(font, 0, "\U0010FFFD")
+    return lambda ch: ch == " " or render_glyph(font, 0, ch) != notdef
+
+
+def render_glyph(font, ascent, ch):
+    from PIL import Image, ImageDraw
+
+    left, top, right, bottom = font.getbbox(ch, anchor="ls")
+    advance = int(round(font.getlength(ch)))
+    width = max(0, right - left)
+    height = max(0, bottom - top)
+    if width == 0 or height == 0:
+        return (0, 0, 0, 0, advance), b""
+
+    img = Image.new("L", (width, height), 0)
+    ImageDraw.Draw(img).text((-left, -top), ch, font=font, fill=255, anchor="ls")
+    pixels = img.tobytes()
+
+    row_bytes = (width + 1) // 2
+    out = bytearray(row_bytes * height)
+    for y in range(height):
+        for x in range(width):
+            level = (pixels[y * width + x] * 15 + 127) // 255
+            out[y * row_bytes + x // 2] |= level << (4 * (x & 1))
+    return (width, height, left, ascent + top, advance), bytes(out)
+
+
+def build_pack(source, size, chars):
+    from PIL import ImageFont
+
+    font = ImageFont.truetype(source, size)
+    ascent, descent = font.getmetrics()
+    present = glyph_filter(source, font)
+
+    records = []
+    bitmaps = bytearray()
+    skipped = 0
+    for ch in chars:
+        if not present(ch):
+            skipped += 1
+            continue
+        (width, height, left, top, advance), bitmap = render_glyph(font, ascent, ch)
+        if len(bitmap) > MAX_GLYPH_BYTES or not (-128 <= left <= 127 and -128 <= top <= 127) or advance > 255:
+            skipped += 1
+            continue
+        records.append(struct.pack("<IIBBbbB3x", ord(ch), len(bitmaps), width, height, left, top, advance))
+        bitmaps += bitmap
+
+    index = b"".join(records)
+    header = struct.pack("<4sHHBBBBII", MAGIC, VERSION, len(records), size, min(ascent, 255), min(ascent + descent, 255), 0,
+                         len(bitmaps), zlib.crc32(index) & 0xFFFFFFFF)
+    return header + index + bytes(bitmaps), len(records), skipped
+
+
+def build_all(data_dir):
+    if not os.path.exists(CONFIG_PATH):
+        return 0
+    with open(CONFIG_PATH, "r", encoding="utf-8") as fp:
+        packs = json.load(fp).get("packs", [])
+
+    out_dir = os.path.join(data_dir, "fonts")
+    built = 0
+    for pack in packs:
+        name = pack["name"]
+        size = int(pack["size"])
+        source = os.path.join(FONTS_DIR, pack["source"])
+        if not 6 <= size <= MAX_PIXEL_SIZE:
+            print("[字体包] ⚠️ %s: 字号 %d 超出范围，已跳过" % (name, size))
+            continue
+        if not os.path.exists(source):
+            print("[字体包] ⚠️ %s: 找不到源字体 %s，已跳过（文本将使用内置 5x7 字体）" % (name, pack["source"]))
+            continue
+
+        chars, inputs = charset_of(pack, data_dir)
+        dst = os.path.join(out_dir, name + ".fnt")
+        newest = max(os.path.getmtime(p) for p in inputs + [source, CONFIG_PATH, __file__])
+        if os.path.exists(dst) and os.path.getmtime(dst) >= newest:
+            continue
+
+        try:
+            import PIL  # noqa: F401
+        except ImportError:
+            print("[字体包] ⚠️ 未安装 Pillow，无法生成字体包（pip install pillow）")
+            return built
+
+        blob, count, skipped = build_pack(source, size, chars)
+        os.makedirs(out_dir, exist_ok=True)
+        with open(dst, "wb") as fp:
+            fp.write(blob)
+        print("[字体包] %s: %d 字形（缺 %d）, %dpx -> %s.fnt (%d 字节)" % (name, count, skipped, size, name, len(blob)))
+        built += 1
+    return built
+
+
+try:
+    Import("env")  # noqa: F821  PlatformIO extra_script 入口
+    build_all(os.path.join(env.subst("$PROJECT_DIR"), "data"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        build_all(sys.argv[1] if len(sys.argv) > 1 else os.path.join(TOOLS_DIR, "..", "data"))
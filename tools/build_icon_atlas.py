@@ -0,0 +1,383 @@
+"""把 data/icons/*.svg（和风天气图标，单色 16x16 viewBox）预光栅化为 4 位 alpha 图集。
+
+设备上渲染 SVG 代价过高，因此在构建期把每个图标按 ICON_SIZE 像素做 4x4 超采样光栅化，
+得到 0..15 的覆盖率，设备端按天气代码 O(1) 查表后与底色混合即可。
+
+格式（小端，与 src/display/IconAtlas.h 保持一致）：
+  Header 20 字节: magic 'ICA4', version, cellSize, iconCount, pageShift, reserved, pageCount, usedPages, crc32
+  页表: pageCount 个 uint16，代码 >> pageShift 所在页 -> 已用页序号（0xFFFF 为空页）
+  槽表: usedPages * (1 << pageShift) 个槽，每槽 2 个 uint16: 线框图标序号、填充（-fill）图标序号（0xFFFF 为无）
+  图标数据: iconCount 个 cellSize * cellSize 的 4 位 alpha，行优先，每字节低半字节为左侧像素
+crc32 覆盖页表之后的全部内容。
+
+只依赖 Python 标准库。既可作为 PlatformIO extra_script 在构建前自动运行，也可手动执行：
+  python tools/build_icon_atlas.py [data 目录]
+"""
+
+import glob
+import math
+import os
+import re
+import struct
+import sys
+import xml.etree.ElementTree as ET
+import zlib
+
+MAGIC = b"ICA4"
+VERSION = 1
+ICON_SIZE = 24
+SUPERSAMPLE = 4
+PAGE_SHIFT = 5
+NONE = 0xFFFF
+ATLAS_NAME = "weather_%d.atlas" % ICON_SIZE
+
+NUMBER_RE = re.compile(r"[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?")
+COMMAND_ARGS = {"M": 2, "L": 2, "H": 1, "V": 1, "C": 6, "S": 4, "Q": 4, "T": 2, "A": 7, "Z": 0}
+
+
+class PathTokenizer:
+    def __init__(self, text):
+        self.text = text
+        self.pos = 0
+
+    def skip(self):
+        while self.pos < len(self.text) and self.text[self.pos] in " \t\r\n,":
+            self.pos += 1
+
+    def command(self):
+        self.skip()
+        if self.pos < len(self.text) and self.text[self.pos].isalpha():
+            self.pos += 1
+            return self.text[self.pos - 1]
+        return None
+
+    def has_number(self):
+        self.skip()
+        return self.pos < len(self.text) and (self.text[self.pos].isdigit() or self.text[self.pos] in "+-.")
+
+    def number(self):
+        self.skip()
+        m = NUMBER_RE.match(self.text, self.pos)
+        if not m:
+            raise ValueError("路径数据无效: %r" % self.text[self.pos:self.pos + 16])
+        self.pos = m.end()
+        return float(m.group(0))
+
+    def flag(self):
+        # 圆弧标志位只有一个字符，可能与后续数字紧挨着（如 "a.5.5 0 0 1.5.5"）
+        self.skip()
+        c = self.text[self.pos]
+        if c not in "01":
+            raise ValueError("圆弧标志无效: %r" % c)
+        self.pos += 1
+        return float(c)
+
+
+def arc_points(x0, y0, rx, ry, angle, large, sweep, x1, y1):
+    """SVG 端点参数圆弧转中心参数后折线化（SVG 规范 F.6.5）。"""
+    if rx == 0 or ry == 0 or (x0 == x1 and y0 == y1):
+        return [(x1, y1)]
+    rx, ry = abs(rx), abs(ry)
+    phi = math.radians(angle)
+    cos_phi, sin_phi = math.cos(phi), math.sin(phi)
+    dx, dy = (x0 - x1) / 2, (y0 - y1) / 2
+    x1p = cos_phi * dx + sin_phi * dy
+    y1p = -sin_phi * dx + cos_phi * dy
+
+    scale = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry)
+    if scale > 1:
+        rx *= math.sqrt(scale)
+        ry *= math.sqrt(scale)
+
+    num = rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p
+    den = rx * rx * y1p * y1p + ry * ry * x1p * x1p
+    coef = math.sqrt(max(0.0, num / den)) if den else 0.0
+    if large == sweep:
+        coef = -coef
+    cxp = coef * rx * y1p / ry
+    cyp = -coef * ry * x1p / rx
+    cx = cos_phi * cxp - sin_phi * cyp + (x0 + x1) / 2
+    cy = sin_phi * cxp + cos_phi * cyp + (y0 + y1) / 2
+
+    def angle_of(ux, uy, vx, vy):
+        return math.atan2(ux * vy - uy * vx, ux * vx + uy * vy)
+
+    theta = angle_of(1, 0, (x1p - cxp) / rx, (y1p - cyp) / ry)
+    delta = angle_of((x1p - cxp) / rx, (y1p - cyp) / ry, (-x1p - cxp) / rx, (-y1p - cyp) / ry)
+    if not sweep and delta > 0:
+        delta -= 2 * math.pi
+    elif sweep and delta < 0:
+        delta += 2 * math.pi
+
+    steps = max(2, int(abs(delta) * max(rx, ry) * 4))
+    points = []
+    for i in range(1, steps + 1):
+        t = theta + delta * i / steps
+        ex, ey = rx * math.cos(t), ry * math.sin(t)
+        points.append((cos_phi * ex - sin_phi * ey + cx, sin_phi * ex + cos_phi * ey + cy))
+    return points
+
+
+def bezier_points(p0, p1, p2, p3, steps=8):
+    points = []
+    for i in range(1, steps + 1):
+        t = i / steps
+        u = 1 - t
+        points.append((u * u * u * p0[0] + 3 * u * u * t * p1[0] + 3 * u * t * t * p2[0] + t * t * t * p3[0],
+                       u * u * u * p0[1] + 3 * u * u * t * p1[1] + 3 * u * t * t * p2[1] + t * t * t * p3[1]))
+    return points
+
+
+def parse_path(d):
+    """把路径数据折线化为若干闭合多边形（用户坐标）。"""
+    tok = PathTokenizer(d)
+    polygons = []
+    current = []
+    x = y = 0.0
+    start = (0.0, 0.0)
+    last_ctrl = None
+    last_cmd = None
+    cmd = None
+
+    while True:
+        c = tok.command()
+        if c is None:
+            if cmd is None or not tok.has_number():
+                break
+            # 省略命令字母时重复上一个命令（M/m 之后视为 L/l）
+            c = {"M": "L", "m": "l"}.get(cmd, cmd)
+        cmd = c
+        upper = c.upper()
+        rel = c.islower()
+        if upper not in COMMAND_ARGS:
+            raise ValueError("不支持的路径命令: %s" % c)
+
+        if upper == "Z":
+            if current:
+                polygons.append(current)
+            current = []
+            x, y = start
+            last_ctrl = None
+            last_cmd = upper
+            continue
+
+        if upper == "M":
+            if len(current) > 1:
+                polygons.append(current)
+            nx, ny = tok.number(), tok.number()
+            x, y = (x + nx, y + ny) if rel else (nx, ny)
+            start = (x, y)
+            current = [(x, y)]
+            last_ctrl = None
+        elif upper == "L":
+            nx, ny = tok.number(), tok.number()
+            x, y = (x + nx, y + ny) if rel else (nx, ny)
+            current.append((x, y))
+        elif upper == "H":
+            nx = tok.number()
+            x = x + nx if rel else nx
+            current.append((x, y))
+        elif upper == "V":
+            ny = tok.number()
+            y = y + ny if rel else ny
+            current.append((x, y))
+        elif upper in "CS":
+            if upper == "C":
+                x1, y1 = tok.number(), tok.number()
+                if rel:
+                    x1, y1 = x + x1, y + y1
+            else:
+                # S 的第一个控制点是上一段第二控制点的镜像
+                x1, y1 = (2 * x - last_ctrl[0], 2 * y - last_ctrl[1]) if last_cmd in "CS" and last_ctrl else (x, y)
+            x2, y2, ex, ey = tok.number(), tok.number(), tok.number(), tok.number()
+            if rel:
+                x2, y2, ex, ey = x + x2, y + y2, x + ex, y + ey
+            current += bezier_points((x, y), (x1, y1), (x2, y2), (ex, ey))
+            last_ctrl = (x2, y2)
+            x, y = ex, ey
+        elif upper in "QT":
+            if upper == "Q":
+                qx, qy = tok.number(), tok.number()
+                if rel:
+                    qx, qy = x + qx, y + qy
+            else:
+                qx, qy = (2 * x - last_ctrl[0], 2 * y - last_ctrl[1]) if last_cmd in "QT" and last_ctrl else (x, y)
+            ex, ey = tok.number(), tok.number()
+            if rel:
+                ex, ey = x + ex, y + ey
+            c1 = (x + 2 / 3 * (qx - x), y + 2 / 3 * (qy - y))
+            c2 = (ex + 2 / 3 * (qx - ex), ey + 2 / 3 * (qy - ey))
+            current += bezier_points((x, y), c1, c2, (ex, ey))
+            last_ctrl = (qx, qy)
+            x, y = ex, ey
+        elif upper == "A":
+            rx, ry, angle = tok.number(), tok.number(), tok.number()
+            large, sweep = tok.flag(), tok.flag()
+            ex, ey = tok.number(), tok.number()
+            if rel:
+                ex, ey = x + ex, y + ey
+            current += arc_points(x, y, rx, ry, angle, large, sweep, ex, ey)
+            x, y = ex, ey
+
+        if upper not in "CSQT":
+            last_ctrl = None
+        last_cmd = upper
+
+    if len(current) > 1:
+        polygons.append(current)
+    return polygons
+
+
+def rect_polygon(el):
+    w = float(el.get("width", 0))
+    h = float(el.get("height", 0))
+    x = float(el.get("x", 0))
+    y = float(el.get("y", 0))
+    r = min(float(el.get("rx", el.get("ry", 0)) or 0), w / 2, h / 2)
+    if r <= 0:
+        return [(x, y), (x + w, y), (x + w, y + h), (x, y + h)]
+    d = "M%f %fH%fA%f %f 0 0 1 %f %fV%fA%f %f 0 0 1 %f %fH%fA%f %f 0 0 1 %f %fV%fA%f %f 0 0 1 %f %fZ" % (
+        x + r, y, x + w - r, r, r, x + w, y + r, y + h - r, r, r, x + w - r, y + h,
+        x + r, r, r, x, y + h - r, y + r, r, r, x + r, y)
+    return parse_path(d)[0]
+
+
+def apply_transform(polygons, transform):
+    if not transform:
+        return polygons
+    m = re.match(r"matrix\(([^)]*)\)", transform.strip())
+    if not m:
+        raise ValueError("不支持的 transform: %s" % transform)
+    a, b, c, d, e, f = (float(v) for v in NUMBER_RE.findall(m.group(1)))
+    return [[(a * px + c * py + e, b * px + d * py + f) for px, py in poly] for poly in polygons]
+
+
+def load_svg(path):
+    root = ET.parse(path).getroot()
+    view = [float(v) for v in root.get("viewBox", "0 0 16 16").split()]
+    shapes = []
+    for el in root.iter():
+        tag = el.tag.split("}")[-1]
+        if tag == "path":
+            polygons = parse_path(el.get("d", ""))
+        elif tag == "rect":
+            polygons = [rect_polygon(el)]
+        else:
+            continue
+        shapes.append(apply_transform(polygons, el.get("transform")))
+    return view, shapes
+
+
+def rasterize(view, shapes, size):
+    """每个形状按非零环绕规则填充后取并集，4x4 超采样得到 0..15 的 alpha。"""
+    samples = size * SUPERSAMPLE
+    sx = samples / view[2]
+    sy = samples / view[3]
+    coverage = [0] * (size * size)
+
+    shape_edges = []
+    for polygons in shapes:
+        edges = []
+        for poly in polygons:
+            pts = [((px - view[0]) * sx, (py - view[1]) * sy) for px, py in poly]
+            for i in range(len(pts)):
+                (x0, y0), (x1, y1) = pts[i], pts[(i + 1) % len(pts)]
+                if y0 != y1:
+                    edges.append((x0, y0, x1, y1))
+        shape_edges.append(edges)
+
+    for row in range(samples):
+        cy = row + 0.5
+        inside = [False] * samples
+        for edges in shape_edges:
+            crossings = []
+            for x0, y0, x1, y1 in edges:
+                if (y0 <= cy < y1) or (y1 <= cy < y0):
+                    crossings.append((x0 + (cy - y0) * (x1 - x0) / (y1 - y0), 1 if y1 > y0 else -1))
+            if not crossings:
+                continue
+            crossings.sort()
+            winding = 0
+            for i, (cx, direction) in enumerate(crossings[:-1]):
+                winding += direction
+                if winding == 0:
+                    continue
+                left = max(0, int(math.ceil(cx - 0.5)))
+                right = min(samples, int(math.ceil(crossings[i + 1][0] - 0.5)))
+                for s in range(left, right):
+                    inside[s] = True
+        base = (row // SUPERSAMPLE) * size
+        for s in range(samples):
+            if inside[s]:
+                coverage[base + s // SUPERSAMPLE] += 1
+
+    full = SUPERSAMPLE * SUPERSAMPLE
+    return [(c * 15 + full // 2) // full for c in coverage]
+
+
+def pack_alpha(alpha, size):
+    out = bytearray()
+    for i in range(0, size * size, 2):
+        out.append(alpha[i] | (alpha[i + 1] << 4))
+    return out
+
+
+def icon_sources(icon_dir):
+    """返回 [(代码, 是否填充, 文件路径)]，忽略非数字命名的文件（如 qweather.svg 标志）。"""
+    icons = []
+    for path in sorted(glob.glob(os.path.join(icon_dir, "*.svg"))):
+        m = re.match(r"^(\d+)(-fill)?\.svg$", os.path.basename(path))
+        if m and int(m.group(1)) < 0x10000:
+            icons.append((int(m.group(1)), m.group(2) is not None, path))
+    return icons
+
+
+def build_atlas(icons, size):
+    cells = []
+    slots = {}
+    for code, filled, path in icons:
+        view, shapes = load_svg(path)
+        slots.setdefault(code, [NONE, NONE])[1 if filled else 0] = len(cells)
+        cells.append(pack_alpha(rasterize(view, shapes, size), size))
+
+    page_count = (max(slots) >> PAGE_SHIFT) + 1
+    used = sorted({code >> PAGE_SHIFT for code in slots})
+    page_table = [NONE] * page_count
+    for n, page in enumerate(used):
+        page_table[page] = n
+
+    slot_table = [NONE] * (len(used) << PAGE_SHIFT) * 2
+    for code, (outline, fill) in slots.items():
+        i = ((page_table[code >> PAGE_SHIFT] << PAGE_SHIFT) | (code & ((1 << PAGE_SHIFT) - 1))) * 2
+        slot_table[i] = outline
+        slot_table[i + 1] = fill
+
+    body = struct.pack("<%dH" % page_count, *page_table) + struct.pack("<%dH" % len(slot_table), *slot_table) + b"".join(cells)
+    header = struct.pack("<4sHHHBBHHI", MAGIC, VERSION, size, len(cells), PAGE_SHIFT, 0, page_count, len(used),
+                         zlib.crc32(body) & 0xFFFFFFFF)
+    return header + body
+
+
+def build_all(data_dir):
+    icon_dir = os.path.join(data_dir, "icons")
+    icons = icon_sources(icon_dir)
+    if not icons:
+        return 0
+    dst = os.path.join(icon_dir, ATLAS_NAME)
+    newest = max(os.path.getmtime(path) for _, _, path in icons)
+    if os.path.exists(dst) and os.path.getmtime(dst) >= max(newest, os.path.getmtime(__file__)):
+        return 0
+
+    blob = build_atlas(icons, ICON_SIZE)
+    with open(dst, "wb") as fp:
+        fp.write(blob)
+    print("[图标图集] %d 个图标 -> %s (%dx%d, 4 位 alpha, %d 字节)" % (len(icons), ATLAS_NAME, ICON_SIZE, ICON_SIZE, len(blob)))
+    return len(icons)
+
+
+try:
+    Import("env")  # noqa: F821  PlatformIO extra_script 入口
+    build_all(os.path.join(env.subst("$PROJECT_DIR"), "data"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        build_all(sys.argv[1] if len(sys.argv) > 1 else os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "data"))
@@ -0,0 +1,189 @@
+"""把 data/themes/*.json 预编译为二进制主题 (*.thm)，运行时免去 JSON 解析。
+
+格式（小端，与 src/theme/ThemeBinary.h 保持一致）：
+  Header  16 字节: magic 'THMB', version, payloadSize, crc32(payload), reserved
+  Payload: 背景/图片掩码与颜色、6 个文本记录、3 个模块记录、3 个图标路径、字符串表
+颜色在编译期换算为 RGB565，字符串以 NUL 结尾存放在字符串表中并用偏移引用。
+每条记录带字段掩码，运行时只覆盖 JSON 中出现过的字段，语义与 JSON 加载路径一致。
+
+既可作为 PlatformIO extra_script 在构建前自动运行，也可手动执行：
+  python tools/compile_themes.py [data 目录]
+"""
+
+import glob
+import json
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b"THMB"
+VERSION = 2
+NO_STRING = 0xFFFF
+
+TEXT_KEYS = ["time", "date", "temp", "humidity", "pressure", "alarm"]
+MODULE_KEYS = ["time", "environment", "alarm"]
+
+# 掩码位，与 ThemeBinary.h 中的常量对应
+FIELD_X, FIELD_Y, FIELD_SIZE, FIELD_W, FIELD_H, FIELD_COLOR, FIELD_VALUE, FIELD_OPACITY = (1 << i for i in range(8))
+BG_PRESENT, BG_COLOR, BG_IMAGE = 1, 2, 4
+IMAGES_PRESENT, IMAGES_WEATHER = 1, 2
+
+DEFAULT_BACKGROUND_COLOR = "#0B1328"
+
+# 设备端定长字段的容量（UTF-8 字节，不含结尾 NUL），与 src/theme/ThemeTypes.h 对应；超出的内容加载时会被截断
+TEXT_VALUE_LIMIT = 31
+FONT_NAME_LIMIT = 15
+PATH_LIMIT = 31
+
+
+def rgb_to_565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def parse_color(text):
+    if not isinstance(text, str) or len(text) != 7 or text[0] != "#":
+        return None
+    try:
+        value = int(text[1:], 16)
+    except ValueError:
+        return None
+    return rgb_to_565((value >> 16) & 0xFF, (value >> 8) & 0xFF, value & 0xFF)
+
+
+def is_int(value):
+    return isinstance(value, int) and not isinstance(value, bool)
+
+
+class StringTable:
+    def __init__(self, name=""):
+        self.data = bytearray()
+        self.offsets = {}
+        self.name = name
+
+    def add(self, text, limit=None):
+        if text is None:
+            return NO_STRING
+        if limit is not None and len(text.encode("utf-8")) > limit:
+            print("[主题编译] ⚠️ %s: \"%s\" 超过 %d 字节，设备端会截断" % (self.name, text, limit))
+        if text not in self.offsets:
+            self.offsets[text] = len(self.data)
+            self.data += text.encode("utf-8") + b"\0"
+        return self.offsets[text]
+
+
+def pack_text(obj, strings):
+    obj = obj if isinstance(obj, dict) else {}
+    mask = 0
+    x = y = size = color = 0
+    value = NO_STRING
+    font = NO_STRING
+    if is_int(obj.get("x")):
+        mask |= FIELD_X
+        x = obj["x"]
+    if is_int(obj.get("y")):
+        mask |= FIELD_Y
+        y = obj["y"]
+    if is_int(obj.get("size")):
+        mask |= FIELD_SIZE
+        size = obj["size"] & 0xFF
+    parsed = parse_color(obj.get("color"))
+    if parsed is not None:
+        mask |= FIELD_COLOR
+        color = parsed
+    if isinstance(obj.get("value"), str):
+        mask |= FIELD_VALUE
+        value = strings.add(obj["value"], TEXT_VALUE_LIMIT)
+    if isinstance(obj.get("font"), str):
+        font = strings.add(obj["font"], FONT_NAME_LIMIT)
+    return struct.pack("<BBhhHHH", mask, size, x, y, color, value, font)
+
+
+def pack_module(obj):
+    obj = obj if isinstance(obj, dict) else {}
+    mask = 0
+    fields = {"x": 0, "y": 0, "w": 0, "h": 0}
+    bits = {"x": FIELD_X, "y": FIELD_Y, "w": FIELD_W, "h": FIELD_H}
+    for key in fields:
+        if is_int(obj.get(key)):
+            mask |= bits[key]
+            fields[key] = obj[key]
+    opacity = 0
+    if is_int(obj.get("opacity")):
+        mask |= FIELD_OPACITY
+        opacity = max(0, min(255, obj["opacity"]))
+    color = 0
+    parsed = parse_color(obj.get("color"))
+    if parsed is not None:
+        mask |= FIELD_COLOR
+        color = parsed
+    return struct.pack("<BBhhhhH", mask, opacity, fields["x"], fields["y"], fields["w"], fields["h"], color)
+
+
+def compile_theme(doc, name=""):
+    strings = StringTable(name)
+
+    background = doc.get("background")
+    bg_mask = 0
+    bg_color = 0
+    bg_image = NO_STRING
+    if isinstance(background, dict):
+        # 与 JSON 路径一致：background 存在时颜色缺省为 #0B1328，图片缺省为空串
+        bg_mask |= BG_PRESENT
+        color_text = background.get("color")
+        parsed = parse_color(color_text if isinstance(color_text, str) else DEFAULT_BACKGROUND_COLOR)
+        if parsed is not None:
+            bg_mask |= BG_COLOR
+            bg_color = parsed
+        image = background.get("image")
+        bg_mask |= BG_IMAGE
+        bg_image = strings.add(image if isinstance(image, str) else "", PATH_LIMIT)
+
+    texts = doc.get("text") if isinstance(doc.get("text"), dict) else {}
+    modules = doc.get("modules") if isinstance(doc.get("modules"), dict) else {}
+    text_records = b"".join(pack_text(texts.get(key), strings) for key in TEXT_KEYS)
+    module_records = b"".join(pack_module(modules.get(key)) for key in MODULE_KEYS)
+
+    images = doc.get("images")
+    images_mask = 0
+    weather = wifi = battery = NO_STRING
+    if isinstance(images, dict):
+        images_mask |= IMAGES_PRESENT
+        if isinstance(images.get("weatherIcon"), str):
+            images_mask |= IMAGES_WEATHER
+            weather = strings.add(images["weatherIcon"], PATH_LIMIT)
+        wifi = strings.add(images["wifiIcon"] if isinstance(images.get("wifiIcon"), str) else "", PATH_LIMIT)
+        battery = strings.add(images["batteryIcon"] if isinstance(images.get("batteryIcon"), str) else "", PATH_LIMIT)
+
+    payload = struct.pack("<BBHH", bg_mask, images_mask, bg_color, bg_image)
+    payload += text_records + module_records
+    payload += struct.pack("<HHHH", weather, wifi, battery, len(strings.data))
+    payload += bytes(strings.data)
+
+    header = struct.pack("<4sHHII", MAGIC, VERSION, len(payload), zlib.crc32(payload) & 0xFFFFFFFF, 0)
+    return header + payload
+
+
+def compile_all(data_dir):
+    compiled = 0
+    for src in sorted(glob.glob(os.path.join(data_dir, "themes", "*.json"))):
+        dst = os.path.splitext(src)[0] + ".thm"
+        # 本脚本更新（格式变化）后也要重新编译
+        if os.path.exists(dst) and os.path.getmtime(dst) >= max(os.path.getmtime(src), os.path.getmtime(__file__)):
+            continue
+        with open(src, "r", encoding="utf-8") as fp:
+            doc = json.load(fp)
+        blob = compile_theme(doc, os.path.basename(src))
+        with open(dst, "wb") as fp:
+            fp.write(blob)
+        compiled += 1
+        print("[主题编译] %s -> %s (%d 字节)" % (os.path.basename(src), os.path.basename(dst), len(blob)))
+    return compiled
+
+
+try:
+    Import("env")  # noqa: F821  PlatformIO extra_script 入口
+    compile_all(os.path.join(env.subst("$PROJECT_DIR"), "data"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        compile_all(sys.argv[1] if len(sys.argv) > 1 else os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "data"))
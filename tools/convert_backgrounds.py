@@ -0,0 +1,124 @@
+"""把主题背景图（data/themes/*.webp 等）转换为设备可流式解码的条带 RLE 图像 (*.rle)。
+
+设备上解 WebP(VP8) 代价过高，因此在构建期完成解码、裁切缩放与 RGB565 量化，
+设备端只需逐条带展开游程，工作内存只有一个条带的压缩数据。
+
+格式（小端，与 src/display/StripImage.h 保持一致）：
+  Header 20 字节: magic 'S565', version, width, height, stripRows, stripCount, reserved, maxStripBytes
+  条带偏移表: (stripCount + 1) 个 uint32，相对数据区起点
+  数据区: 每个条带是 width * stripRows 个像素（末条带可能更少）的游程编码：
+    控制字节 c >= 0x80: 重复 (c & 0x7F) + 1 次随后的 1 个像素
+    控制字节 c <  0x80: 随后 c + 1 个字面像素
+游程不跨条带，每个条带可独立解码。
+
+需要 Pillow（pip install Pillow）；缺失时跳过转换，设备端回退为纯色背景。
+既可作为 PlatformIO extra_script 在构建前自动运行，也可手动执行：
+  python tools/convert_backgrounds.py [data 目录]
+"""
+
+import glob
+import json
+import os
+import struct
+import sys
+
+MAGIC = b"S565"
+VERSION = 1
+SCREEN_WIDTH = 240
+SCREEN_HEIGHT = 320
+STRIP_ROWS = 16
+MAX_TOKEN = 128
+
+
+def to_565(rgb):
+    return [((rgb[i] & 0xF8) << 8) | ((rgb[i + 1] & 0xFC) << 3) | (rgb[i + 2] >> 3) for i in range(0, len(rgb), 3)]
+
+
+def encode_strip(values):
+    out = bytearray()
+    i = 0
+    n = len(values)
+    while i < n:
+        run = 1
+        while i + run < n and run < MAX_TOKEN and values[i + run] == values[i]:
+            run += 1
+        if run >= 2:
+            out += struct.pack("<BH", 0x80 | (run - 1), values[i])
+            i += run
+            continue
+
+        # 字面段延伸到下一个至少 2 连的游程之前
+        start = i
+        i += 1
+        while i < n and i - start < MAX_TOKEN and not (i + 1 < n and values[i + 1] == values[i]):
+            i += 1
+        out.append(i - start - 1)
+        out += struct.pack("<%dH" % (i - start), *values[start:i])
+    return out
+
+
+def encode_image(values, width, height):
+    strips = []
+    for y in range(0, height, STRIP_ROWS):
+        rows = min(STRIP_ROWS, height - y)
+        strips.append(encode_strip(values[y * width:(y + rows) * width]))
+
+    offsets = [0]
+    for strip in strips:
+        offsets.append(offsets[-1] + len(strip))
+    header = struct.pack("<4sHHHHHHI", MAGIC, VERSION, width, height, STRIP_ROWS, len(strips), 0, max(len(s) for s in strips))
+    table = struct.pack("<%dI" % len(offsets), *offsets)
+    return header + table + b"".join(strips)
+
+
+def convert(src, dst, Image, ImageOps):
+    with Image.open(src) as im:
+        # 等比缩放铺满竖屏后居中裁切
+        fitted = ImageOps.fit(im.convert("RGB"), (SCREEN_WIDTH, SCREEN_HEIGHT), Image.LANCZOS)
+        values = to_565(fitted.tobytes())
+    blob = encode_image(values, SCREEN_WIDTH, SCREEN_HEIGHT)
+    with open(dst, "wb") as fp:
+        fp.write(blob)
+    return len(blob)
+
+
+def background_images(data_dir):
+    images = set()
+    for path in sorted(glob.glob(os.path.join(data_dir, "themes", "*.json"))):
+        with open(path, "r", encoding="utf-8") as fp:
+            doc = json.load(fp)
+        background = doc.get("background")
+        image = background.get("image") if isinstance(background, dict) else None
+        if isinstance(image, str) and image.startswith("/"):
+            images.add(image)
+    return sorted(images)
+
+
+def convert_all(data_dir):
+    try:
+        from PIL import Image, ImageOps
+    except ImportError:
+        print("[背景转换] ⚠️ 未安装 Pillow, 跳过背景图转换（pip install Pillow）")
+        return 0
+
+    converted = 0
+    for image in background_images(data_dir):
+        src = os.path.join(data_dir, image.lstrip("/"))
+        dst = os.path.splitext(src)[0] + ".rle"
+        if not os.path.exists(src):
+            print("[背景转换] ⚠️ 找不到背景图: %s" % image)
+            continue
+        if os.path.exists(dst) and os.path.getmtime(dst) >= os.path.getmtime(src):
+            continue
+        size = convert(src, dst, Image, ImageOps)
+        converted += 1
+        print("[背景转换] %s -> %s (%d 字节)" % (os.path.basename(src), os.path.basename(dst), size))
+    return converted
+
+
+try:
+    Import("env")  # noqa: F821  PlatformIO extra_script 入口
+    convert_all(os.path.join(env.subst("$PROJECT_DIR"), "data"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        convert_all(sys.argv[1] if len(sys.argv) > 1 else os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "data"))
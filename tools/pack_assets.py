@@ -0,0 +1,152 @@
+"""把 data/ 中运行时读取的资源打包成一个对齐的归档 fsimage/assets.pak，上传到 SPIFFS 后设备按哈希索引 O(1) 定位，
+不再为每个文件单独打开（SPIFFS 的 open 耗时随文件数近似线性增长）。
+
+格式（小端，与 src/core/AssetStore.h 保持一致）：
+  Header  32 字节: magic 'APAK', version, entryCount, bucketCount, reserved, namesBytes, dataOffset, archiveBytes,
+                   indexCrc, reserved
+  槽表:   bucketCount 个 u16（条目序号，0xFFFF 为空），bucketCount 为不小于 2 倍条目数的 2 的幂，线性探测
+  条目表: entryCount 个 20 字节记录: FNV-1a 哈希, 数据偏移, 存储字节数, 原始字节数, 路径偏移(u16), 标志(u16)
+  路径表: 以 NUL 结尾的路径（以 / 开头）
+  数据:   每个条目按 16 字节对齐；JSON 等文本在压缩后明显变小时以原始 deflate 流存储（标志位 0）
+indexCrc 覆盖槽表、条目表与路径表。
+
+构建时转换过的源格式（SVG 图标、WebP 背景等）运行时不读取，不放进归档。
+
+既可作为 PlatformIO extra_script 在构建前自动运行（须排在其他资源脚本之后），也可手动执行：
+  python tools/pack_assets.py [data 目录] [输出文件]
+"""
+
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b"APAK"
+VERSION = 1
+NO_ENTRY = 0xFFFF
+ALIGNMENT = 16
+FLAG_DEFLATE = 1 << 0
+
+HEADER_FORMAT = "<4sHHHHIIIII"
+ENTRY_FORMAT = "<IIIIHH"
+
+# 构建时已转换为 .atlas / .rle 的源文件
+SOURCE_SUFFIXES = (".svg", ".webp", ".png", ".jpg", ".jpeg")
+# 整体读取的文本，尝试压缩；二进制资源按偏移随机读取，原样存储
+COMPRESSIBLE_SUFFIXES = (".json",)
+# 压缩后至少省下这个比例才压缩，否则解压开销不划算
+MIN_SAVING = 0.25
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_DATA_DIR = os.path.join(TOOLS_DIR, "..", "data")
+DEFAULT_OUTPUT = os.path.join(TOOLS_DIR, "..", "fsimage", "assets.pak")
+
+
+def fnv1a(data):
+    value = 2166136261
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def align(value):
+    return (value + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
+
+def collect(data_dir):
+    files = []
+    for root, dirs, names in os.walk(data_dir):
+        dirs.sort()
+        for name in sorted(names):
+            if name.startswith(".") or name.lower().endswith(SOURCE_SUFFIXES):
+                continue
+            full = os.path.join(root, name)
+            path = "/" + os.path.relpath(full, data_dir).replace(os.sep, "/")
+            files.append((path, full))
+    return files
+
+
+def pack_entry(path, raw):
+    if path.lower().endswith(COMPRESSIBLE_SUFFIXES):
+        compressor = zlib.compressobj(9, zlib.DEFLATED, -15)
+        packed = compressor.compress(raw) + compressor.flush()
+        if len(packed) <= len(raw) * (1 - MIN_SAVING):
+            return packed, FLAG_DEFLATE
+    return raw, 0
+
+
+def build_archive(files):
+    bucket_count = 2
+    while bucket_count < 2 * len(files):
+        bucket_count *= 2
+
+    names = bytearray()
+    entries = []
+    for path, full in files:
+        encoded = path.encode("utf-8")
+        if len(names) > 0xFFFF:
+            raise ValueError("路径表超过 64 KB")
+        with open(full, "rb") as fp:
+            raw = fp.read()
+        stored, flags = pack_entry(path, raw)
+        entries.append({"path": path, "hash": fnv1a(encoded), "name": len(names), "raw": raw, "stored": stored, "flags": flags})
+        names += encoded + b"\0"
+
+    buckets = [NO_ENTRY] * bucket_count
+    for index, entry in enumerate(entries):
+        bucket = entry["hash"] & (bucket_count - 1)
+        while buckets[bucket] != NO_ENTRY:
+            bucket = (bucket + 1) & (bucket_count - 1)
+        buckets[bucket] = index
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    index_size = 2 * bucket_count + struct.calcsize(ENTRY_FORMAT) * len(entries) + len(names)
+    offset = data_offset = align(header_size + index_size)
+    for entry in entries:
+        entry["offset"] = offset
+        offset = align(offset + len(entry["stored"]))
+    archive_size = offset
+
+    index = struct.pack("<%dH" % bucket_count, *buckets)
+    for entry in entries:
+        index += struct.pack(ENTRY_FORMAT, entry["hash"], entry["offset"], len(entry["stored"]), len(entry["raw"]),
+                             entry["name"], entry["flags"])
+    index += bytes(names)
+
+    blob = bytearray(archive_size)
+    blob[:header_size] = struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(entries), bucket_count, 0, len(names), data_offset,
+                                     archive_size, zlib.crc32(index) & 0xFFFFFFFF, 0)
+    blob[header_size:header_size + len(index)] = index
+    for entry in entries:
+        blob[entry["offset"]:entry["offset"] + len(entry["stored"])] = entry["stored"]
+    return bytes(blob), entries
+
+
+def pack_all(data_dir, output):
+    files = collect(data_dir)
+    if not files:
+        print("[资源归档] ⚠️ %s 中没有可打包的文件" % data_dir)
+        return False
+
+    newest = max(os.path.getmtime(full) for _, full in files + [("", __file__)])
+    if os.path.exists(output) and os.path.getmtime(output) >= newest:
+        return False
+
+    blob, entries = build_archive(files)
+    os.makedirs(os.path.dirname(os.path.abspath(output)), exist_ok=True)
+    with open(output, "wb") as fp:
+        fp.write(blob)
+    raw_bytes = sum(len(e["raw"]) for e in entries)
+    compressed = [e for e in entries if e["flags"] & FLAG_DEFLATE]
+    print("[资源归档] %d 个条目 (压缩 %d 个), 原始 %d 字节 -> %s (%d 字节)" %
+          (len(entries), len(compressed), raw_bytes, os.path.relpath(output), len(blob)))
+    return True
+
+
+try:
+    Import("env")  # noqa: F821  PlatformIO extra_script 入口
+    project_dir = env.subst("$PROJECT_DIR")  # noqa: F821
+    pack_all(os.path.join(project_dir, "data"), os.path.join(project_dir, "fsimage", "assets.pak"))
+except NameError:
+    if __name__ == "__main__":
+        pack_all(sys.argv[1] if len(sys.argv) > 1 else DEFAULT_DATA_DIR, sys.argv[2] if len(sys.argv) > 2 else DEFAULT_OUTPUT)